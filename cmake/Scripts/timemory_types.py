@@ -56,7 +56,9 @@ components = [
     "vtune_event",
     "user_tuple_bundle",
     "user_list_bundle",
-    "tau_marker"
+    "tau_marker",
+    "tsc_clock",
+    "perf_event_array_t"
 ]
 
 #
@@ -67,6 +69,7 @@ components = [
 mangled_enums = {
     "system_clock": "sys_clock",
     "papi_array_t": "papi_array",
+    "perf_event_array_t": "perf_event_array",
 }
 
 #
@@ -78,6 +81,7 @@ mangled_strings = {
     "wall_clock": ["real_clock", "virtual_clock"],
     "system_clock": ["sys_clock"],
     "papi_array_t": ["papi_array", "papi"],
+    "perf_event_array_t": ["perf_event_array", "perf_event", "perf"],
     "cpu_roofline_flops": ["cpu_roofline"],
     "gpu_roofline_flops": ["gpu_roofline"],
     "cpu_roofline_sp_flops": ["cpu_roofline_sp", "cpu_roofline_single"],
@@ -100,7 +104,7 @@ recommended_types = {
               "page_rss", "peak_rss", "read_bytes", "written_bytes",
               "num_minor_page_faults", "num_major_page_faults",
               "voluntary_context_switch", "priority_context_switch"],
-    "list": ["caliper", "papi_array_t",
+    "list": ["caliper", "papi_array_t", "perf_event_array_t",
              "cuda_event", "nvtx_marker",
              "cupti_counters", "cupti_activity",
              "cpu_roofline_flops", "gpu_roofline_flops",
@@ -118,6 +122,7 @@ traits = {
                                "monotonic_raw_clock",
                                "thread_cpu_clock",
                                "process_cpu_clock",
+                               "tsc_clock",
                                "cuda_event",
                                "cupti_activity",
                            ]),
@@ -151,6 +156,7 @@ traits = {
                               "monotonic_raw_clock",
                               "thread_cpu_clock",
                               "process_cpu_clock",
+                              "tsc_clock",
                               "cuda_event",
                               "cupti_activity",
                           ]),
@@ -196,4 +202,5 @@ native_components = [
     "read_bytes",
     "written_bytes",
     "virtual_memory",
+    "tsc_clock",
 ]
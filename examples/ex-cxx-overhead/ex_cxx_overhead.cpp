@@ -246,6 +246,38 @@ launch(const int nitr, const int nfib, const int cutoff, int64_t& ex_measure,
     timer_list.at(timer_list.size() - 2).rekey("difference vs. " + prefix);
     timer_list.at(timer_list.size() - 1).rekey("average overhead of " + prefix);
 }
+//======================================================================================//
+//  the number of getrusage calls and /proc reads per start/stop when the components
+//  share the snapshot of the bundle vs. when each component reads its own value
+//
+template <typename... _Types>
+std::pair<double, double>
+count_rusage_syscalls(int64_t nitr)
+{
+    using expand = int[];
+
+    auto _beg = tim::get_rusage_syscalls();
+    for(int64_t i = 0; i < nitr; ++i)
+    {
+        tim::component_tuple<_Types...> _obj("rusage-syscalls", false);
+        _obj.start();
+        _obj.stop();
+    }
+    auto _shared = tim::get_rusage_syscalls() - _beg;
+
+    _beg = tim::get_rusage_syscalls();
+    for(int64_t i = 0; i < nitr; ++i)
+    {
+        std::tuple<_Types...> _obj;
+        (void) expand{ 0, (std::get<_Types>(_obj).start(), 0)... };
+        (void) expand{ 0, (std::get<_Types>(_obj).stop(), 0)... };
+    }
+    auto _individual = tim::get_rusage_syscalls() - _beg;
+
+    return std::pair<double, double>(_shared / static_cast<double>(nitr),
+                                     _individual / static_cast<double>(nitr));
+}
+
 //======================================================================================//
 
 int
@@ -349,6 +381,16 @@ main(int argc, char** argv)
               << " KB, max cache size: " << (max_size / tim::units::kilobyte) << " KB\n"
               << std::endl;
 
+    auto _syscalls =
+        count_rusage_syscalls<peak_rss, page_rss, virtual_memory, num_minor_page_faults,
+                              num_major_page_faults, voluntary_context_switch,
+                              priority_context_switch, num_io_in, num_io_out,
+                              num_signals, num_swap>(1000);
+    std::cout << "[INFO]> rusage syscalls per start/stop of 11 rusage components: "
+              << _syscalls.first << " (shared snapshot) vs. " << _syscalls.second
+              << " (per-component)\n"
+              << std::endl;
+
     if(!tim::settings::enabled())
     {
         printf("timemory was disabled.\n");
@@ -31,6 +31,7 @@
 #include <timemory/timemory.hpp>
 
 #include <array>
+#include <chrono>
 #include <cstdarg>
 #include <cstdint>
 #include <cstdio>
@@ -74,6 +75,7 @@ using put_gotcha_t     = tim::component::gotcha<_N, auto_tuple_t, char>;
 using mpi_gotcha_t     = tim::component::gotcha<_N, auto_tuple_t, double>;
 using exp_gotcha_t     = tim::component::gotcha<_N, exp_timer_t, exp_intercept>;
 using fake_gotcha_t    = tim::component::gotcha<_N, tim::component_tuple<>, float>;
+using bench_gotcha_t   = tim::component::gotcha<1, tim::component_tuple<wall_clock>, int>;
 using gotcha_tuple_t   = tim::auto_tuple<auto_tuple_t, user_tuple_bundle>;
 
 #if !defined(TIMEMORY_USE_MPI)
@@ -133,6 +135,44 @@ init()
     if(tim::get_env("EXP_INTERCEPT", true)) user_tuple_bundle::configure<exp_gotcha_t>();
 }
 
+//======================================================================================//
+//
+//  measures the per-call overhead of a wrapper around a function which does nothing
+//
+void
+benchmark(int64_t nitr)
+{
+    using clock_type    = std::chrono::steady_clock;
+    using duration_type = std::chrono::duration<double, std::nano>;
+
+    bench_gotcha_t::get_initializer() = []() {
+        TIMEMORY_CXX_GOTCHA(bench_gotcha_t, 0, ext::do_nothing);
+    };
+
+    double _sum  = 0.0;
+    auto   _exec = [&]() -> double {
+        auto _beg = clock_type::now();
+        for(int64_t i = 0; i < nitr; ++i)
+            _sum += ext::do_nothing(static_cast<double>(i));
+        return duration_type(clock_type::now() - _beg).count() / nitr;
+    };
+
+    auto _unwrapped = _exec();
+
+    double _wrapped = 0.0;
+    {
+        tim::auto_tuple<bench_gotcha_t> _obj("benchmark");
+        // first call inserts the node into the call-graph
+        ext::do_nothing(0.0);
+        _wrapped = _exec();
+    }
+
+    printf("\n[benchmark]> %lli calls (sum = %g)\n", (long long) nitr, _sum);
+    printf("[benchmark]>     unwrapped : %10.1f nsec/call\n", _unwrapped);
+    printf("[benchmark]>       wrapped : %10.1f nsec/call\n", _wrapped);
+    printf("[benchmark]>      overhead : %10.1f nsec/call\n\n", _wrapped - _unwrapped);
+}
+
 //======================================================================================//
 
 int
@@ -206,6 +246,9 @@ main(int argc, char** argv)
 
     for(auto i = 0; i < 10; ++i) _exec();
 
+    if(tim::get_env("BENCH_INTERCEPT", true))
+        benchmark(tim::get_env<int64_t>("BENCH_ITERATIONS", 1000000));
+
     // MPI_Barrier needs to be disabled before finalization
     mpi_gotcha_t::disable();
     tim::timemory_finalize();
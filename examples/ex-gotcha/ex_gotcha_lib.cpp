@@ -85,4 +85,12 @@ do_exp_work(int nitr)
 
 //--------------------------------------------------------------------------------------//
 
+double
+do_nothing(double val)
+{
+    return val;
+}
+
+//--------------------------------------------------------------------------------------//
+
 }  // namespace ext
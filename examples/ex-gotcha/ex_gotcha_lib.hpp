@@ -34,4 +34,8 @@ using tuple_t = std::tuple<float, double>;
 tuple_t
 do_exp_work(int);
 
+// intentionally trivial so that wrapping it measures the overhead of the wrapper
+double
+do_nothing(double);
+
 }  // namespace ext
@@ -46,6 +46,7 @@ TIMEMORY_INSTANTIATE_EXTERN_INIT(thread_cpu_clock)
 TIMEMORY_INSTANTIATE_EXTERN_INIT(thread_cpu_util)
 TIMEMORY_INSTANTIATE_EXTERN_INIT(process_cpu_clock)
 TIMEMORY_INSTANTIATE_EXTERN_INIT(process_cpu_util)
+TIMEMORY_INSTANTIATE_EXTERN_INIT(tsc_clock)
 
 namespace component
 {
@@ -62,6 +63,7 @@ template struct base<process_cpu_clock>;
 template struct base<cpu_util, std::pair<int64_t, int64_t>>;
 template struct base<process_cpu_util, std::pair<int64_t, int64_t>>;
 template struct base<thread_cpu_util, std::pair<int64_t, int64_t>>;
+template struct base<tsc_clock>;
 //
 //
 }  // namespace component
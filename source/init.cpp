@@ -60,7 +60,7 @@ env_settings::instance()
 graph_hash_map_ptr_t
 get_hash_ids()
 {
-    static thread_local auto _inst = get_shared_ptr_pair_instance<graph_hash_map_t>();
+    static graph_hash_map_ptr_t _inst = new graph_hash_map_t();
     return _inst;
 }
 
@@ -70,7 +70,7 @@ get_hash_ids()
 graph_hash_alias_ptr_t
 get_hash_aliases()
 {
-    static thread_local auto _inst = get_shared_ptr_pair_instance<graph_hash_alias_t>();
+    static graph_hash_alias_ptr_t _inst = new graph_hash_alias_t();
     return _inst;
 }
 
@@ -24,6 +24,7 @@
 
 #include "timemory/timemory.hpp"
 
+#include <atomic>
 #include <cstdarg>
 #include <deque>
 #include <iostream>
@@ -56,25 +57,97 @@ extern "C"
 
 //======================================================================================//
 
-using toolset_t          = TIMEMORY_LIBRARY_TYPE;
-using record_map_t       = std::unordered_map<uint64_t, toolset_t>;
-using component_enum_t   = std::vector<TIMEMORY_COMPONENT>;
+static_assert(TIMEMORY_COMPONENTS_END <= 64,
+              "The component sets of the records are stored in a 64-bit mask");
+
+using toolset_t        = TIMEMORY_LIBRARY_TYPE;
+using component_enum_t = std::vector<TIMEMORY_COMPONENT>;
+
+//--------------------------------------------------------------------------------------//
+//  a preinitialized toolset in the slab of the thread. When a record ends, the slot is
+//  not destroyed but returned to the free-list of its (name, component set) so that
+//  the next record with the same label and components starts it again without
+//  hashing the label into the graph or initializing the components
+//
+struct record_slot
+{
+    record_slot(const char* _name, uint64_t _key, uint64_t _mask, int n, int* ctypes)
+    : key(_key)
+    , mask(_mask)
+    , name(_name)
+    , obj(_name, true, tim::settings::flat_profile())
+    {
+        tim::initialize(obj, n, ctypes);
+    }
+
+    bool        active = false;
+    uint64_t    key;
+    uint64_t    mask;
+    std::string name;
+    toolset_t   obj;
+};
+
+using record_slab_t      = std::deque<record_slot>;
+using record_free_t      = std::unordered_map<uint64_t, std::vector<uint64_t>>;
+using config_entry_t     = std::pair<std::string, component_enum_t>;
+using config_cache_t     = std::unordered_map<uint64_t, config_entry_t>;
 using components_stack_t = std::deque<component_enum_t>;
 
 static std::string spacer =
     "#-------------------------------------------------------------------------#";
 
 //--------------------------------------------------------------------------------------//
+//  FNV-1a of a C-string, avoids constructing a std::string for every lookup
+//
+static inline uint64_t
+get_record_hash(const char* _str, uint64_t _hash = 14695981039346656037ULL)
+{
+    for(; *_str != '\0'; ++_str)
+        _hash = (_hash ^ static_cast<unsigned char>(*_str)) * 1099511628211ULL;
+    return _hash;
+}
 
-static record_map_t&
-get_record_map()
+//--------------------------------------------------------------------------------------//
+//  the handles are indices into the slab so the slots are never moved or erased
+//  until the library is finalized
+//
+static record_slab_t&
+get_record_slab()
 {
-    static thread_local record_map_t _instance;
+    static thread_local record_slab_t _instance;
     return _instance;
 }
 
 //--------------------------------------------------------------------------------------//
 
+static record_free_t&
+get_record_free_list()
+{
+    static thread_local record_free_t _instance;
+    return _instance;
+}
+
+//--------------------------------------------------------------------------------------//
+//  the components parsed from a string, e.g. timemory_begin_record_types
+//
+static const component_enum_t&
+get_record_components(const char* _component_string)
+{
+    static thread_local config_cache_t _instance;
+    auto _hash = get_record_hash(_component_string);
+    auto itr   = _instance.find(_hash);
+    if(itr == _instance.end() || itr->second.first != _component_string)
+    {
+        auto& _entry  = _instance[_hash];
+        _entry.first  = _component_string;
+        _entry.second = tim::enumerate_components(_entry.first);
+        return _entry.second;
+    }
+    return itr->second.second;
+}
+
+//--------------------------------------------------------------------------------------//
+
 static components_stack_t&
 get_components_stack()
 {
@@ -107,6 +180,39 @@ get_current_components()
     return _stack.back();
 }
 
+//--------------------------------------------------------------------------------------//
+//  bitmask of a set of components
+//
+inline uint64_t
+get_record_mask(int n, const int* ctypes)
+{
+    uint64_t _mask = 0;
+    for(int i = 0; i < n; ++i)
+    {
+        if(ctypes[i] >= 0 && ctypes[i] < TIMEMORY_COMPONENTS_END)
+            _mask |= (static_cast<uint64_t>(1) << ctypes[i]);
+    }
+    return _mask;
+}
+
+//--------------------------------------------------------------------------------------//
+//  read the component enumerations terminated by TIMEMORY_COMPONENTS_END from a
+//  variadic argument list into a fixed-size array
+//
+inline int
+get_record_enums(va_list args, int* ctypes)
+{
+    int n = 0;
+    for(; n < TIMEMORY_COMPONENTS_END; ++n)
+    {
+        auto enum_arg = va_arg(args, int);
+        if(enum_arg >= TIMEMORY_COMPONENTS_END)
+            break;
+        ctypes[n] = enum_arg;
+    }
+    return n;
+}
+
 //--------------------------------------------------------------------------------------//
 //
 //      TiMemory symbols
@@ -120,10 +226,7 @@ extern "C"
     //
     API uint64_t timemory_get_unique_id(void)
     {
-        // the maps are thread-local so no concerns for data-race here since
-        // two threads updating at once and subsequently losing once of the updates
-        // still results in a unique id for that thread
-        static uint64_t uniqID = 0;
+        static std::atomic<uint64_t> uniqID(0);
         return uniqID++;
     }
 
@@ -139,13 +242,31 @@ extern "C"
         }
         // else: provide default behavior
 
-        static thread_local auto& _record_map = get_record_map();
-        *id                                   = timemory_get_unique_id();
-        _record_map.insert({ *id, toolset_t(name, true, tim::settings::flat_profile()) });
-        tim::initialize(_record_map[*id], n, ctypes);
-        _record_map[*id].start();
-        if(_record_map.bucket_count() > _record_map.size())
-            _record_map.rehash(_record_map.size() + 10);
+        static thread_local auto& _record_slab = get_record_slab();
+        static thread_local auto& _record_free = get_record_free_list();
+
+        auto  _mask  = get_record_mask(n, ctypes);
+        auto  _key   = get_record_hash(name) ^ (_mask * 0x9e3779b97f4a7c15ULL);
+        auto& _avail = _record_free[_key];
+
+        // reuse the last slot released with the same label and components
+        if(!_avail.empty())
+        {
+            auto& _slot = _record_slab[_avail.back()];
+            if(_slot.mask == _mask && _slot.name == name)
+            {
+                *id = _avail.back();
+                _avail.pop_back();
+                _slot.active = true;
+                _slot.obj.start();
+                return;
+            }
+        }
+
+        *id = _record_slab.size();
+        _record_slab.emplace_back(name, _key, _mask, n, ctypes);
+        _record_slab.back().active = true;
+        _record_slab.back().obj.start();
     }
 
     //----------------------------------------------------------------------------------//
@@ -157,12 +278,16 @@ extern "C"
         {
             (*timemory_delete_function)(id);
         }
-        else if(get_record_map().find(id) != get_record_map().end())
+        else
         {
-            static thread_local auto& _record_map = get_record_map();
-            // stop recording, destroy objects, and erase key from map
-            _record_map[id].stop();
-            _record_map.erase(id);
+            static thread_local auto& _record_slab = get_record_slab();
+            if(id >= _record_slab.size() || !_record_slab[id].active)
+                return;
+            // stop recording and release the slot for the next record of this label
+            auto& _slot = _record_slab[id];
+            _slot.obj.stop();
+            _slot.active = false;
+            get_record_free_list()[_slot.key].push_back(id);
         }
     }
 
@@ -189,10 +314,10 @@ extern "C"
     //  finalize the library
     API void timemory_finalize_library(void)
     {
-        if(tim::settings::enabled() == false && get_record_map().empty())
+        if(tim::settings::enabled() == false && get_record_slab().empty())
             return;
 
-        auto& _record_map = get_record_map();
+        auto& _record_slab = get_record_slab();
 
         if(tim::settings::verbose() > 0)
         {
@@ -202,17 +327,21 @@ extern "C"
         }
 
         // put keys into a set so that a potential LD_PRELOAD for timemory_delete_record
-        // is called and there is not a concern for the map iterator
+        // is called and there is not a concern for the slab
         std::unordered_set<uint64_t> keys;
-        for(auto& itr : _record_map)
-            keys.insert(itr.first);
+        for(uint64_t i = 0; i < _record_slab.size(); ++i)
+        {
+            if(_record_slab[i].active)
+                keys.insert(i);
+        }
 
         // delete all the records
         for(auto& itr : keys)
             timemory_delete_record(itr);
 
-        // clear the map
-        _record_map.clear();
+        // destroy the toolsets
+        _record_slab.clear();
+        get_record_free_list().clear();
 
         // do the finalization
         tim::timemory_finalize();
@@ -300,7 +429,7 @@ extern "C"
             return;
         }
 
-        auto comp = tim::enumerate_components(std::string(ctypes));
+        auto& comp = get_record_components(ctypes);
         timemory_create_record(name, id, comp.size(), (int*) (comp.data()));
 
 #if defined(DEBUG)
@@ -320,19 +449,13 @@ extern "C"
             return;
         }
 
-        component_enum_t comp;
-        va_list          args;
+        int     comp[TIMEMORY_COMPONENTS_END];
+        va_list args;
         va_start(args, id);
-        for(int i = 0; i < TIMEMORY_COMPONENTS_END; ++i)
-        {
-            auto enum_arg = static_cast<TIMEMORY_COMPONENT>(va_arg(args, int));
-            if(enum_arg >= TIMEMORY_COMPONENTS_END)
-                break;
-            comp.push_back(enum_arg);
-        }
+        int n = get_record_enums(args, comp);
         va_end(args);
 
-        timemory_create_record(name, id, comp.size(), (int*) (comp.data()));
+        timemory_create_record(name, id, n, comp);
 
 #if defined(DEBUG)
         if(tim::settings::verbose() > 2)
@@ -369,7 +492,7 @@ extern "C"
             return std::numeric_limits<uint64_t>::max();
 
         uint64_t id   = 0;
-        auto     comp = tim::enumerate_components(std::string(ctypes));
+        auto&    comp = get_record_components(ctypes);
         timemory_create_record(name, &id, comp.size(), (int*) (comp.data()));
 
 #if defined(DEBUG)
@@ -390,19 +513,13 @@ extern "C"
 
         uint64_t id = 0;
 
-        component_enum_t comp;
-        va_list          args;
+        int     comp[TIMEMORY_COMPONENTS_END];
+        va_list args;
         va_start(args, name);
-        for(int i = 0; i < TIMEMORY_COMPONENTS_END; ++i)
-        {
-            auto enum_arg = static_cast<TIMEMORY_COMPONENT>(va_arg(args, int));
-            if(enum_arg >= TIMEMORY_COMPONENTS_END)
-                break;
-            comp.push_back(enum_arg);
-        }
+        int n = get_record_enums(args, comp);
         va_end(args);
 
-        timemory_create_record(name, &id, comp.size(), (int*) (comp.data()));
+        timemory_create_record(name, &id, n, comp);
 
 #if defined(DEBUG)
         if(tim::settings::verbose() > 2)
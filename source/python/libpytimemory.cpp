@@ -140,6 +140,7 @@ PYBIND11_MODULE(libpytimemory, tim)
         .value("page_rss", PAGE_RSS)
         .value("papi_array", PAPI_ARRAY)
         .value("peak_rss", PEAK_RSS)
+        .value("perf_event_array", PERF_EVENT_ARRAY)
         .value("priority_context_switch", PRIORITY_CONTEXT_SWITCH)
         .value("process_cpu_clock", PROCESS_CPU_CLOCK)
         .value("process_cpu_util", PROCESS_CPU_UTIL)
@@ -150,6 +151,7 @@ PYBIND11_MODULE(libpytimemory, tim)
         .value("thread_cpu_clock", THREAD_CPU_CLOCK)
         .value("thread_cpu_util", THREAD_CPU_UTIL)
         .value("trip_count", TRIP_COUNT)
+        .value("tsc_clock", TSC_CLOCK)
         .value("user_tuple_bundle", USER_TUPLE_BUNDLE)
         .value("user_list_bundle", USER_LIST_BUNDLE)
         .value("user_clock", USER_CLOCK)
@@ -194,6 +196,37 @@ PYBIND11_MODULE(libpytimemory, tim)
         .value("User1", sys_signal_t::User1)
         .value("User2", sys_signal_t::User2);
 
+    //==================================================================================//
+    //
+    //      Profiler submodule
+    //
+    //==================================================================================//
+    py::module prof = tim.def_submodule("profiler", "Profiler submodule");
+    //----------------------------------------------------------------------------------//
+    prof.def("start", &pytim::profiler::start,
+             "Profile every python function called on this thread");
+    //----------------------------------------------------------------------------------//
+    prof.def("stop", &pytim::profiler::stop,
+             "Stop profiling the python functions called on this thread");
+    //----------------------------------------------------------------------------------//
+    prof.def("is_enabled", &pytim::profiler::is_enabled,
+             "Whether the profiler is active on this thread");
+    //----------------------------------------------------------------------------------//
+    prof.def("thread_init", [](py::args) { pytim::profiler::start(); },
+             "Start the profiler on a new thread: threading.setprofile(thread_init)");
+    //----------------------------------------------------------------------------------//
+    prof.def("exclude",
+             [](py::object _obj) {
+                 if(py::hasattr(_obj, "__func__"))
+                     _obj = _obj.attr("__func__");
+                 if(py::hasattr(_obj, "__code__"))
+                     _obj = _obj.attr("__code__");
+                 if(!PyCode_Check(_obj.ptr()))
+                     throw py::type_error("expected a function or code object");
+                 pytim::profiler::exclude(reinterpret_cast<PyCodeObject*>(_obj.ptr()));
+             },
+             "Do not measure the calls to a function (or code object)");
+
     //==================================================================================//
     //
     //      CUPTI submodule
@@ -434,6 +467,8 @@ PYBIND11_MODULE(libpytimemory, tim)
     SETTING_PROPERTY(bool, papi_multiplexing);
     SETTING_PROPERTY(bool, papi_fail_on_error);
     SETTING_PROPERTY(string_t, papi_events);
+    SETTING_PROPERTY(string_t, perf_events);
+    SETTING_PROPERTY(bool, perf_event_rdpmc);
     SETTING_PROPERTY(uint64_t, cuda_event_batch_size);
     SETTING_PROPERTY(bool, nvtx_marker_device_sync);
     SETTING_PROPERTY(int32_t, cupti_activity_level);
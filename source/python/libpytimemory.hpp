@@ -38,6 +38,7 @@
 #include <atomic>
 #include <chrono>
 #include <cstdint>
+#include <deque>
 #include <functional>
 #include <future>
 #include <iostream>
@@ -47,6 +48,7 @@
 #include <sstream>
 #include <string>
 #include <thread>
+#include <unordered_map>
 #include <vector>
 
 #include "pybind11/cast.h"
@@ -72,6 +74,8 @@
 #include "timemory/variadic/component_list.hpp"
 #include "timemory/variadic/component_tuple.hpp"
 
+#include <frameobject.h>
+
 //======================================================================================//
 
 namespace py = pybind11;
@@ -637,6 +641,203 @@ struct dict<std::tuple<_Types...>>
     }
 };
 
+//======================================================================================//
+//  Profiling mode built on PyEval_SetProfile. The functions are keyed on the code
+//  object so the label and hash are only generated the first time a code object is
+//  encountered. Every call afterwards only constructs and starts the components on
+//  the per-thread stack. All the callbacks are serialized by the GIL.
+//
+namespace profiler
+{
+using profiler_t          = tim_timer_t;
+using captured_location_t = tim::source_location::captured;
+using code_map_t          = std::unordered_map<PyCodeObject*, captured_location_t>;
+
+//--------------------------------------------------------------------------------------//
+
+struct profiler_frame
+{
+    profiler_frame(PyFrameObject* _frame, const captured_location_t& _loc)
+    : frame(_frame)
+    , obj(_loc, true, tim::settings::flat_profile())
+    {}
+
+    PyFrameObject* frame;
+    profiler_t     obj;
+};
+
+//  the frames hold running timers so they must never be relocated: a deque does not
+//  move the existing elements when it grows
+using profiler_stack_t = std::deque<profiler_frame>;
+
+//--------------------------------------------------------------------------------------//
+
+inline code_map_t&
+get_code_map()
+{
+    static code_map_t _instance{};
+    return _instance;
+}
+
+//--------------------------------------------------------------------------------------//
+
+inline profiler_stack_t&
+get_stack()
+{
+    static thread_local profiler_stack_t _instance{};
+    return _instance;
+}
+
+//--------------------------------------------------------------------------------------//
+
+inline int64_t&
+get_depth()
+{
+    static thread_local int64_t _instance = 0;
+    return _instance;
+}
+
+//--------------------------------------------------------------------------------------//
+
+inline PyCodeObject*
+get_code(PyFrameObject* _frame)
+{
+#if PY_VERSION_HEX >= 0x030900B1
+    // the frame holds a reference to the code object
+    PyCodeObject* _code = PyFrame_GetCode(_frame);
+    Py_XDECREF(_code);
+    return _code;
+#else
+    return _frame->f_code;
+#endif
+}
+
+//--------------------------------------------------------------------------------------//
+//  generate the "<function>/<file>:<line>" label once per code object
+//
+inline const captured_location_t&
+get_location(PyCodeObject* _code)
+{
+    auto& _map = get_code_map();
+    auto  itr  = _map.find(_code);
+    if(itr != _map.end())
+        return itr->second;
+
+    // the reference keeps the address from being reused by another code object
+    Py_INCREF(_code);
+
+    auto _utf8 = [](PyObject* _obj) {
+        const char* _str = (_obj) ? PyUnicode_AsUTF8(_obj) : nullptr;
+        if(!_str)
+            PyErr_Clear();
+        return std::string((_str) ? _str : "");
+    };
+
+    auto _func  = _utf8(_code->co_name);
+    auto _file  = _utf8(_code->co_filename);
+    auto _fslsh = _file.find_last_of("/\\");
+    if(_fslsh != std::string::npos)
+        _file = _file.substr(_fslsh + 1);
+
+    std::stringstream _ss;
+    _ss << _func << "/" << _file << ":" << _code->co_firstlineno;
+    auto _key  = _ss.str();
+    auto _hash = tim::add_hash_id(_key);
+
+    auto _entry = tim::get_hash_ids()->find(_hash);
+    auto _loc   = (_entry) ? captured_location_t(_hash, _entry->value)
+                          : captured_location_t{};
+    return _map.insert({ _code, _loc }).first->second;
+}
+
+//--------------------------------------------------------------------------------------//
+//  the code object is not measured, e.g. the functions of the profile decorator and
+//  context-manager which start and stop the profiler. An empty location is the mark
+//
+inline void
+exclude(PyCodeObject* _code)
+{
+    auto& _map = get_code_map();
+    auto  itr  = _map.find(_code);
+    if(itr != _map.end())
+    {
+        itr->second = captured_location_t{};
+        return;
+    }
+    Py_INCREF(_code);
+    _map.insert({ _code, captured_location_t{} });
+}
+
+//--------------------------------------------------------------------------------------//
+
+inline int
+profile_func(PyObject*, PyFrameObject* _frame, int _what, PyObject*)
+{
+    auto& _stack = get_stack();
+    switch(_what)
+    {
+        case PyTrace_CALL:
+        {
+            const auto& _loc = get_location(get_code(_frame));
+            if(_loc.get_hash() == 0)
+                break;
+            _stack.emplace_back(_frame, _loc);
+            _stack.back().obj.start();
+            break;
+        }
+        case PyTrace_RETURN:
+        {
+            // returns from frames entered before the profiler was started are ignored
+            if(!_stack.empty() && _stack.back().frame == _frame)
+            {
+                _stack.back().obj.stop();
+                _stack.pop_back();
+            }
+            break;
+        }
+        default: break;
+    }
+    return 0;
+}
+
+//--------------------------------------------------------------------------------------//
+//  install the profiler on the calling thread. Nested calls are counted
+//
+inline void
+start()
+{
+    if(get_depth()++ > 0)
+        return;
+    PyEval_SetProfile(&profile_func, nullptr);
+}
+
+//--------------------------------------------------------------------------------------//
+//  remove the profiler from the calling thread when the outermost start is stopped
+//
+inline void
+stop()
+{
+    if(get_depth() == 0 || --get_depth() > 0)
+        return;
+    PyEval_SetProfile(nullptr, nullptr);
+    auto& _stack = get_stack();
+    while(!_stack.empty())
+    {
+        _stack.back().obj.stop();
+        _stack.pop_back();
+    }
+}
+
+//--------------------------------------------------------------------------------------//
+
+inline bool
+is_enabled()
+{
+    return get_depth() > 0;
+}
+
+}  // namespace profiler
+
 //======================================================================================//
 
 struct settings
@@ -73,6 +73,7 @@ TIMEMORY_ENV_STATIC_ACCESSOR(bool, file_output, "TIMEMORY_FILE_OUTPUT", true)
 TIMEMORY_ENV_STATIC_ACCESSOR(bool, text_output, "TIMEMORY_TEXT_OUTPUT", true)
 TIMEMORY_ENV_STATIC_ACCESSOR(bool, json_output, "TIMEMORY_JSON_OUTPUT", false)
 TIMEMORY_ENV_STATIC_ACCESSOR(bool, dart_output, "TIMEMORY_DART_OUTPUT", false)
+TIMEMORY_ENV_STATIC_ACCESSOR(bool, binary_output, "TIMEMORY_BINARY_OUTPUT", false)
 TIMEMORY_ENV_STATIC_ACCESSOR(bool, time_output, "TIMEMORY_TIME_OUTPUT", false)
 
 // general settings
@@ -81,6 +82,8 @@ TIMEMORY_ENV_STATIC_ACCESSOR(bool, debug, "TIMEMORY_DEBUG", false)
 TIMEMORY_ENV_STATIC_ACCESSOR(bool, banner, "TIMEMORY_BANNER", true)
 TIMEMORY_ENV_STATIC_ACCESSOR(bool, flat_profile, "TIMEMORY_FLAT_PROFILE", false)
 TIMEMORY_ENV_STATIC_ACCESSOR(bool, collapse_threads, "TIMEMORY_COLLAPSE_THREADS", true)
+TIMEMORY_ENV_STATIC_ACCESSOR(bool, tree_merge, "TIMEMORY_TREE_MERGE", false)
+TIMEMORY_ENV_STATIC_ACCESSOR(int, merge_threads, "TIMEMORY_MERGE_THREADS", 0)
 TIMEMORY_ENV_STATIC_ACCESSOR(uint16_t, max_depth, "TIMEMORY_MAX_DEPTH",
                              std::numeric_limits<uint16_t>::max())
 TIMEMORY_ENV_STATIC_ACCESSOR(string_t, time_format, "TIMEMORY_TIME_FORMAT", "%F_%I.%M_%p")
@@ -149,6 +152,9 @@ TIMEMORY_ENV_STATIC_ACCESSOR(bool, mpi_output_per_rank, "TIMEMORY_MPI_OUTPUT_PER
 TIMEMORY_ENV_STATIC_ACCESSOR(bool, mpi_output_per_node, "TIMEMORY_MPI_OUTPUT_PER_NODE",
                              false)
 
+/// reduce MPI data to the min/max/mean across ranks instead of gathering every rank
+TIMEMORY_ENV_STATIC_ACCESSOR(bool, mpi_reduce, "TIMEMORY_MPI_REDUCE", false)
+
 //----------------------------------------------------------------------------------//
 //      UPC++
 //----------------------------------------------------------------------------------//
@@ -176,6 +182,16 @@ TIMEMORY_ENV_STATIC_ACCESSOR(bool, papi_quiet, "TIMEMORY_PAPI_QUIET", false)
 /// PAPI hardware counters
 TIMEMORY_ENV_STATIC_ACCESSOR(string_t, papi_events, "TIMEMORY_PAPI_EVENTS", "")
 
+//--------------------------------------------------------------------------------------//
+//      perf_event
+//--------------------------------------------------------------------------------------//
+
+/// counters opened with perf_event_open, e.g. "cycles,instructions"
+TIMEMORY_ENV_STATIC_ACCESSOR(string_t, perf_events, "TIMEMORY_PERF_EVENTS", "")
+
+/// read the hardware counters in user-space (rdpmc) when the kernel allows it
+TIMEMORY_ENV_STATIC_ACCESSOR(bool, perf_event_rdpmc, "TIMEMORY_PERF_EVENT_RDPMC", true)
+
 //--------------------------------------------------------------------------------------//
 //      CUDA / CUPTI
 //--------------------------------------------------------------------------------------//
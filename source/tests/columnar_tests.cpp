@@ -0,0 +1,378 @@
+// MIT License
+//
+// Copyright (c) 2020, The Regents of the University of California,
+// through Lawrence Berkeley National Laboratory (subject to receipt of any
+// required approvals from the U.S. Dept. of Energy).  All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "gtest/gtest.h"
+
+#include <timemory/timemory.hpp>
+#include <timemory/utility/columnar.hpp>
+
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+//--------------------------------------------------------------------------------------//
+
+namespace details
+{
+//  Get the current tests name
+//
+inline std::string
+get_test_name()
+{
+    return ::testing::UnitTest::GetInstance()->current_test_info()->name();
+}
+
+inline std::string
+get_file_name()
+{
+    return std::string("columnar_tests_") + get_test_name() + ".tmb";
+}
+
+}  // namespace details
+
+//--------------------------------------------------------------------------------------//
+
+class columnar_tests : public ::testing::Test
+{};
+
+//--------------------------------------------------------------------------------------//
+
+TEST_F(columnar_tests, flatten)
+{
+    std::vector<double> _values;
+    tim::columnar::flatten<int64_t>::apply(3, _values);
+    tim::columnar::flatten<std::array<double, 2>>::apply({ { 1.5, 2.5 } }, _values);
+    tim::columnar::flatten<std::pair<int, std::vector<float>>>::apply(
+        { 4, { 5.0f, 6.0f } }, _values);
+    tim::columnar::flatten<std::string>::apply("ignored", _values);
+
+    std::vector<double> _expected = { 3.0, 1.5, 2.5, 4.0, 5.0, 6.0 };
+    ASSERT_EQ(_values, _expected);
+}
+
+//--------------------------------------------------------------------------------------//
+
+TEST_F(columnar_tests, round_trip)
+{
+    namespace columnar = tim::columnar;
+
+    auto _fname = details::get_file_name();
+    {
+        columnar::writer _writer("test", "a test", "sec", 2);
+        _writer.add_column("first", "sec", columnar::repr, 0);
+        _writer.add_column("second", "", columnar::value, 1);
+
+        //  0 : main
+        //  1 :   |_a
+        //  2 :     |_b
+        //  3 :   |_c
+        //  4 : other (rank 1)
+        auto _main = _writer.add_node(10, -1, 0, 1, 0, 0, "main", { 1.0, 2.0 });
+        auto _a    = _writer.add_node(11, _main, 1, 2, 0, 0, "a", { 3.0, 4.0 });
+        _writer.add_node(12, _a, 2, 3, 0, columnar::transient, "b", { 5.0 });
+        _writer.add_node(13, _main, 1, 4, 0, 0, "c", { 7.0, 8.0, 9.0 });
+        _writer.add_node(10, -1, 0, 5, 1, 0, "main", { 9.0, 10.0 });
+
+        std::ofstream ofs(_fname.c_str(), std::ios::out | std::ios::binary);
+        _writer.write(ofs);
+    }
+
+    columnar::reader _reader(_fname);
+    ASSERT_EQ(_reader.size(), 5);
+    ASSERT_EQ(_reader.ncolumns(), 2);
+    ASSERT_EQ(_reader.concurrency(), 2);
+    ASSERT_EQ(_reader.label(), "test");
+    ASSERT_EQ(_reader.description(), "a test");
+    ASSERT_EQ(_reader.unit(), "sec");
+
+    // the strings are not duplicated
+    ASSERT_EQ(_reader.nstrings(), 10);
+
+    std::vector<std::string> _prefix = { "main", "a", "b", "c", "main" };
+    std::vector<int64_t>     _parent = { -1, 0, 1, 0, -1 };
+    std::vector<int64_t>     _depth  = { 0, 1, 2, 1, 0 };
+    for(uint64_t i = 0; i < _reader.size(); ++i)
+    {
+        EXPECT_EQ(_reader.prefix(i), _prefix[i]) << " index " << i;
+        EXPECT_EQ(_reader.parent(i), _parent[i]) << " index " << i;
+        EXPECT_EQ(_reader.depth(i), _depth[i]) << " index " << i;
+        EXPECT_EQ(_reader.laps(i), i + 1) << " index " << i;
+        EXPECT_EQ(_reader.hash(i), (i == 4) ? 10 : 10 + i) << " index " << i;
+        EXPECT_EQ(_reader.rank(i), (i == 4) ? 1 : 0) << " index " << i;
+        EXPECT_EQ(_reader.is_transient(i), i == 2) << " index " << i;
+    }
+
+    ASSERT_EQ(_reader.children(0), std::vector<int64_t>({ 1, 3 }));
+    ASSERT_EQ(_reader.children(1), std::vector<int64_t>({ 2 }));
+    ASSERT_TRUE(_reader.children(2).empty());
+    ASSERT_EQ(_reader.next_sibling(1), 3);
+    ASSERT_EQ(_reader.next_sibling(3), -1);
+
+    ASSERT_EQ(_reader.column_name(0), "first");
+    ASSERT_EQ(_reader.column_unit(0), "sec");
+    ASSERT_EQ(_reader.column_kind(0), columnar::repr);
+    ASSERT_EQ(_reader.column_name(1), "second");
+    ASSERT_EQ(_reader.column_kind(1), columnar::value);
+    ASSERT_EQ(_reader.get_column(1).index, 1);
+
+    // missing values are NaN and extra values are ignored
+    std::vector<double> _first  = { 1.0, 3.0, 5.0, 7.0, 9.0 };
+    std::vector<double> _second = { 2.0, 4.0, NAN, 8.0, 10.0 };
+    for(uint64_t i = 0; i < _reader.size(); ++i)
+    {
+        EXPECT_EQ(_reader.value(0, i), _first[i]) << " index " << i;
+        if(std::isnan(_second[i]))
+            EXPECT_TRUE(std::isnan(_reader.column_data(1)[i])) << " index " << i;
+        else
+            EXPECT_EQ(_reader.column_data(1)[i], _second[i]) << " index " << i;
+    }
+
+    std::remove(_fname.c_str());
+}
+
+//--------------------------------------------------------------------------------------//
+
+TEST_F(columnar_tests, invalid)
+{
+    auto _fname = details::get_file_name();
+    {
+        std::ofstream ofs(_fname.c_str());
+        ofs << "{ \"timemory\" : {} }" << std::endl;
+    }
+
+    EXPECT_THROW(tim::columnar::reader{ _fname }, std::runtime_error);
+    EXPECT_THROW(tim::columnar::reader{ _fname + ".missing" }, std::runtime_error);
+
+    std::remove(_fname.c_str());
+}
+
+//--------------------------------------------------------------------------------------//
+
+TEST_F(columnar_tests, corrupt)
+{
+    namespace columnar = tim::columnar;
+
+    auto _fname = details::get_file_name();
+    {
+        columnar::writer _writer("test", "a test", "sec");
+        _writer.add_column("first", "sec", columnar::repr, 0);
+        _writer.add_node(10, -1, 0, 1, 0, 0, "main", { 1.0 });
+        std::ofstream ofs(_fname.c_str(), std::ios::out | std::ios::binary);
+        _writer.write(ofs);
+    }
+
+    std::string _buffer;
+    {
+        std::ifstream ifs(_fname.c_str(), std::ios::in | std::ios::binary);
+        _buffer.assign(std::istreambuf_iterator<char>(ifs),
+                       std::istreambuf_iterator<char>());
+    }
+    ASSERT_GT(_buffer.size(), sizeof(columnar::header));
+
+    columnar::header _header;
+    std::memcpy(&_header, _buffer.data(), sizeof(columnar::header));
+
+    auto _write = [&](const columnar::header& _hdr, const std::string& _data) {
+        std::string _tmp = _data;
+        std::memcpy(&_tmp[0], &_hdr, sizeof(columnar::header));
+        std::ofstream ofs(_fname.c_str(), std::ios::out | std::ios::binary);
+        ofs.write(_tmp.data(), _tmp.size());
+    };
+
+    auto _set_offset = [&](uint64_t _idx, uint64_t _value) {
+        std::string _tmp = _buffer;
+        std::memcpy(&_tmp[_header.string_offset + _idx * sizeof(uint64_t)], &_value,
+                    sizeof(uint64_t));
+        _write(_header, _tmp);
+    };
+
+    // unmodified
+    _write(_header, _buffer);
+    EXPECT_NO_THROW(columnar::reader{ _fname });
+
+    // truncated
+    _write(_header, _buffer.substr(0, _buffer.size() - 16));
+    EXPECT_THROW(columnar::reader{ _fname }, std::runtime_error);
+
+    // the number of nodes or columns overflows the size of the file
+    auto _hdr   = _header;
+    _hdr.nnodes = std::numeric_limits<uint64_t>::max() / 2;
+    _write(_hdr, _buffer);
+    EXPECT_THROW(columnar::reader{ _fname }, std::runtime_error);
+
+    _hdr          = _header;
+    _hdr.ncolumns = std::numeric_limits<uint64_t>::max() / 4;
+    _write(_hdr, _buffer);
+    EXPECT_THROW(columnar::reader{ _fname }, std::runtime_error);
+
+    // the string table is outside of the file or misaligned
+    _hdr               = _header;
+    _hdr.string_offset = _buffer.size() + 8;
+    _write(_hdr, _buffer);
+    EXPECT_THROW(columnar::reader{ _fname }, std::runtime_error);
+
+    _hdr               = _header;
+    _hdr.string_offset = _header.string_offset + 1;
+    _write(_hdr, _buffer);
+    EXPECT_THROW(columnar::reader{ _fname }, std::runtime_error);
+
+    _hdr          = _header;
+    _hdr.nstrings = std::numeric_limits<uint64_t>::max();
+    _write(_hdr, _buffer);
+    EXPECT_THROW(columnar::reader{ _fname }, std::runtime_error);
+
+    // a string ends beyond the file or before it begins
+    _set_offset(1, _buffer.size());
+    EXPECT_THROW(columnar::reader{ _fname }, std::runtime_error);
+
+    _set_offset(2, 0);
+    EXPECT_THROW(columnar::reader{ _fname }, std::runtime_error);
+
+    // the node arrays of the single node are at "node_offset" in the order: hash,
+    // parent, first_child, next_sibling, depth, laps, prefix, rank, flags
+    auto _set_node = [&](uint64_t _array, int64_t _value) {
+        std::string _tmp = _buffer;
+        std::memcpy(&_tmp[_header.node_offset + _array * sizeof(int64_t)], &_value,
+                    sizeof(int64_t));
+        _write(_header, _tmp);
+    };
+
+    // a link outside of the node table
+    _set_node(1, 1);
+    EXPECT_THROW(columnar::reader{ _fname }, std::runtime_error);
+
+    _set_node(2, 1000);
+    EXPECT_THROW(columnar::reader{ _fname }, std::runtime_error);
+
+    // a node which is its own sibling or child would be a cycle
+    _set_node(3, 0);
+    EXPECT_THROW(columnar::reader{ _fname }, std::runtime_error);
+
+    _set_node(2, 0);
+    EXPECT_THROW(columnar::reader{ _fname }, std::runtime_error);
+
+    // a prefix outside of the string table
+    _set_node(6, 1000);
+    EXPECT_THROW(columnar::reader{ _fname }, std::runtime_error);
+
+    std::remove(_fname.c_str());
+}
+
+//--------------------------------------------------------------------------------------//
+
+TEST_F(columnar_tests, storage)
+{
+    using namespace tim::component;
+    using tuple_t = tim::component_tuple<wall_clock, peak_rss>;
+
+    {
+        tuple_t _main(details::get_test_name(), true);
+        _main.start();
+        for(int i = 0; i < 3; ++i)
+        {
+            tuple_t _outer("outer", true);
+            _outer.start();
+            tuple_t _inner("inner", true);
+            _inner.start();
+            _inner.stop();
+            _outer.stop();
+        }
+        _main.stop();
+    }
+
+    auto _auto   = tim::settings::auto_output();
+    auto _cout   = tim::settings::cout_output();
+    auto _file   = tim::settings::file_output();
+    auto _text   = tim::settings::text_output();
+    auto _json   = tim::settings::json_output();
+    auto _binary = tim::settings::binary_output();
+
+    tim::settings::auto_output()   = true;
+    tim::settings::cout_output()   = false;
+    tim::settings::file_output()   = true;
+    tim::settings::text_output()   = false;
+    tim::settings::json_output()   = false;
+    tim::settings::binary_output() = true;
+
+    auto _results = tim::storage<wall_clock>::instance()->get();
+    tim::storage<wall_clock>::instance()->print();
+
+    tim::settings::auto_output()   = _auto;
+    tim::settings::cout_output()   = _cout;
+    tim::settings::file_output()   = _file;
+    tim::settings::text_output()   = _text;
+    tim::settings::json_output()   = _json;
+    tim::settings::binary_output() = _binary;
+
+    auto _fname =
+        tim::settings::compose_output_filename(wall_clock::label(), ".tmb");
+    tim::columnar::reader _reader(_fname);
+
+    ASSERT_EQ(_reader.label(), wall_clock::label());
+    ASSERT_EQ(_reader.unit(), wall_clock::display_unit());
+    ASSERT_EQ(_reader.size(), _results.size());
+    // repr, value, and accum
+    ASSERT_EQ(_reader.ncolumns(), 3);
+    ASSERT_EQ(_reader.column_kind(0), tim::columnar::repr);
+    ASSERT_EQ(_reader.column_kind(1), tim::columnar::value);
+    ASSERT_EQ(_reader.column_kind(2), tim::columnar::accum);
+
+    for(uint64_t i = 0; i < _reader.size(); ++i)
+    {
+        const auto& _obj = _results.at(i).data();
+        EXPECT_EQ(_reader.hash(i), _results.at(i).hash()) << " index " << i;
+        EXPECT_EQ(_reader.depth(i), _results.at(i).depth()) << " index " << i;
+        EXPECT_EQ(_reader.prefix(i), _results.at(i).hierarchy().back()) << " index " << i;
+        EXPECT_EQ(_reader.laps(i), _obj.nlaps()) << " index " << i;
+        EXPECT_DOUBLE_EQ(_reader.value(0, i), _obj.get()) << " index " << i;
+        EXPECT_DOUBLE_EQ(_reader.value(2, i), _obj.get_accum()) << " index " << i;
+        if(_reader.parent(i) >= 0)
+            EXPECT_EQ(_reader.depth(_reader.parent(i)) + 1, _reader.depth(i));
+    }
+
+    ASSERT_EQ(_reader.prefix(0), details::get_test_name());
+    ASSERT_EQ(_reader.children(0).size(), 1);
+    ASSERT_EQ(_reader.prefix(_reader.children(0).front()), "outer");
+    ASSERT_EQ(_reader.laps(_reader.children(0).front()), 3);
+}
+
+//--------------------------------------------------------------------------------------//
+
+int
+main(int argc, char** argv)
+{
+    ::testing::InitGoogleTest(&argc, argv);
+    tim::settings::verbose() = 0;
+    tim::settings::debug()   = false;
+    tim::settings::banner()  = false;
+    return RUN_ALL_TESTS();
+}
@@ -365,6 +365,61 @@ TEST_F(gotcha_tests, work_macro)
 
 //======================================================================================//
 
+TEST_F(gotcha_tests, thread_throughput)
+{
+    using pair_type      = std::pair<float, double>;
+    using count_gotcha_t = tim::component::gotcha<1, component_tuple<trip_count>, long>;
+    using count_tuple_t  = tim::auto_tuple<count_gotcha_t>;
+
+    count_gotcha_t::get_initializer() = []() {
+        TIMEMORY_CXX_GOTCHA(count_gotcha_t, 0, ext::do_work);
+    };
+
+    auto _get_laps = []() {
+        int64_t _laps = 0;
+        for(auto& itr : tim::storage<trip_count>::instance()->get())
+        {
+            if(itr.prefix().find("do_work") != std::string::npos)
+                _laps += itr.data().nlaps();
+        }
+        return _laps;
+    };
+
+    auto    nthreads = std::max<int64_t>(4, std::thread::hardware_concurrency());
+    int64_t ncalls   = nitr / 10;
+    int64_t nlaps    = _get_laps();
+
+    std::chrono::duration<double> _elapsed;
+    {
+        count_tuple_t _tool(details::get_test_name());
+
+        auto _run = [=]() {
+            float fsum = 0.0;
+            for(int64_t i = 0; i < ncalls; ++i)
+                fsum += std::get<0>(ext::do_work(10, pair_type(0.25, 0.125)));
+            tim::consume_parameters(fsum);
+        };
+
+        std::vector<std::thread> threads;
+        auto _beg = std::chrono::steady_clock::now();
+        for(int64_t i = 0; i < nthreads; ++i)
+            threads.emplace_back(_run);
+        for(auto& itr : threads)
+            itr.join();
+        _elapsed = std::chrono::steady_clock::now() - _beg;
+    }
+
+    printf("\n[%s]> %li threads x %li calls : %12.3e calls/sec\n\n",
+           details::get_test_name().c_str(), (long) nthreads, (long) ncalls,
+           (nthreads * ncalls) / _elapsed.count());
+
+    // every call on every thread must have been measured: a thread inside the wrapper
+    // does not disable the wrapper on the other threads
+    EXPECT_EQ(_get_laps() - nlaps, nthreads * ncalls);
+}
+
+//======================================================================================//
+
 template <typename func_t>
 void
 print_func_info(const std::string& fname)
@@ -454,6 +509,116 @@ TEST_F(gotcha_tests, malloc_gotcha)
 
 //======================================================================================//
 
+TEST_F(gotcha_tests, malloc_throughput)
+{
+    using malloc_gotcha_spec_t = malloc_gotcha::gotcha_spec<component_tuple<>>;
+    using malloc_gotcha_t      = typename malloc_gotcha_spec_t::gotcha_type;
+    using toolset_t            = tim::auto_tuple<malloc_gotcha_t>;
+
+    malloc_gotcha_t::get_initializer() = []() {
+        TIMEMORY_C_GOTCHA(malloc_gotcha_t, 0, malloc);
+        TIMEMORY_C_GOTCHA(malloc_gotcha_t, 1, calloc);
+        TIMEMORY_C_GOTCHA(malloc_gotcha_t, 2, free);
+    };
+
+    static constexpr int64_t nbatch = 1000;
+    int64_t                  nrep   = nitr / 100;
+    std::vector<void*>       ptrs(nbatch, nullptr);
+
+    auto _run = [&]() {
+        auto _beg = std::chrono::steady_clock::now();
+        for(int64_t j = 0; j < nrep; ++j)
+        {
+            for(int64_t i = 0; i < nbatch; ++i)
+                ptrs[i] = malloc(16 + (i % 64) * 8);
+            for(int64_t i = 0; i < nbatch; ++i)
+                free(ptrs[i]);
+        }
+        std::chrono::duration<double, std::nano> _elapsed =
+            std::chrono::steady_clock::now() - _beg;
+        return _elapsed.count() / (nrep * nbatch);
+    };
+
+    auto _unwrapped = _run();
+    auto _nalloc    = malloc_gotcha::get_allocation_count();
+
+    double _wrapped = 0.0;
+    {
+        toolset_t tool(details::get_test_name());
+        _wrapped = _run();
+    }
+
+    printf("\n[%s]> malloc/free pair : unwrapped = %8.1f nsec, wrapped = %8.1f nsec, "
+           "overhead = %8.1f nsec\n\n",
+           details::get_test_name().c_str(), _unwrapped, _wrapped,
+           _wrapped - _unwrapped);
+
+    // every tracked allocation was matched with its free
+    EXPECT_EQ(malloc_gotcha::get_allocation_count(), _nalloc);
+}
+
+//======================================================================================//
+
+TEST_F(gotcha_tests, malloc_attribution)
+{
+    using malloc_gotcha_spec_t = malloc_gotcha::gotcha_spec<component_tuple<>>;
+    using malloc_gotcha_t      = typename malloc_gotcha_spec_t::gotcha_type;
+    using toolset_t            = tim::auto_tuple<malloc_gotcha_t>;
+    using region_t             = tim::auto_tuple<malloc_gotcha>;
+
+    malloc_gotcha_t::get_initializer() = []() {
+        TIMEMORY_C_GOTCHA(malloc_gotcha_t, 0, malloc);
+        TIMEMORY_C_GOTCHA(malloc_gotcha_t, 1, calloc);
+        TIMEMORY_C_GOTCHA(malloc_gotcha_t, 2, free);
+    };
+
+    static constexpr int64_t nalloc = 100;
+    static constexpr int64_t nbytes = 1024;
+    std::vector<void*>       ptrs(nalloc, nullptr);
+    std::string              region_name = details::get_test_name() + "_region";
+
+    malloc_gotcha::attribution() = true;
+    {
+        toolset_t tool(details::get_test_name());
+        {
+            region_t region(region_name);
+            for(int64_t i = 0; i < nalloc; ++i)
+                ptrs[i] = malloc(nbytes);
+        }
+
+        // free half of the allocations outside of the region and on another thread
+        std::thread _thread([&]() {
+            for(int64_t i = 0; i < nalloc / 2; ++i)
+                free(ptrs[i]);
+        });
+        _thread.join();
+    }
+    malloc_gotcha::attribution() = false;
+
+    std::stringstream ss;
+    malloc_gotcha::report_allocation_sites(ss);
+    std::cout << ss.str() << std::endl;
+
+    bool found = false;
+    for(auto& itr : malloc_gotcha::get_allocation_sites())
+    {
+        if(itr.path.find(region_name) == std::string::npos)
+            continue;
+        found = true;
+        EXPECT_GE(itr.total_count, nalloc);
+        EXPECT_GE(itr.live_count, nalloc / 2);
+        EXPECT_GE(itr.live_bytes, (nalloc / 2) * nbytes);
+        EXPECT_GE(itr.peak_bytes, nalloc * nbytes);
+        EXPECT_LT(itr.live_count, itr.total_count);
+    }
+    EXPECT_TRUE(found) << ss.str();
+
+    for(int64_t i = nalloc / 2; i < nalloc; ++i)
+        free(ptrs[i]);
+}
+
+//======================================================================================//
+
 TEST_F(gotcha_tests, member_functions)
 {
     using pair_type     = std::pair<float, double>;
@@ -0,0 +1,608 @@
+// MIT License
+//
+// Copyright (c) 2020, The Regents of the University of California,
+// through Lawrence Berkeley National Laboratory (subject to receipt of any
+// required approvals from the U.S. Dept. of Energy).  All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "gtest/gtest.h"
+
+#include <timemory/timemory.hpp>
+#include <timemory/utility/graph.hpp>
+#include <timemory/utility/graph_data.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <iomanip>
+#include <iostream>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+using graph_t      = tim::graph<int64_t>;
+using graph_data_t = tim::graph_data<int64_t>;
+using arena_t      = tim::graph_arena<tim::tgraph_node<int64_t>>;
+
+// hash, value, prefix, depth, rolling hash
+using result_node_t  = std::tuple<uint64_t, int64_t, std::string, int64_t, uint64_t>;
+using result_array_t = std::vector<result_node_t>;
+
+//--------------------------------------------------------------------------------------//
+
+namespace details
+{
+//  Get the current tests name
+//
+inline std::string
+get_test_name()
+{
+    return ::testing::UnitTest::GetInstance()->current_test_info()->name();
+}
+
+// builds a tree of "nlevel" levels where each node has "nchild" children
+template <typename _Graph, typename _Iter>
+void
+build(_Graph& _graph, _Iter _parent, int64_t nlevel, int64_t nchild)
+{
+    if(nlevel == 0)
+        return;
+    for(int64_t i = 0; i < nchild; ++i)
+    {
+        auto itr = _graph.append_child(_parent, nlevel * 100 + i);
+        build(_graph, itr, nlevel - 1, nchild);
+    }
+}
+
+// emulates "nthread" copies of a call-graph with "nunique" nodes. Every 8th node
+// shares the hash, depth, and rolling hash of the previous node but has a
+// different prefix
+inline result_array_t
+generate_results(int64_t nunique, int64_t nthread)
+{
+    result_array_t _list;
+    _list.reserve(nunique * nthread);
+    for(int64_t t = 0; t < nthread; ++t)
+    {
+        for(int64_t i = 0; i < nunique; ++i)
+        {
+            int64_t  _n       = (i % 8 == 7) ? (i - 1) : i;
+            uint64_t _hash    = 1000 + (_n % 251);
+            int64_t  _depth   = _n % 16;
+            uint64_t _rolling = _hash + static_cast<uint64_t>(_n / 251);
+            auto     _prefix  = std::string("node_") + std::to_string(i);
+            _list.push_back(result_node_t{ _hash, 1, _prefix, _depth, _rolling });
+        }
+    }
+    return _list;
+}
+
+// the previous quadratic implementation
+inline result_array_t
+reference_collapse(const result_array_t& _list)
+{
+    result_array_t _combined;
+    for(const auto& itr : _list)
+    {
+        auto citr = _combined.begin();
+        for(; citr != _combined.end(); ++citr)
+        {
+            if(std::get<0>(itr) == std::get<0>(*citr) &&
+               std::get<2>(itr) == std::get<2>(*citr) &&
+               std::get<3>(itr) == std::get<3>(*citr) &&
+               std::get<4>(itr) == std::get<4>(*citr))
+                break;
+        }
+        if(citr == _combined.end())
+            _combined.push_back(itr);
+        else
+            std::get<1>(*citr) += std::get<1>(itr);
+    }
+    return _combined;
+}
+
+inline void
+combine(result_node_t& _lhs, const result_node_t& _rhs)
+{
+    std::get<1>(_lhs) += std::get<1>(_rhs);
+}
+
+}  // namespace details
+
+//--------------------------------------------------------------------------------------//
+
+class graph_tests : public ::testing::Test
+{};
+
+//--------------------------------------------------------------------------------------//
+
+TEST_F(graph_tests, slab_allocation)
+{
+    graph_t _graph;
+    auto    _head = _graph.set_head(0);
+    details::build(_graph, _head, 4, 6);
+
+    auto _stats = _graph.allocator_stats();
+    std::cout << "\n" << _stats << "\n" << std::endl;
+
+    // 6 + 36 + 216 + 1296 nodes + head + 2 sentinels
+    size_t _nodes = 1 + 6 + 36 + 216 + 1296;
+    ASSERT_EQ(_graph.size(), _nodes);
+    ASSERT_EQ(_stats.live_nodes, _nodes + 2);
+    ASSERT_EQ(_stats.total_nodes, _nodes + 2);
+    ASSERT_EQ(_stats.slab_allocs,
+              (_nodes + 2) / arena_t::nodes_per_slab() +
+                  (((_nodes + 2) % arena_t::nodes_per_slab() > 0) ? 1 : 0));
+    ASSERT_LT(_stats.slab_allocs, _stats.total_nodes);
+    ASSERT_EQ(_stats.saved_allocs(), _stats.total_nodes - _stats.slab_allocs);
+    ASSERT_GE(_graph.data_size(), _stats.live_bytes());
+}
+
+//--------------------------------------------------------------------------------------//
+
+TEST_F(graph_tests, recycle)
+{
+    graph_t _graph;
+    auto    _head = _graph.set_head(0);
+    details::build(_graph, _head, 3, 4);
+
+    auto _before = _graph.allocator_stats();
+    _graph.erase_children(_head);
+    auto _erased = _graph.allocator_stats();
+
+    // head + 2 sentinels remain
+    ASSERT_EQ(_erased.live_nodes, 3);
+    ASSERT_EQ(_erased.slab_count, _before.slab_count);
+
+    details::build(_graph, _head, 3, 4);
+    auto _after = _graph.allocator_stats();
+
+    // all of the new nodes are served from the free-list
+    ASSERT_EQ(_after.slab_allocs, _before.slab_allocs);
+    ASSERT_EQ(_after.recycled_nodes, _before.live_nodes - 3);
+    ASSERT_EQ(_after.live_nodes, _before.live_nodes);
+}
+
+//--------------------------------------------------------------------------------------//
+
+TEST_F(graph_tests, bulk_release)
+{
+    graph_data_t _data(0);
+    for(int64_t i = 0; i < 5000; ++i)
+    {
+        int64_t _val = i;
+        _data.append_child(_val);
+        if(i % 10 == 9)
+        {
+            for(int j = 0; j < 10; ++j)
+                _data.pop_graph();
+        }
+    }
+
+    auto _before = _data.allocator_stats();
+    std::cout << "\n" << _before << std::endl;
+    ASSERT_GT(_before.slab_count, 1);
+
+    _data.reset();
+    auto _reset = _data.allocator_stats();
+    std::cout << _reset << std::endl;
+    ASSERT_EQ(_reset.slab_count, 1);
+    ASSERT_EQ(_reset.live_nodes, 3);
+    ASSERT_EQ(_reset.releases, _before.releases + 1);
+    ASSERT_EQ(_data.graph().size(), 1);
+    ASSERT_EQ(*_data.head(), 0);
+
+    _data.clear();
+    auto _clear = _data.allocator_stats();
+    std::cout << _clear << "\n" << std::endl;
+    ASSERT_EQ(_clear.slab_count, 1);
+    ASSERT_EQ(_clear.live_nodes, 2);
+    ASSERT_EQ(_clear.releases, _reset.releases + 1);
+    ASSERT_EQ(_data.graph().size(), 0);
+}
+
+//--------------------------------------------------------------------------------------//
+
+TEST_F(graph_tests, move)
+{
+    graph_t _graph;
+    auto    _head = _graph.set_head(0);
+    details::build(_graph, _head, 3, 3);
+    auto _size = _graph.size();
+
+    graph_t _moved(std::move(_graph));
+    ASSERT_EQ(_graph.size(), 0);
+    ASSERT_EQ(_moved.size(), _size);
+
+    // the moved-from graph no longer owns its arena exclusively
+    _graph.clear();
+    ASSERT_FALSE(_graph.release());
+
+    graph_t _copy(_moved);
+    _moved.clear();
+    ASSERT_EQ(_copy.size(), _size);
+    int64_t _sum = 0;
+    for(auto itr = _copy.begin(); itr != _copy.end(); ++itr)
+        _sum += *itr;
+    ASSERT_GT(_sum, 0);
+}
+
+//--------------------------------------------------------------------------------------//
+
+TEST_F(graph_tests, adopted_stats)
+{
+    graph_t _graph;
+    auto    _head = _graph.set_head(0);
+    details::build(_graph, _head, 2, 4);
+
+    graph_t _other;
+    auto    _ohead = _other.set_head(1);
+    details::build(_other, _ohead, 2, 4);
+
+    auto _own   = _graph.allocator_stats();
+    auto _child = _other.allocator_stats();
+    auto _size  = _graph.size();
+
+    // splice the children of the other graph below the head of this graph
+    while(_other.number_of_children(_ohead) > 0)
+        _graph.move_in_below(_head, _other, graph_t::iterator(_other.begin(_ohead)));
+
+    ASSERT_EQ(_graph.size(), 2 * _size - 1);
+    ASSERT_EQ(_graph.allocator_stats().live_nodes, _own.live_nodes);
+    ASSERT_EQ(_other.allocator_stats().live_nodes, _child.live_nodes);
+
+    // the spliced nodes are returned to the arena of the other graph
+    _graph.erase_children(_head);
+    auto _erased = _graph.allocator_stats();
+    ASSERT_EQ(_erased.live_nodes, 3);
+    ASSERT_EQ(_erased.slab_count, _own.slab_count);
+    ASSERT_LE(_erased.live_bytes(), _erased.reserved_bytes);
+    ASSERT_EQ(_other.allocator_stats().live_nodes, 3);
+
+    // the other arena is still held by this graph so the other graph starts a new one
+    _other.clear();
+    ASSERT_FALSE(_other.release());
+    auto _reset = _other.allocator_stats();
+    ASSERT_EQ(_reset.live_nodes, 2);
+    ASSERT_EQ(_reset.slab_count, 1);
+    ASSERT_EQ(_reset.releases, 0);
+
+    _graph.clear();
+    ASSERT_TRUE(_graph.release());
+    auto _released = _graph.allocator_stats();
+    ASSERT_EQ(_released.live_nodes, 2);
+    ASSERT_EQ(_released.releases, 1);
+}
+
+//--------------------------------------------------------------------------------------//
+
+TEST_F(graph_tests, child_cache)
+{
+    graph_data_t _data(0);
+    auto         _head = _data.head();
+
+    int64_t _a = 1;
+    int64_t _b = 2;
+    auto    _aitr = _data.append_child(_a);
+    _data.pop_graph();
+    auto _bitr = _data.append_child(_b);
+    _data.pop_graph();
+
+    ASSERT_FALSE(_data.find_child(_head, 1));
+    _data.cache_child(_head, 1, _aitr);
+    _data.cache_child(_head, 2, _bitr);
+    ASSERT_EQ(_data.find_child(_head, 1), _aitr);
+    ASSERT_EQ(_data.find_child(_head, 2), _bitr);
+
+    // only direct descendants are cached
+    _data.cache_child(_aitr, 2, _bitr);
+    ASSERT_FALSE(_data.find_child(_aitr, 2));
+
+    // the cache does not survive a reset of the graph
+    _data.reset();
+    ASSERT_FALSE(_data.find_child(_data.head(), 1));
+    ASSERT_FALSE(_data.find_child(_data.head(), 2));
+}
+
+//--------------------------------------------------------------------------------------//
+
+TEST_F(graph_tests, hash_registry)
+{
+    using table_t = tim::interned_table<std::string, 64>;
+
+    const int64_t nthread = 4;
+    const int64_t nshared = 2000;
+    const int64_t nunique = 500;
+
+    table_t                  _table;
+    std::vector<std::thread> _threads;
+    std::vector<std::vector<const table_t::entry*>> _entries(nthread);
+
+    auto _key = [](const std::string& _str) { return std::hash<std::string>()(_str); };
+
+    for(int64_t i = 0; i < nthread; ++i)
+    {
+        _threads.push_back(std::thread([&, i]() {
+            for(int64_t j = 0; j < nshared; ++j)
+            {
+                auto _str = std::string("shared_") + std::to_string(j);
+                _entries[i].push_back(_table.insert(_key(_str), _str));
+            }
+            for(int64_t j = 0; j < nunique; ++j)
+            {
+                auto _str = std::to_string(i) + "_unique_" + std::to_string(j);
+                _table.insert(_key(_str), _str);
+            }
+        }));
+    }
+
+    for(auto& itr : _threads)
+        itr.join();
+
+    // every thread must have resolved the same entry for the shared keys
+    for(int64_t i = 1; i < nthread; ++i)
+        for(int64_t j = 0; j < nshared; ++j)
+            ASSERT_EQ(_entries[0][j], _entries[i][j]);
+
+    // entries which lost an insertion race keep their index but are not reachable
+    int64_t _visible = 0;
+    _table.for_each([&](const table_t::entry& itr) {
+        ASSERT_EQ(_table.find(itr.key), &itr);
+        ASSERT_EQ(_table.at(itr.index), &itr);
+        ++_visible;
+    });
+    ASSERT_EQ(_visible, nshared + nthread * nunique);
+    ASSERT_GE(_table.size(), _visible);
+
+    for(int64_t j = 0; j < nshared; ++j)
+    {
+        auto _str = std::string("shared_") + std::to_string(j);
+        auto _itr = _table.find(_key(_str));
+        ASSERT_TRUE(_itr != nullptr);
+        ASSERT_EQ(_itr->value, _str);
+    }
+    ASSERT_TRUE(_table.find(_key("not_inserted")) == nullptr);
+
+    // the global registry resolves aliases to the original string
+    auto _hash = tim::add_hash_id("graph_tests/hash_registry");
+    tim::add_hash_id(_hash, _hash * 3);
+    ASSERT_EQ(tim::get_hash_identifier(_hash * 3), "graph_tests/hash_registry");
+    ASSERT_EQ(tim::get_hash_index(_hash), tim::get_hash_index(_hash * 3));
+}
+
+//--------------------------------------------------------------------------------------//
+
+TEST_F(graph_tests, collapse)
+{
+    const int64_t nunique = 2000;
+    const int64_t nthread = 4;
+
+    auto _list     = details::generate_results(nunique, nthread);
+    auto _expected = details::reference_collapse(_list);
+    auto _combined = tim::impl::collapse_results(_list, details::combine);
+
+    ASSERT_EQ(_combined.size(), nunique);
+    ASSERT_EQ(_combined.size(), _expected.size());
+    for(size_t i = 0; i < _combined.size(); ++i)
+    {
+        ASSERT_EQ(_combined[i], _expected[i]);
+        ASSERT_EQ(std::get<1>(_combined[i]), nthread);
+    }
+}
+
+//--------------------------------------------------------------------------------------//
+//  benchmark, not part of the default run. Use --gtest_also_run_disabled_tests
+//  --gtest_filter=*collapse_scaling to run it
+//
+TEST_F(graph_tests, DISABLED_collapse_scaling)
+{
+    const int64_t nthread = 8;
+
+    std::cout << std::endl;
+    for(int64_t nnodes = 1000; nnodes <= 1000000; nnodes *= 10)
+    {
+        auto _list     = details::generate_results(nnodes / nthread, nthread);
+        auto _start    = std::chrono::steady_clock::now();
+        auto _combined = tim::impl::collapse_results(_list, details::combine);
+        auto _end      = std::chrono::steady_clock::now();
+
+        ASSERT_EQ(_combined.size(), nnodes / nthread);
+
+        std::chrono::duration<double, std::milli> _elapsed = _end - _start;
+        std::cout << "    collapsed " << std::setw(8) << nnodes << " nodes into "
+                  << std::setw(7) << _combined.size() << " in " << std::fixed
+                  << std::setprecision(3) << std::setw(10) << _elapsed.count() << " ms"
+                  << std::endl;
+    }
+    std::cout << std::endl;
+}
+
+//--------------------------------------------------------------------------------------//
+
+TEST_F(graph_tests, reduce_index)
+{
+    const int64_t nunique = 1000;
+
+    // the destination has the first half of the entries and the source has the last
+    // three quarters twice so only the first quarter of the source overlaps
+    auto _all = details::generate_results(nunique, 1);
+    auto _dst = details::reference_collapse(
+        result_array_t(_all.begin(), _all.begin() + nunique / 2));
+    auto _half = result_array_t(_all.begin() + nunique / 4, _all.end());
+    auto _src  = _half;
+    _src.insert(_src.end(), _half.begin(), _half.end());
+
+    auto _expected = details::reference_collapse(_dst);
+    for(const auto& itr : details::reference_collapse(_src))
+        _expected.push_back(itr);
+    _expected = details::reference_collapse(_expected);
+
+    auto _ndst  = _dst.size();
+    auto _index = tim::impl::reduce_index(_dst, _src);
+
+    ASSERT_EQ(_index.size(), _src.size());
+    ASSERT_EQ(_dst.size(), _expected.size());
+    for(size_t i = 0; i < _dst.size(); ++i)
+        ASSERT_TRUE(tim::impl::result_equiv(_dst[i], _expected[i]));
+
+    for(size_t i = 0; i < _src.size(); ++i)
+    {
+        ASSERT_LT(_index[i], _dst.size());
+        ASSERT_TRUE(tim::impl::result_equiv(_dst[_index[i]], _src[i]));
+        if(i >= _src.size() / 2)
+            ASSERT_EQ(_index[i], _index[i - _src.size() / 2]);
+    }
+    ASSERT_GT(_dst.size(), _ndst);
+}
+
+//--------------------------------------------------------------------------------------//
+
+TEST_F(graph_tests, tree_merge)
+{
+    using namespace tim::component;
+    using tuple_t =
+        tim::component_tuple<wall_clock, monotonic_clock, monotonic_raw_clock, cpu_clock>;
+
+    const int64_t nthread = 7;
+
+    std::mutex              _mutex;
+    std::condition_variable _cv;
+    bool                    _finished = false;
+    std::atomic<int64_t>    _ready(0);
+
+    auto _record = [&](int64_t _n) {
+        for(int64_t i = 0; i < 3; ++i)
+        {
+            tuple_t _outer("outer", true);
+            _outer.start();
+            for(int64_t j = 0; j <= _n; ++j)
+            {
+                tuple_t _inner(std::string("inner_") + std::to_string(j), true);
+                _inner.start();
+                _inner.stop();
+            }
+            _outer.stop();
+        }
+        // keep the worker storage alive until the master has merged
+        ++_ready;
+        std::unique_lock<std::mutex> _lk(_mutex);
+        _cv.wait(_lk, [&]() { return _finished; });
+    };
+
+    tuple_t _main(details::get_test_name(), true);
+    _main.start();
+
+    std::vector<std::thread> _threads;
+    for(int64_t i = 0; i < nthread; ++i)
+        _threads.push_back(std::thread(_record, i));
+
+    while(_ready.load() < nthread)
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+
+    _main.stop();
+
+    auto _collapse = tim::settings::collapse_threads();
+    auto _auto     = tim::settings::auto_output();
+    auto _cout     = tim::settings::cout_output();
+    auto _file     = tim::settings::file_output();
+
+    tim::settings::collapse_threads() = false;
+    tim::settings::auto_output()      = true;
+    tim::settings::cout_output()      = false;
+    tim::settings::file_output()      = false;
+
+    tim::settings::tree_merge() = false;
+    tim::storage<wall_clock>::instance()->print();
+    tim::settings::tree_merge() = true;
+    tim::storage<monotonic_clock>::instance()->print();
+
+    auto _serial = tim::storage<wall_clock>::instance()->get();
+    auto _tree   = tim::storage<monotonic_clock>::instance()->get();
+
+    // the matching call-paths are combined during the reduction
+    tim::settings::collapse_threads() = true;
+    tim::settings::tree_merge()       = false;
+    tim::storage<monotonic_raw_clock>::instance()->print();
+    tim::settings::tree_merge() = true;
+    tim::storage<cpu_clock>::instance()->print();
+
+    auto _serial_collapsed = tim::storage<monotonic_raw_clock>::instance()->get();
+    auto _tree_collapsed   = tim::storage<cpu_clock>::instance()->get();
+
+    {
+        std::unique_lock<std::mutex> _lk(_mutex);
+        _finished = true;
+    }
+    _cv.notify_all();
+    for(auto& itr : _threads)
+        itr.join();
+
+    tim::settings::tree_merge()       = false;
+    tim::settings::collapse_threads() = _collapse;
+    tim::settings::auto_output()      = _auto;
+    tim::settings::cout_output()      = _cout;
+    tim::settings::file_output()      = _file;
+
+    // main + nthread * (outer + inner_0 ... inner_n)
+    int64_t _expected = 1;
+    for(int64_t i = 0; i < nthread; ++i)
+        _expected += 2 + i;
+
+    ASSERT_EQ(_serial.size(), _expected);
+    ASSERT_EQ(_tree.size(), _serial.size());
+    for(size_t i = 0; i < _serial.size(); ++i)
+    {
+        EXPECT_EQ(_serial[i].prefix(), _tree[i].prefix()) << " index " << i;
+        EXPECT_EQ(_serial[i].depth(), _tree[i].depth()) << " index " << i;
+        EXPECT_EQ(_serial[i].data().nlaps(), _tree[i].data().nlaps()) << " index " << i;
+    }
+
+    // main + outer + inner_0 ... inner_n
+    ASSERT_EQ(_serial_collapsed.size(), 2 + nthread);
+    ASSERT_EQ(_tree_collapsed.size(), _serial_collapsed.size());
+    for(size_t i = 0; i < _serial_collapsed.size(); ++i)
+    {
+        auto& _lhs = _serial_collapsed[i];
+        auto& _rhs = _tree_collapsed[i];
+        EXPECT_EQ(_lhs.prefix(), _rhs.prefix()) << " index " << i;
+        EXPECT_EQ(_lhs.depth(), _rhs.depth()) << " index " << i;
+        EXPECT_EQ(_lhs.data().nlaps(), _rhs.data().nlaps()) << " index " << i;
+    }
+    // every thread ran inner_0 and only the last thread ran inner_n
+    EXPECT_EQ(_tree_collapsed[1].data().nlaps(), 3 * nthread);
+    EXPECT_EQ(_tree_collapsed[2].data().nlaps(), 3 * nthread);
+    EXPECT_EQ(_tree_collapsed.back().data().nlaps(), 3);
+}
+
+//--------------------------------------------------------------------------------------//
+
+int
+main(int argc, char** argv)
+{
+    ::testing::InitGoogleTest(&argc, argv);
+    tim::settings::verbose() = 0;
+    tim::settings::debug()   = false;
+    tim::settings::banner()  = false;
+    return RUN_ALL_TESTS();
+}
+
+//--------------------------------------------------------------------------------------//
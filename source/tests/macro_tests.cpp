@@ -174,6 +174,35 @@ TEST_F(macro_tests, marker)
 
 //--------------------------------------------------------------------------------------//
 
+TEST_F(macro_tests, hashed_handle)
+{
+    // hash of a literal is evaluated by the compiler and matches the runtime hash
+    constexpr auto literal_hash = tim::get_hash("macro_tests/hashed_handle");
+    ASSERT_EQ(literal_hash, tim::get_hash(std::string("macro_tests/hashed_handle")));
+
+    std::string file = __FILE__;
+    file             = file.substr(file.find_last_of('/') + 1);
+
+    auto line   = __LINE__ + 1;
+    auto _full  = TIMEMORY_HANDLE(component_tuple_t, "hashed");
+    auto _basic = TIMEMORY_BASIC_HANDLE(component_tuple_t, "");
+    auto _blank = TIMEMORY_BLANK_HANDLE(component_tuple_t, "hashed_", "blank");
+
+    std::stringstream expected;
+    expected << __FUNCTION__ << "@" << file << ":" << line << "/hashed";
+
+    EXPECT_EQ(_full.key(), expected.str());
+    EXPECT_EQ(_basic.key(), std::string(__FUNCTION__));
+    EXPECT_EQ(_blank.key(), std::string("hashed_blank"));
+
+    // the same labels constructed at runtime resolve to the same hash
+    EXPECT_EQ(_full.hash(), component_tuple_t(expected.str()).hash());
+    EXPECT_EQ(_basic.hash(), component_tuple_t(__FUNCTION__).hash());
+    EXPECT_EQ(_blank.hash(), component_tuple_t("hashed_blank").hash());
+}
+
+//--------------------------------------------------------------------------------------//
+
 int
 main(int argc, char** argv)
 {
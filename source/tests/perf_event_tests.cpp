@@ -0,0 +1,188 @@
+// MIT License
+//
+// Copyright (c) 2020, The Regents of the University of California,
+// through Lawrence Berkeley National Laboratory (subject to receipt of any
+// required approvals from the U.S. Dept. of Energy).  All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#include "gtest/gtest.h"
+
+#include <timemory/timemory.hpp>
+
+#include <cstring>
+#include <iostream>
+#include <vector>
+
+using namespace tim::component;
+using perf_array_t = perf_event_array<4>;
+
+static const char* event_names = "task-clock,page-faults";
+
+//--------------------------------------------------------------------------------------//
+
+namespace details
+{
+//  Get the current tests name
+//
+inline std::string
+get_test_name()
+{
+    return ::testing::UnitTest::GetInstance()->current_test_info()->name();
+}
+
+// this function consumes an unknown number of cpu resources
+long
+fibonacci(long n)
+{
+    return (n < 2) ? n : (fibonacci(n - 1) + fibonacci(n - 2));
+}
+
+// this function touches every page of a new allocation
+long
+touch_pages(size_t npages)
+{
+    auto              _page = tim::units::get_page_size();
+    std::vector<char> _data(npages * _page, 0);
+    for(size_t i = 0; i < _data.size(); i += _page)
+        _data[i] = static_cast<char>(i);
+    long _sum = 0;
+    for(size_t i = 0; i < _data.size(); i += _page)
+        _sum += _data[i];
+    return _sum;
+}
+
+// the software events are not available when perf_event_paranoid is too restrictive
+bool
+is_supported()
+{
+    tim::perf_event::group _group;
+    auto _info = tim::perf_event::get_event_info("task-clock");
+    bool _ret  = _group.open({ _info }, false, nullptr);
+    if(!_ret)
+        std::cerr << "[" << get_test_name() << "]> perf_event_open is not permitted, "
+                  << "skipping..." << std::endl;
+    return _ret;
+}
+
+}  // namespace details
+
+//--------------------------------------------------------------------------------------//
+
+class perf_event_tests : public ::testing::Test
+{};
+
+//--------------------------------------------------------------------------------------//
+
+TEST_F(perf_event_tests, event_info)
+{
+    auto _cycles = tim::perf_event::get_event_info("cycles");
+    ASSERT_TRUE(_cycles.valid);
+    ASSERT_EQ(_cycles.type, (uint32_t) PERF_TYPE_HARDWARE);
+    ASSERT_EQ(_cycles.config, (uint64_t) PERF_COUNT_HW_CPU_CYCLES);
+
+    auto _raw = tim::perf_event::get_event_info("r00c0");
+    ASSERT_TRUE(_raw.valid);
+    ASSERT_EQ(_raw.type, (uint32_t) PERF_TYPE_RAW);
+    ASSERT_EQ(_raw.config, (uint64_t) 0xc0);
+
+    ASSERT_FALSE(tim::perf_event::get_event_info("not-an-event").valid);
+    ASSERT_FALSE(tim::perf_event::get_event_info("rxyz").valid);
+}
+
+//--------------------------------------------------------------------------------------//
+
+TEST_F(perf_event_tests, group)
+{
+    if(!details::is_supported())
+        return;
+
+    std::vector<tim::perf_event::event_info> _events = {
+        tim::perf_event::get_event_info("task-clock"),
+        tim::perf_event::get_event_info("page-faults"),
+        tim::perf_event::get_event_info("not-an-event")
+    };
+
+    std::vector<std::string> _errors;
+    tim::perf_event::group   _group;
+    ASSERT_TRUE(_group.open(_events, true, &_errors));
+    ASSERT_EQ(_group.size(), _events.size());
+    ASSERT_EQ(_errors.size(), size_t(1));
+    ASSERT_NE(_errors.front().find("not-an-event"), std::string::npos);
+
+    long long _beg[3];
+    long long _end[3];
+    ASSERT_TRUE(_group.read(_beg));
+    auto _ret = details::fibonacci(30) + details::touch_pages(1000);
+    ASSERT_TRUE(_group.read(_end));
+    _group.close();
+
+    std::cout << "\n[" << details::get_test_name() << "]> result: " << _ret
+              << ", task-clock: " << (_end[0] - _beg[0])
+              << ", page-faults: " << (_end[1] - _beg[1]) << "\n"
+              << std::endl;
+
+    ASSERT_GT(_end[0] - _beg[0], 0);
+    ASSERT_GE(_end[1] - _beg[1], 500);
+    ASSERT_EQ(_end[2], 0);
+    ASSERT_FALSE(_group.is_open());
+}
+
+//--------------------------------------------------------------------------------------//
+
+TEST_F(perf_event_tests, component)
+{
+    if(!details::is_supported())
+        return;
+
+    ASSERT_EQ(perf_array_t::size(), size_t(2));
+
+    perf_array_t _obj;
+    _obj.start();
+    auto _ret = details::fibonacci(30) + details::touch_pages(1000);
+    _obj.stop();
+
+    auto _values = _obj.get();
+    auto _labels = _obj.label_array();
+    std::cout << "\n[" << details::get_test_name() << "]> result: " << _ret << ", "
+              << _obj << "\n"
+              << std::endl;
+
+    ASSERT_EQ(_values.size(), size_t(2));
+    ASSERT_EQ(_labels[0], "task-clock");
+    ASSERT_EQ(_labels[1], "page-faults");
+    ASSERT_GT(_values[0], 0.0);
+    ASSERT_GE(_values[1], 500.0);
+}
+
+//--------------------------------------------------------------------------------------//
+
+int
+main(int argc, char** argv)
+{
+    ::testing::InitGoogleTest(&argc, argv);
+    tim::settings::verbose()     = 0;
+    tim::settings::debug()       = false;
+    tim::settings::banner()      = false;
+    tim::settings::perf_events() = event_names;
+    return RUN_ALL_TESTS();
+}
+
+//--------------------------------------------------------------------------------------//
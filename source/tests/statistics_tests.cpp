@@ -0,0 +1,246 @@
+// MIT License
+//
+// Copyright (c) 2020, The Regents of the University of California,
+// through Lawrence Berkeley National Laboratory (subject to receipt of any
+// required approvals from the U.S. Dept. of Energy).  All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "gtest/gtest.h"
+
+#include <timemory/data/statistics.hpp>
+#include <timemory/timemory.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <random>
+#include <sstream>
+#include <vector>
+
+using stats_t = tim::statistics<int64_t>;
+
+//--------------------------------------------------------------------------------------//
+
+namespace details
+{
+//  Get the current tests name
+//
+inline std::string
+get_test_name()
+{
+    return ::testing::UnitTest::GetInstance()->current_test_info()->name();
+}
+
+//  log-normally distributed "durations" which have a long tail
+//
+inline std::vector<int64_t>
+generate(size_t n, uint64_t seed = 7)
+{
+    std::mt19937_64                     rng(seed);
+    std::lognormal_distribution<double> dist(8.0, 1.0);
+    std::vector<int64_t>                _data(n);
+    for(auto& itr : _data)
+        itr = static_cast<int64_t>(dist(rng));
+    return _data;
+}
+
+inline double
+exact_quantile(std::vector<int64_t> _data, double _q)
+{
+    std::sort(_data.begin(), _data.end());
+    return static_cast<double>(_data.at(static_cast<size_t>(_q * (_data.size() - 1))));
+}
+
+}  // namespace details
+
+//--------------------------------------------------------------------------------------//
+
+class statistics_tests : public ::testing::Test
+{};
+
+//--------------------------------------------------------------------------------------//
+
+TEST_F(statistics_tests, variance)
+{
+    auto _data = details::generate(100000);
+
+    stats_t _stats;
+    for(const auto& itr : _data)
+        _stats += itr;
+
+    double _mean = 0.0;
+    for(const auto& itr : _data)
+        _mean += itr;
+    _mean /= _data.size();
+
+    double _var = 0.0;
+    for(const auto& itr : _data)
+        _var += (itr - _mean) * (itr - _mean);
+    _var /= (_data.size() - 1);
+
+    std::cout << "\n[" << details::get_test_name() << "]> mean: " << _stats.get_mean()
+              << ", stddev: " << _stats.get_stddev() << "\n"
+              << std::endl;
+
+    ASSERT_EQ(_stats.get_count(), static_cast<int64_t>(_data.size()));
+    ASSERT_NEAR(_stats.get_mean(), _mean, 1.0e-9 * _mean);
+    ASSERT_NEAR(_stats.get_variance(), _var, 1.0e-9 * _var);
+}
+
+//--------------------------------------------------------------------------------------//
+
+TEST_F(statistics_tests, quantiles)
+{
+    auto _data = details::generate(100000);
+
+    stats_t _stats;
+    for(const auto& itr : _data)
+        _stats += itr;
+
+    for(double _q : { 0.5, 0.9, 0.99, 0.999 })
+    {
+        auto _exact = details::exact_quantile(_data, _q);
+        auto _value = _stats.get_quantile(_q);
+        std::cout << "[" << details::get_test_name() << "]> q" << _q << ": " << _value
+                  << " (exact: " << _exact << ")" << std::endl;
+        ASSERT_NEAR(_value, _exact, 0.01 * _exact + 1.0);
+    }
+
+    // the extremes are bounded by the exact min and max
+    ASSERT_GE(_stats.get_quantile(0.0), _stats.get_min());
+    ASSERT_LE(_stats.get_quantile(1.0), _stats.get_max());
+}
+
+//--------------------------------------------------------------------------------------//
+
+TEST_F(statistics_tests, merge)
+{
+    auto _data = details::generate(50000);
+
+    stats_t _total;
+    stats_t _part[4];
+    for(size_t i = 0; i < _data.size(); ++i)
+    {
+        _total += _data[i];
+        _part[i % 4] += _data[i];
+    }
+
+    stats_t _merged;
+    for(const auto& itr : _part)
+        _merged += itr;
+
+    ASSERT_EQ(_merged.get_count(), _total.get_count());
+    ASSERT_EQ(_merged.get_sum(), _total.get_sum());
+    ASSERT_EQ(_merged.get_min(), _total.get_min());
+    ASSERT_EQ(_merged.get_max(), _total.get_max());
+    ASSERT_NEAR(_merged.get_mean(), _total.get_mean(), 1.0e-9 * _total.get_mean());
+    ASSERT_NEAR(_merged.get_stddev(), _total.get_stddev(), 1.0e-9 * _total.get_stddev());
+    for(double _q : { 0.5, 0.99, 0.999 })
+        ASSERT_EQ(_merged.get_quantile(_q), _total.get_quantile(_q));
+}
+
+//--------------------------------------------------------------------------------------//
+
+TEST_F(statistics_tests, scalar)
+{
+    using dstats_t = tim::statistics<double>;
+
+    auto _data = details::generate(50000);
+
+    dstats_t _divided;
+    dstats_t _shifted;
+    dstats_t _expected_divided;
+    dstats_t _expected_shifted;
+    for(const auto& itr : _data)
+    {
+        auto _val = static_cast<double>(itr);
+        _divided += _val;
+        _shifted += _val;
+        _expected_divided += _val / 4.0;
+        _expected_shifted += _val - 100.0;
+    }
+
+    // e.g. the mean over 4 processes
+    _divided /= 4.0;
+    _shifted -= 100.0;
+
+    for(auto _check : { std::make_pair(&_divided, &_expected_divided),
+                        std::make_pair(&_shifted, &_expected_shifted) })
+    {
+        const auto& _stats    = *_check.first;
+        const auto& _expected = *_check.second;
+        ASSERT_EQ(_stats.get_count(), _expected.get_count());
+        ASSERT_NEAR(_stats.get_mean(), _expected.get_mean(),
+                    1.0e-9 * std::fabs(_expected.get_mean()));
+        ASSERT_NEAR(_stats.get_stddev(), _expected.get_stddev(),
+                    1.0e-9 * _expected.get_stddev());
+        // re-binning the sketch adds at most the accuracy of the sketch
+        for(double _q : { 0.5, 0.99, 0.999 })
+        {
+            auto _exact = _expected.get_quantile(_q);
+            ASSERT_NEAR(_stats.get_quantile(_q), _exact, 0.03 * std::fabs(_exact) + 1.0)
+                << " quantile " << _q;
+        }
+    }
+}
+
+//--------------------------------------------------------------------------------------//
+
+TEST_F(statistics_tests, serialization)
+{
+    auto _data = details::generate(10000);
+
+    stats_t _stats;
+    for(const auto& itr : _data)
+        _stats += itr;
+
+    std::stringstream ss;
+    {
+        cereal::JSONOutputArchive oa(ss);
+        oa(cereal::make_nvp("stats", _stats));
+    }
+
+    stats_t _loaded;
+    {
+        cereal::JSONInputArchive ia(ss);
+        ia(cereal::make_nvp("stats", _loaded));
+    }
+
+    ASSERT_EQ(_loaded.get_count(), _stats.get_count());
+    ASSERT_EQ(_loaded.get_sum(), _stats.get_sum());
+    ASSERT_NEAR(_loaded.get_mean(), _stats.get_mean(), 1.0e-6 * _stats.get_mean());
+    ASSERT_NEAR(_loaded.get_stddev(), _stats.get_stddev(), 1.0e-6 * _stats.get_stddev());
+    for(double _q : { 0.5, 0.99, 0.999 })
+        ASSERT_EQ(_loaded.get_quantile(_q), _stats.get_quantile(_q));
+}
+
+//--------------------------------------------------------------------------------------//
+
+int
+main(int argc, char** argv)
+{
+    ::testing::InitGoogleTest(&argc, argv);
+    tim::settings::verbose() = 0;
+    tim::settings::debug()   = false;
+    tim::settings::banner()  = false;
+    return RUN_ALL_TESTS();
+}
+
+//--------------------------------------------------------------------------------------//
@@ -139,6 +139,22 @@ TEST_F(timing_tests, monotonic_raw_timer)
 
 //--------------------------------------------------------------------------------------//
 
+TEST_F(timing_tests, tsc_timer)
+{
+    CHECK_AVAILABLE(tsc_clock);
+    tsc_clock obj;
+    obj.start();
+    details::do_sleep(1000);
+    obj.stop();
+    std::cout << "\n[" << details::get_test_name() << "]> result: " << obj
+              << " (invariant tsc: " << std::boolalpha
+              << tim::tsc::get_calibration().valid << ")\n"
+              << std::endl;
+    ASSERT_NEAR(1.0, obj.get(), timer_tolerance);
+}
+
+//--------------------------------------------------------------------------------------//
+
 TEST_F(timing_tests, system_timer)
 {
     CHECK_AVAILABLE(system_clock);
@@ -262,6 +278,36 @@ TEST_F(timing_tests, process_cpu_utilization)
 
 //--------------------------------------------------------------------------------------//
 
+TEST_F(timing_tests, shared_clock_sample)
+{
+    using tuple_t =
+        tim::component_tuple<wall_clock, cpu_clock, cpu_util, thread_cpu_util>;
+
+    auto    _beg = tim::get_clock_reads();
+    tuple_t obj(details::get_test_name(), false);
+    obj.start();
+    details::consume(500);
+    obj.stop();
+    auto _reads = tim::get_clock_reads() - _beg;
+
+    std::cout << "\n[" << details::get_test_name() << "]> result: " << obj
+              << ", clock reads: " << _reads << "\n"
+              << std::endl;
+
+    // wall-clock, times, and the thread cpu-clock are each read once by start and stop
+    ASSERT_EQ(_reads, 6);
+
+    auto _wall        = obj.get<wall_clock>().get_accum();
+    auto _cpu         = obj.get<cpu_clock>().get_accum();
+    auto _util        = obj.get<cpu_util>().get_accum();
+    auto _thread_util = obj.get<thread_cpu_util>().get_accum();
+    ASSERT_EQ(_wall, _util.second);
+    ASSERT_EQ(_wall, _thread_util.second);
+    ASSERT_EQ(_cpu, _util.first);
+}
+
+//--------------------------------------------------------------------------------------//
+
 int
 main(int argc, char** argv)
 {
@@ -58,6 +58,9 @@ using custom_bundle_t      = user_bundle<0, bundle_testing>;
 using auto_custom_bundle_t = tim::auto_tuple<custom_bundle_t>;
 using comp_custom_bundle_t = typename auto_custom_bundle_t::component_type;
 
+using table_bundle_t    = user_bundle<1, bundle_testing>;
+using function_bundle_t = user_bundle<2, bundle_testing>;
+
 //--------------------------------------------------------------------------------------//
 
 namespace details
@@ -102,6 +105,24 @@ consume(long n)
         try_lk.try_lock();
 }
 
+// average time (in microseconds) to construct, start, and stop a bundle
+template <typename _Bundle>
+inline double
+measure(const std::string& _prefix, int64_t nitr)
+{
+    using clock_type = std::chrono::steady_clock;
+    using duration_t = std::chrono::duration<double, std::micro>;
+
+    auto _beg = clock_type::now();
+    for(int64_t i = 0; i < nitr; ++i)
+    {
+        _Bundle _obj(_prefix);
+        _obj.start();
+        _obj.stop();
+    }
+    return duration_t(clock_type::now() - _beg).count() / nitr;
+}
+
 }  // namespace details
 
 //--------------------------------------------------------------------------------------//
@@ -455,6 +476,96 @@ TEST_F(user_bundle_tests, bundle_insert_ext)
 
 //--------------------------------------------------------------------------------------//
 
+TEST_F(user_bundle_tests, bundle_benchmark)
+{
+    printf("TEST_NAME: %s\n", details::get_test_name().c_str());
+
+    using toolset_t = tim::auto_tuple<wall_clock>;
+
+    table_bundle_t::reset();
+    function_bundle_t::reset();
+
+    // the function-pointer table
+    table_bundle_t::configure<wall_clock>();
+
+    // the equivalent of the std::function implementation of configure<wall_clock>()
+    function_bundle_t::configure(
+        [](const std::string& _prefix) {
+            toolset_t* _result = new toolset_t(_prefix, tim::settings::flat_profile());
+            _result->start();
+            return (void*) _result;
+        },
+        [](void* v_result) {
+            toolset_t* _result = static_cast<toolset_t*>(v_result);
+            _result->stop();
+            delete _result;
+        });
+
+    ASSERT_EQ(table_bundle_t::get_table()->entries.size(), size_t(1));
+    ASSERT_EQ(table_bundle_t::get_start().size(), size_t(0));
+    ASSERT_EQ(function_bundle_t::get_start().size(), size_t(1));
+
+    const int64_t nitr        = 100000;
+    auto          _table_time = details::measure<table_bundle_t>(
+        details::get_test_name() + "/table", nitr);
+    auto _funcs_time = details::measure<function_bundle_t>(
+        details::get_test_name() + "/function", nitr);
+
+    printf("[%s]> table    : %8.3f usec per region\n",
+           details::get_test_name().c_str(), _table_time);
+    printf("[%s]> function : %8.3f usec per region\n",
+           details::get_test_name().c_str(), _funcs_time);
+
+    auto wc_n = wc_size_orig + 2;
+    ASSERT_EQ(tim::storage<wall_clock>::instance()->size(), wc_n);
+
+    table_bundle_t::reset();
+    function_bundle_t::reset();
+}
+
+//--------------------------------------------------------------------------------------//
+
+TEST_F(user_bundle_tests, bundle_move)
+{
+    printf("TEST_NAME: %s\n", details::get_test_name().c_str());
+
+    table_bundle_t::reset();
+    table_bundle_t::configure<wall_clock>();
+
+    auto _prefix = details::get_test_name();
+    auto _get    = [&]() {
+        std::vector<wall_clock> _ret;
+        for(auto& itr : tim::storage<wall_clock>::instance()->get())
+        {
+            if(itr.prefix().find(_prefix) != std::string::npos)
+                _ret.push_back(itr.data());
+        }
+        return _ret;
+    };
+
+    {
+        table_bundle_t _assigned(_prefix + "/unused");
+        {
+            table_bundle_t _orig(_prefix);
+            _orig.start();
+            table_bundle_t _moved(std::move(_orig));
+            _assigned = std::move(_moved);
+        }
+        // the moved-from instances must not have stopped the running tool
+        details::do_sleep(50);
+        _assigned.stop();
+    }
+
+    auto _records = _get();
+    ASSERT_EQ(_records.size(), size_t(1));
+    EXPECT_EQ(_records.front().nlaps(), 1);
+    EXPECT_GE(_records.front().get_accum(), 40 * std::nano::den / std::milli::den);
+
+    table_bundle_t::reset();
+}
+
+//--------------------------------------------------------------------------------------//
+
 int
 main(int argc, char** argv)
 {
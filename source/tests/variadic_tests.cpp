@@ -216,6 +216,82 @@ TEST_F(variadic_tests, concat)
 
 //--------------------------------------------------------------------------------------//
 
+TEST_F(variadic_tests, component_set)
+{
+    using list_t = tim::component_list<real_clock, cpu_clock, peak_rss, user_clock>;
+    using set_t  = tim::component_set<list_t>;
+
+    // duplicates are ignored and the mask matches the enumerations
+    set_t _set("wall_clock, cpu_clock, real_clock, peak_rss");
+    EXPECT_EQ(_set.size(), 3u);
+    EXPECT_TRUE(_set.count(WALL_CLOCK));
+    EXPECT_TRUE(_set.count(CPU_CLOCK));
+    EXPECT_TRUE(_set.count(PEAK_RSS));
+    EXPECT_FALSE(_set.count(USER_CLOCK));
+
+    set_t _enum_set(std::vector<TIMEMORY_COMPONENT>({ CPU_CLOCK, WALL_CLOCK, PEAK_RSS }));
+    EXPECT_EQ(_enum_set.mask(), _set.mask());
+
+    list_t _obj(details::get_test_name(), false, false, _set);
+    EXPECT_NE(_obj.get<real_clock>(), nullptr);
+    EXPECT_NE(_obj.get<cpu_clock>(), nullptr);
+    EXPECT_NE(_obj.get<peak_rss>(), nullptr);
+    EXPECT_EQ(_obj.get<user_clock>(), nullptr);
+
+    // same result as the enumeration path
+    list_t _ref(details::get_test_name(), false, false, [](list_t&) {});
+    tim::initialize(_ref, { WALL_CLOCK, CPU_CLOCK, PEAK_RSS });
+    EXPECT_EQ(_ref.get<real_clock>() != nullptr, _obj.get<real_clock>() != nullptr);
+    EXPECT_EQ(_ref.get<cpu_clock>() != nullptr, _obj.get<cpu_clock>() != nullptr);
+    EXPECT_EQ(_ref.get<peak_rss>() != nullptr, _obj.get<peak_rss>() != nullptr);
+    EXPECT_EQ(_ref.get<user_clock>() != nullptr, _obj.get<user_clock>() != nullptr);
+}
+
+//--------------------------------------------------------------------------------------//
+
+TEST_F(variadic_tests, list_copy_move)
+{
+    using list_t = tim::component_list<real_clock, cpu_clock, peak_rss, user_clock>;
+
+    list_t _obj(details::get_test_name(), false, false, [](list_t& _l) {
+        _l.initialize<real_clock, cpu_clock>();
+    });
+
+    _obj.start();
+    auto ret = details::fibonacci(30);
+    _obj.stop();
+    printf("fibonacci(30) = %li\n", (long) ret);
+
+    auto _wc = _obj.get<real_clock>()->get();
+    auto _cc = _obj.get<cpu_clock>()->get();
+
+    // copy constructs new components with the same values
+    list_t _copy(_obj);
+    ASSERT_NE(_copy.get<real_clock>(), nullptr);
+    ASSERT_NE(_copy.get<real_clock>(), _obj.get<real_clock>());
+    EXPECT_EQ(_copy.get<peak_rss>(), nullptr);
+    EXPECT_EQ(_copy.get<real_clock>()->get(), _wc);
+    EXPECT_EQ(_copy.get<cpu_clock>()->get(), _cc);
+
+    // move transfers the components
+    auto*  _ptr = _copy.get<cpu_clock>();
+    list_t _move(std::move(_copy));
+    EXPECT_EQ(_move.get<cpu_clock>(), _ptr);
+    EXPECT_EQ(_copy.get<cpu_clock>(), nullptr);
+    EXPECT_EQ(_move.get<real_clock>()->get(), _wc);
+
+    // assignment replaces the components
+    list_t _assign(details::get_test_name(), false, false, [](list_t& _l) {
+        _l.initialize<peak_rss, user_clock>();
+    });
+    _assign = _move;
+    EXPECT_EQ(_assign.get<peak_rss>(), nullptr);
+    EXPECT_EQ(_assign.get<user_clock>(), nullptr);
+    EXPECT_EQ(_assign.get<cpu_clock>()->get(), _cc);
+}
+
+//--------------------------------------------------------------------------------------//
+
 int
 main(int argc, char** argv)
 {
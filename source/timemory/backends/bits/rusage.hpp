@@ -51,6 +51,236 @@ check_rusage_call(int ret, const char* _func)
 #endif
 }
 
+//--------------------------------------------------------------------------------------//
+
+inline int64_t&
+get_rusage_syscalls()
+{
+    static thread_local int64_t _instance = 0;
+    return _instance;
+}
+
+//--------------------------------------------------------------------------------------//
+
+inline rusage_snapshot::state&
+rusage_snapshot::get_state()
+{
+    static thread_local state _instance;
+    return _instance;
+}
+
+//--------------------------------------------------------------------------------------//
+
+inline rusage_snapshot::rusage_snapshot()
+: m_owner(!get_state().active)
+{
+    if(m_owner)
+    {
+        auto& _state     = get_state();
+        _state.active    = true;
+        _state.has_usage = false;
+        _state.has_statm = false;
+        _state.has_io    = false;
+    }
+}
+
+//--------------------------------------------------------------------------------------//
+
+inline rusage_snapshot::~rusage_snapshot()
+{
+    if(m_owner)
+    {
+        auto& _state     = get_state();
+        _state.active    = false;
+        _state.has_usage = false;
+        _state.has_statm = false;
+        _state.has_io    = false;
+    }
+}
+
+//--------------------------------------------------------------------------------------//
+
+namespace impl
+{
+#if defined(_UNIX)
+//--------------------------------------------------------------------------------------//
+//  getrusage, re-used while a snapshot is active
+//
+inline const struct rusage&
+read_rusage()
+{
+    auto& _state = rusage_snapshot::get_state();
+    if(!_state.has_usage)
+    {
+        ++get_rusage_syscalls();
+        check_rusage_call(getrusage(get_rusage_type(), &_state.usage), __FUNCTION__);
+        _state.has_usage = _state.active;
+    }
+    return _state.usage;
+}
+#endif
+
+#if defined(_UNIX) && !defined(_MACOS)
+//--------------------------------------------------------------------------------------//
+//  a file in /proc/<pid> which is opened on the first read and then re-read from
+//  offset 0 with pread. The file is re-opened if get_rusage_pid() changes. Instances
+//  are thread-local so the reads do not need to be synchronized
+//
+class proc_file
+{
+public:
+    explicit proc_file(const char* _name)
+    : m_name(_name)
+    {}
+
+    ~proc_file() { close(); }
+
+    proc_file(const proc_file&) = delete;
+    proc_file& operator=(const proc_file&) = delete;
+
+    /// read the file into _buf (null-terminated), returns the number of characters or
+    /// -1 if the file could not be read
+    ssize_t read(char* _buf, size_t _n)
+    {
+        if(m_pid != get_rusage_pid())
+            open();
+        if(m_fd < 0 || _n == 0)
+            return -1;
+        auto _ret = ::pread(m_fd, _buf, _n - 1, 0);
+        if(_ret < 0)
+        {
+            close();
+            return -1;
+        }
+        _buf[_ret] = '\0';
+        return _ret;
+    }
+
+private:
+    void open()
+    {
+        close();
+        char _path[64];
+        m_pid = get_rusage_pid();
+        snprintf(_path, sizeof(_path), "/proc/%li/%s", (long) m_pid, m_name);
+        m_fd = ::open(_path, O_RDONLY | O_CLOEXEC);
+    }
+
+    void close()
+    {
+        if(m_fd >= 0)
+            ::close(m_fd);
+        m_fd = -1;
+    }
+
+private:
+    const char* m_name = nullptr;
+    int         m_fd   = -1;
+    pid_t       m_pid  = -1;
+};
+
+//--------------------------------------------------------------------------------------//
+//  parses the next (non-negative) integer in [_beg, _end) and advances _beg past it.
+//  Returns false if there are no more digits
+//
+inline bool
+parse_integer(const char*& _beg, const char* _end, int64_t& _val)
+{
+    while(_beg < _end && (*_beg < '0' || *_beg > '9'))
+        ++_beg;
+    if(_beg == _end)
+        return false;
+    _val = 0;
+    for(; _beg < _end && *_beg >= '0' && *_beg <= '9'; ++_beg)
+        _val = (10 * _val) + (*_beg - '0');
+    return true;
+}
+
+//--------------------------------------------------------------------------------------//
+//  /proc/<pid>/statm, re-used while a snapshot is active
+//
+inline const int64_t*
+read_statm()
+{
+    auto& _state = rusage_snapshot::get_state();
+    if(!_state.has_statm)
+    {
+        static thread_local proc_file _file("statm");
+        char                          _buf[256];
+
+        ++get_rusage_syscalls();
+        for(auto& itr : _state.statm)
+            itr = 0;
+        auto _n = _file.read(_buf, sizeof(_buf));
+        if(_n > 0)
+        {
+            const char* _beg = _buf;
+            for(auto& itr : _state.statm)
+            {
+                if(!parse_integer(_beg, _buf + _n, itr))
+                    break;
+            }
+        }
+        _state.has_statm = _state.active;
+    }
+    return _state.statm;
+}
+#endif
+
+#if defined(_LINUX)
+//--------------------------------------------------------------------------------------//
+//  /proc/<pid>/io, re-used while a snapshot is active
+//
+inline const int64_t*
+read_proc_io()
+{
+    auto& _state = rusage_snapshot::get_state();
+    if(!_state.has_io)
+    {
+        static thread_local proc_file _file("io");
+        char                          _buf[512];
+
+        ++get_rusage_syscalls();
+        _state.io[0] = 0;
+        _state.io[1] = 0;
+        auto _n = _file.read(_buf, sizeof(_buf));
+        if(_n > 0)
+        {
+            // each line is "<label>: <value>"
+            static const char   _read[]  = "read_bytes:";
+            static const char   _write[] = "write_bytes:";
+            static const size_t _nread   = sizeof(_read) - 1;
+            static const size_t _nwrite  = sizeof(_write) - 1;
+
+            const char* _end = _buf + _n;
+            for(const char* _beg = _buf; _beg < _end;)
+            {
+                auto _eol = static_cast<const char*>(memchr(_beg, '\n', _end - _beg));
+                if(!_eol)
+                    _eol = _end;
+                auto _len = static_cast<size_t>(_eol - _beg);
+                if(_len > _nread && strncmp(_beg, _read, _nread) == 0)
+                {
+                    _beg += _nread;
+                    parse_integer(_beg, _eol, _state.io[0]);
+                }
+                else if(_len > _nwrite && strncmp(_beg, _write, _nwrite) == 0)
+                {
+                    _beg += _nwrite;
+                    parse_integer(_beg, _eol, _state.io[1]);
+                }
+                _beg = _eol + 1;
+            }
+        }
+        _state.has_io = _state.active;
+    }
+    return _state.io;
+}
+#endif
+}  // namespace impl
+
+//--------------------------------------------------------------------------------------//
+
 }  // namespace tim
 
 //======================================================================================//
@@ -62,8 +292,7 @@ inline int64_t
 tim::get_peak_rss()
 {
 #if defined(_UNIX)
-    struct rusage _usage;
-    check_rusage_call(getrusage(get_rusage_type(), &_usage), __FUNCTION__);
+    const auto& _usage = impl::read_rusage();
 
 // Darwin reports in bytes, Linux reports in kilobytes
 #    if defined(_MACOS)
@@ -125,20 +354,8 @@ tim::get_page_rss()
 
 #    else  // Linux
 
-    int64_t           rss = 0;
-    std::stringstream fio;
-    fio << "/proc/" << get_rusage_pid() << "/statm";
-    FILE* fp = fopen(fio.str().c_str(), "r");
-    if(fp && fscanf(fp, "%*s%ld", &rss) == 1)
-    {
-        fclose(fp);
-        return static_cast<int64_t>(rss * units::get_page_size());
-    }
-
-    if(fp)
-        fclose(fp);
-
-    return static_cast<int64_t>(0);
+    // resident
+    return static_cast<int64_t>(impl::read_statm()[1] * units::get_page_size());
 
 #    endif
 #elif defined(_WINDOWS)
@@ -170,8 +387,7 @@ inline int64_t
 tim::get_stack_rss()
 {
 #if defined(_UNIX)
-    struct rusage _usage;
-    check_rusage_call(getrusage(get_rusage_type(), &_usage), __FUNCTION__);
+    const auto& _usage = impl::read_rusage();
 
     const int64_t _units = units::kilobyte * units::clocks_per_sec;
     return static_cast<int64_t>(_units * _usage.ru_isrss);
@@ -187,31 +403,15 @@ tim::get_data_rss()
 {
 #if defined(_UNIX)
 #    if defined(_MACOS)
-    struct rusage _usage;
-    check_rusage_call(getrusage(get_rusage_type(), &_usage), __FUNCTION__);
+    const auto& _usage = impl::read_rusage();
 
     const int64_t _units = units::kilobyte * units::clocks_per_sec;
     return static_cast<int64_t>(_units * _usage.ru_idrss);
 
 #    else  // Linux
 
-    static auto get_statm_file = [&]() {
-        std::stringstream fio;
-        fio << "/proc/" << get_rusage_pid() << "/statm";
-        return fio.str();
-    };
-
-    std::string   fstatm    = get_statm_file();
-    int64_t       drss_size = 0;
-    std::ifstream ifs;
-    ifs.open(fstatm.c_str());
-    if(ifs)
-    {
-        static int64_t dummy = 0;
-        ifs >> dummy >> dummy >> dummy >> dummy >> dummy >> drss_size;
-    }
-    ifs.close();
-    return static_cast<int64_t>(drss_size * units::get_page_size());
+    // data
+    return static_cast<int64_t>(impl::read_statm()[5] * units::get_page_size());
 #    endif
 #else
     return static_cast<int64_t>(0);
@@ -224,8 +424,7 @@ inline int64_t
 tim::get_num_swap()
 {
 #if defined(_UNIX)
-    struct rusage _usage;
-    check_rusage_call(getrusage(get_rusage_type(), &_usage), __FUNCTION__);
+    const auto& _usage = impl::read_rusage();
 
     return static_cast<int64_t>(_usage.ru_nswap);
 #else
@@ -239,8 +438,7 @@ inline int64_t
 tim::get_num_io_in()
 {
 #if defined(_UNIX)
-    struct rusage _usage;
-    check_rusage_call(getrusage(get_rusage_type(), &_usage), __FUNCTION__);
+    const auto& _usage = impl::read_rusage();
 
     return static_cast<int64_t>(_usage.ru_inblock);
 #else
@@ -254,8 +452,7 @@ inline int64_t
 tim::get_num_io_out()
 {
 #if defined(_UNIX)
-    struct rusage _usage;
-    check_rusage_call(getrusage(get_rusage_type(), &_usage), __FUNCTION__);
+    const auto& _usage = impl::read_rusage();
 
     return static_cast<int64_t>(_usage.ru_oublock);
 #else
@@ -269,8 +466,7 @@ inline int64_t
 tim::get_num_minor_page_faults()
 {
 #if defined(_UNIX)
-    struct rusage _usage;
-    check_rusage_call(getrusage(get_rusage_type(), &_usage), __FUNCTION__);
+    const auto& _usage = impl::read_rusage();
 
     return static_cast<int64_t>(_usage.ru_minflt);
 #else
@@ -284,8 +480,7 @@ inline int64_t
 tim::get_num_major_page_faults()
 {
 #if defined(_UNIX)
-    struct rusage _usage;
-    check_rusage_call(getrusage(get_rusage_type(), &_usage), __FUNCTION__);
+    const auto& _usage = impl::read_rusage();
 
     return static_cast<int64_t>(_usage.ru_majflt);
 #else
@@ -299,8 +494,7 @@ inline int64_t
 tim::get_num_messages_sent()
 {
 #if defined(_UNIX)
-    struct rusage _usage;
-    check_rusage_call(getrusage(get_rusage_type(), &_usage), __FUNCTION__);
+    const auto& _usage = impl::read_rusage();
 
     return static_cast<int64_t>(_usage.ru_msgsnd);
 #else
@@ -314,8 +508,7 @@ inline int64_t
 tim::get_num_messages_received()
 {
 #if defined(_UNIX)
-    struct rusage _usage;
-    check_rusage_call(getrusage(get_rusage_type(), &_usage), __FUNCTION__);
+    const auto& _usage = impl::read_rusage();
 
     return static_cast<int64_t>(_usage.ru_msgrcv);
 #else
@@ -329,8 +522,7 @@ inline int64_t
 tim::get_num_signals()
 {
 #if defined(_UNIX)
-    struct rusage _usage;
-    check_rusage_call(getrusage(get_rusage_type(), &_usage), __FUNCTION__);
+    const auto& _usage = impl::read_rusage();
 
     return static_cast<int64_t>(_usage.ru_nsignals);
 #else
@@ -344,8 +536,7 @@ inline int64_t
 tim::get_num_voluntary_context_switch()
 {
 #if defined(_UNIX)
-    struct rusage _usage;
-    check_rusage_call(getrusage(get_rusage_type(), &_usage), __FUNCTION__);
+    const auto& _usage = impl::read_rusage();
 
     return static_cast<int64_t>(_usage.ru_nvcsw);
 #else
@@ -359,8 +550,7 @@ inline int64_t
 tim::get_num_priority_context_switch()
 {
 #if defined(_UNIX)
-    struct rusage _usage;
-    check_rusage_call(getrusage(get_rusage_type(), &_usage), __FUNCTION__);
+    const auto& _usage = impl::read_rusage();
 
     return static_cast<int64_t>(_usage.ru_nivcsw);
 #else
@@ -378,22 +568,7 @@ tim::get_bytes_read()
     if(proc_pid_rusage(get_rusage_pid(), RUSAGE_INFO_CURRENT, (void**) &rusage) == 0)
         return rusage.ri_diskio_bytesread;
 #elif defined(_LINUX)
-    std::stringstream fio;
-    fio << "/proc/" << get_rusage_pid() << "/io";
-    std::string   label = "";
-    int64_t       value = 0;
-    std::ifstream ifs(fio.str().c_str());
-    if(ifs)
-    {
-        static constexpr int max_lines = 7;
-        for(int i = 0; i < max_lines && !ifs.eof(); ++i)
-        {
-            ifs >> label;
-            ifs >> value;
-            if(label.find("read_bytes") != std::string::npos)
-                return value;
-        }
-    }
+    return impl::read_proc_io()[0];
 #endif
     return 0;
 }
@@ -408,22 +583,7 @@ tim::get_bytes_written()
     if(proc_pid_rusage(get_rusage_pid(), RUSAGE_INFO_CURRENT, (void**) &rusage) == 0)
         return rusage.ri_diskio_byteswritten;
 #elif defined(_LINUX)
-    std::stringstream fio;
-    fio << "/proc/" << get_rusage_pid() << "/io";
-    std::string   label = "";
-    int64_t       value = 0;
-    std::ifstream ifs(fio.str().c_str());
-    if(ifs)
-    {
-        static constexpr int max_lines = 7;
-        for(int i = 0; i < max_lines && !ifs.eof(); ++i)
-        {
-            ifs >> label;
-            ifs >> value;
-            if(label.find("write_bytes") != std::string::npos)
-                return value;
-        }
-    }
+    return impl::read_proc_io()[1];
 #endif
     return 0;
 }
@@ -454,20 +614,8 @@ tim::get_virt_mem()
 
 #    else  // Linux
 
-    static auto get_statm_file = [&]() {
-        std::stringstream fio;
-        fio << "/proc/" << get_rusage_pid() << "/statm";
-        return fio.str();
-    };
-
-    std::string   fstatm  = get_statm_file();
-    int64_t       vm_size = 0;
-    std::ifstream ifs;
-    ifs.open(fstatm.c_str());
-    if(ifs)
-        ifs >> vm_size;
-    ifs.close();
-    return static_cast<int64_t>(vm_size * units::get_page_size());
+    // size
+    return static_cast<int64_t>(impl::read_statm()[0] * units::get_page_size());
 
 #    endif
 #elif defined(_WINDOWS)
@@ -49,6 +49,19 @@
 #include "timemory/utility/macros.hpp"
 #include "timemory/utility/utility.hpp"
 
+#if !defined(TIMEMORY_DISABLE_TSC) &&                                                    \
+    (defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86))
+#    if !defined(TIMEMORY_TSC_AVAILABLE)
+#        define TIMEMORY_TSC_AVAILABLE
+#    endif
+#    if defined(_MSC_VER)
+#        include <intrin.h>
+#    else
+#        include <cpuid.h>
+#        include <x86intrin.h>
+#    endif
+#endif
+
 #if defined(_UNIX)
 
 #    include <pthread.h>
@@ -292,6 +305,151 @@ clock_tick()
     return result;
 }
 
+//--------------------------------------------------------------------------------------//
+/// the number of clock reads made on this thread by the get_clock_*_now functions below
+inline int64_t&
+get_clock_reads()
+{
+    static thread_local int64_t _instance = 0;
+    return _instance;
+}
+
+//--------------------------------------------------------------------------------------//
+/// \class clock_snapshot
+/// \brief While an instance is alive on a thread, the first call to one of the
+/// get_clock_*_now functions below reads the clock and the subsequent calls on the
+/// thread that need the same clock re-use that sample. The bundles create one around
+/// the start and stop of their components so that, e.g., wall_clock, cpu_util, and
+/// read_bytes all see the same wall-clock time. Nested instances are no-ops.
+///
+class clock_snapshot
+{
+public:
+    enum clock_index
+    {
+        real_idx = 0,
+        monotonic_idx,
+        monotonic_raw_idx,
+        thread_idx,
+        process_idx,
+        num_clocks
+    };
+
+    struct state
+    {
+        bool    active                = false;
+        bool    has_times             = false;
+        bool    has_clock[num_clocks] = {};
+        int64_t clock[num_clocks]     = {};  // nanoseconds
+        tms     times;
+    };
+
+    clock_snapshot()
+    : m_owner(!get_state().active)
+    {
+        if(m_owner)
+            reset(true);
+    }
+
+    ~clock_snapshot()
+    {
+        if(m_owner)
+            reset(false);
+    }
+
+    clock_snapshot(const clock_snapshot&) = delete;
+    clock_snapshot(clock_snapshot&&)      = delete;
+    clock_snapshot& operator=(const clock_snapshot&) = delete;
+    clock_snapshot& operator=(clock_snapshot&&) = delete;
+
+    static state& get_state()
+    {
+        static thread_local state _instance;
+        return _instance;
+    }
+
+    static bool is_active() { return get_state().active; }
+
+    /// the value of the clock in nanoseconds, _func is invoked to read the clock when
+    /// there is no sample for the active snapshot
+    template <typename _Func>
+    static int64_t read(clock_index _idx, _Func&& _func)
+    {
+        auto& _state = get_state();
+        if(!_state.has_clock[_idx])
+        {
+            ++get_clock_reads();
+            _state.clock[_idx]     = _func();
+            _state.has_clock[_idx] = _state.active;
+        }
+        return _state.clock[_idx];
+    }
+
+    /// the process times, re-used while a snapshot is active
+    static const tms& read_times()
+    {
+        auto& _state = get_state();
+        if(!_state.has_times)
+        {
+            ++get_clock_reads();
+            ::times(&_state.times);
+            _state.has_times = _state.active;
+        }
+        return _state.times;
+    }
+
+private:
+    static void reset(bool _active)
+    {
+        auto& _state     = get_state();
+        _state.active    = _active;
+        _state.has_times = false;
+        for(int i = 0; i < num_clocks; ++i)
+            _state.has_clock[i] = false;
+    }
+
+private:
+    bool m_owner = false;
+};
+
+//--------------------------------------------------------------------------------------//
+/// a clock_snapshot when _Enabled is true, otherwise does nothing. Used by the bundles
+/// which only need a snapshot when they contain more than one clock-derived component
+///
+template <bool _Enabled>
+struct conditional_clock_snapshot : clock_snapshot
+{};
+
+template <>
+struct conditional_clock_snapshot<false>
+{};
+
+//--------------------------------------------------------------------------------------//
+
+namespace impl
+{
+inline int64_t
+clock_nsec(clockid_t clock_id)
+{
+#if defined(_MACOS)
+    return clock_gettime_nsec_np(clock_id);
+#else
+    struct timespec ts;
+    clock_gettime(clock_id, &ts);
+    return ts.tv_sec * std::nano::den + ts.tv_nsec;
+#endif
+}
+
+inline int64_t
+steady_nsec()
+{
+    using clock_type    = std::chrono::steady_clock;
+    using duration_type = std::chrono::duration<int64_t, std::nano>;
+    return std::chrono::duration_cast<duration_type>(clock_type::now().time_since_epoch())
+        .count();
+}
+}  // namespace impl
+
 //--------------------------------------------------------------------------------------//
 // general struct for the differnt clock_gettime functions
 template <typename _Tp = double, typename Precision = std::ratio<1>>
@@ -308,6 +466,17 @@ get_clock_now(clockid_t clock_id)
 #endif
 }
 
+//--------------------------------------------------------------------------------------//
+// clock_gettime for one of the clocks which can be shared through a clock_snapshot
+template <typename _Tp = double, typename Precision = std::ratio<1>>
+_Tp
+get_clock_now(clock_snapshot::clock_index _idx, clockid_t clock_id)
+{
+    constexpr _Tp factor = static_cast<_Tp>(std::nano::den) / Precision::den;
+    return clock_snapshot::read(_idx, [=]() { return impl::clock_nsec(clock_id); }) /
+           factor;
+}
+
 //--------------------------------------------------------------------------------------//
 // the system's real time (i.e. wall time) clock, expressed as the amount of time since
 // the epoch.
@@ -317,10 +486,11 @@ get_clock_real_now()
 {
     using clock_type    = std::chrono::steady_clock;
     using duration_type = std::chrono::duration<clock_type::rep, Precision>;
+    using nsec_type     = std::chrono::duration<int64_t, std::nano>;
 
     // return get_clock_now<_Tp, Precision>(CLOCK_REALTIME);
-    return std::chrono::duration_cast<duration_type>(clock_type::now().time_since_epoch())
-        .count();
+    auto _nsec = clock_snapshot::read(clock_snapshot::real_idx, &impl::steady_nsec);
+    return std::chrono::duration_cast<duration_type>(nsec_type(_nsec)).count();
 }
 
 //--------------------------------------------------------------------------------------//
@@ -330,7 +500,8 @@ template <typename _Tp = double, typename Precision = std::ratio<1>>
 _Tp
 get_clock_monotonic_now()
 {
-    return get_clock_now<_Tp, Precision>(CLOCK_MONOTONIC);
+    constexpr auto _idx = clock_snapshot::monotonic_idx;
+    return get_clock_now<_Tp, Precision>(_idx, CLOCK_MONOTONIC);
 }
 
 //--------------------------------------------------------------------------------------//
@@ -341,7 +512,8 @@ template <typename _Tp = double, typename Precision = std::ratio<1>>
 _Tp
 get_clock_monotonic_raw_now()
 {
-    return get_clock_now<_Tp, Precision>(CLOCK_MONOTONIC_RAW);
+    constexpr auto _idx = clock_snapshot::monotonic_raw_idx;
+    return get_clock_now<_Tp, Precision>(_idx, CLOCK_MONOTONIC_RAW);
 }
 
 //--------------------------------------------------------------------------------------//
@@ -353,7 +525,8 @@ template <typename _Tp = double, typename Precision = std::ratio<1>>
 _Tp
 get_clock_thread_now()
 {
-    return get_clock_now<_Tp, Precision>(CLOCK_THREAD_CPUTIME_ID);
+    constexpr auto _idx = clock_snapshot::thread_idx;
+    return get_clock_now<_Tp, Precision>(_idx, CLOCK_THREAD_CPUTIME_ID);
 }
 
 //--------------------------------------------------------------------------------------//
@@ -364,7 +537,8 @@ template <typename _Tp = double, typename Precision = std::ratio<1>>
 _Tp
 get_clock_process_now()
 {
-    return get_clock_now<_Tp, Precision>(CLOCK_PROCESS_CPUTIME_ID);
+    constexpr auto _idx = clock_snapshot::process_idx;
+    return get_clock_now<_Tp, Precision>(_idx, CLOCK_PROCESS_CPUTIME_ID);
 }
 
 //--------------------------------------------------------------------------------------//
@@ -378,8 +552,7 @@ _Tp
 get_clock_user_now()
 {
     // return clock() / units::clocks_per_sec;
-    struct tms _tms;
-    ::times(&_tms);
+    const tms& _tms = clock_snapshot::read_times();
     return (_tms.tms_utime + _tms.tms_cutime) * static_cast<_Tp>(clock_tick<Precision>());
 }
 
@@ -393,8 +566,7 @@ template <typename _Tp = double, typename Precision = std::ratio<1>>
 _Tp
 get_clock_system_now()
 {
-    tms _tms;
-    ::times(&_tms);
+    const tms& _tms = clock_snapshot::read_times();
 #if defined(_WINDOWS)
     return (static_cast<_Tp>(_tms.tms_stime) + static_cast<_Tp>(_tms.tms_cstime)) *
            static_cast<_Tp>(clock_tick<Precision>());
@@ -413,12 +585,167 @@ template <typename _Tp = double, typename Precision = std::ratio<1>>
 _Tp
 get_clock_cpu_now()
 {
-    tms _tms;
-    ::times(&_tms);
+    const tms& _tms = clock_snapshot::read_times();
     return (_tms.tms_utime + _tms.tms_cutime + _tms.tms_stime + _tms.tms_cstime) *
            static_cast<_Tp>(clock_tick<Precision>());
 }
 
+//--------------------------------------------------------------------------------------//
+//
+//      time-stamp counter
+//
+//--------------------------------------------------------------------------------------//
+
+namespace tsc
+{
+//--------------------------------------------------------------------------------------//
+//  results of cpuid, the registers are eax, ebx, ecx, edx
+//
+inline bool
+cpuid(uint32_t _leaf, uint32_t (&_reg)[4])
+{
+#if defined(TIMEMORY_TSC_AVAILABLE) && defined(_MSC_VER)
+    int _info[4] = { 0, 0, 0, 0 };
+    __cpuid(_info, 0x80000000);
+    if(static_cast<uint32_t>(_info[0]) < _leaf)
+        return false;
+    __cpuid(_info, static_cast<int>(_leaf));
+    for(int i = 0; i < 4; ++i)
+        _reg[i] = static_cast<uint32_t>(_info[i]);
+    return true;
+#elif defined(TIMEMORY_TSC_AVAILABLE)
+    unsigned int _eax = 0, _ebx = 0, _ecx = 0, _edx = 0;
+    if(__get_cpuid(_leaf, &_eax, &_ebx, &_ecx, &_edx) == 0)
+        return false;
+    _reg[0] = _eax;
+    _reg[1] = _ebx;
+    _reg[2] = _ecx;
+    _reg[3] = _edx;
+    return true;
+#else
+    consume_parameters(_leaf, _reg);
+    return false;
+#endif
+}
+
+//--------------------------------------------------------------------------------------//
+/// the counter ticks at a constant rate regardless of the frequency scaling and
+/// power-state of the core (CPUID.80000007H:EDX[8])
+inline bool
+is_invariant()
+{
+    uint32_t _reg[4] = { 0, 0, 0, 0 };
+    return cpuid(0x80000007, _reg) && (_reg[3] & (1u << 8)) != 0;
+}
+
+//--------------------------------------------------------------------------------------//
+/// the rdtscp instruction is supported (CPUID.80000001H:EDX[27])
+inline bool
+has_rdtscp()
+{
+    uint32_t _reg[4] = { 0, 0, 0, 0 };
+    return cpuid(0x80000001, _reg) && (_reg[3] & (1u << 27)) != 0;
+}
+
+//--------------------------------------------------------------------------------------//
+/// read the counter. rdtscp waits for the preceding instructions to complete, when it
+/// is not supported, rdtsc is fenced so that it is not executed early
+inline uint64_t
+read(bool _rdtscp)
+{
+#if defined(TIMEMORY_TSC_AVAILABLE)
+    if(_rdtscp)
+    {
+        unsigned int _aux = 0;
+        return __rdtscp(&_aux);
+    }
+    _mm_lfence();
+    return __rdtsc();
+#else
+    consume_parameters(_rdtscp);
+    return 0;
+#endif
+}
+
+//--------------------------------------------------------------------------------------//
+/// conversion from ticks to the nanoseconds of CLOCK_MONOTONIC_RAW. When the counter is
+/// not invariant (or not available), valid is false and the monotonic raw clock is used
+///
+struct calibration
+{
+    bool     valid         = false;
+    bool     rdtscp        = false;
+    uint64_t base_ticks    = 0;
+    int64_t  base_nsec     = 0;
+    double   nsec_per_tick = 1.0;
+};
+
+//--------------------------------------------------------------------------------------//
+//  reads of CLOCK_MONOTONIC_RAW bracketing a read of the counter, the midpoint of the
+//  two clock reads is paired with the counter
+//
+inline std::pair<int64_t, uint64_t>
+sample(bool _rdtscp)
+{
+    auto _beg   = get_clock_now<int64_t, std::nano>(CLOCK_MONOTONIC_RAW);
+    auto _ticks = read(_rdtscp);
+    auto _end   = get_clock_now<int64_t, std::nano>(CLOCK_MONOTONIC_RAW);
+    return std::pair<int64_t, uint64_t>(_beg + (_end - _beg) / 2, _ticks);
+}
+
+//--------------------------------------------------------------------------------------//
+/// measure the rate of the counter against CLOCK_MONOTONIC_RAW over _window nanoseconds
+inline calibration
+calibrate(int64_t _window = 5 * std::nano::den / std::milli::den)
+{
+    calibration _cal;
+    if(!is_invariant())
+        return _cal;
+
+    _cal.rdtscp = has_rdtscp();
+    auto _beg   = sample(_cal.rdtscp);
+    auto _end   = _beg;
+    while(_end.first - _beg.first < _window)
+        _end = sample(_cal.rdtscp);
+
+    if(_end.second <= _beg.second)
+        return _cal;
+
+    _cal.valid         = true;
+    _cal.base_ticks    = _beg.second;
+    _cal.base_nsec     = _beg.first;
+    _cal.nsec_per_tick = static_cast<double>(_end.first - _beg.first) /
+                         static_cast<double>(_end.second - _beg.second);
+    return _cal;
+}
+
+//--------------------------------------------------------------------------------------//
+/// the calibration is performed once, on the first call
+inline const calibration&
+get_calibration()
+{
+    static calibration _instance = calibrate();
+    return _instance;
+}
+
+}  // namespace tsc
+
+//--------------------------------------------------------------------------------------//
+// the time-stamp counter converted to the time of CLOCK_MONOTONIC_RAW. Falls back to
+// CLOCK_MONOTONIC_RAW when the counter is not invariant
+template <typename _Tp = double, typename Precision = std::ratio<1>>
+_Tp
+get_clock_tsc_now()
+{
+    constexpr _Tp factor = static_cast<_Tp>(std::nano::den) / Precision::den;
+    const auto&   _cal   = tsc::get_calibration();
+    if(!_cal.valid)
+        return get_clock_now<_Tp, Precision>(CLOCK_MONOTONIC_RAW);
+    auto _ticks = static_cast<int64_t>(tsc::read(_cal.rdtscp) - _cal.base_ticks);
+    auto _nsec  = _cal.base_nsec + static_cast<int64_t>(_ticks * _cal.nsec_per_tick);
+    return _nsec / factor;
+}
+
 //--------------------------------------------------------------------------------------//
 
 }  // namespace tim
@@ -37,7 +37,10 @@
 
 #include <algorithm>
 #include <cstdint>
+#include <limits>
+#include <string>
 #include <unordered_map>
+#include <vector>
 
 #if defined(TIMEMORY_USE_MPI)
 #    include <mpi.h>
@@ -429,6 +432,72 @@ recv(std::string& str, int src, int tag, comm_t comm)
 #endif
 }
 
+//--------------------------------------------------------------------------------------//
+//  collects the string from every rank onto the root rank with a single collective.
+//  On the root rank, results.at(i) is the string from rank i; on the other ranks,
+//  results is left empty. Falls back to send/recv if the total exceeds the int
+//  displacements supported by MPI_Gatherv
+//
+inline void
+gather(const std::string& str, std::vector<std::string>& results, int root, comm_t comm)
+{
+#if defined(TIMEMORY_USE_MPI)
+    int _rank = rank(comm);
+    int _size = size(comm);
+
+    results.clear();
+
+    unsigned long long              _len = str.size();
+    std::vector<unsigned long long> _lens(_size, 0);
+    MPI_Allgather(&_len, 1, MPI_UNSIGNED_LONG_LONG, _lens.data(), 1,
+                  MPI_UNSIGNED_LONG_LONG, comm);
+
+    unsigned long long _total = 0;
+    for(const auto& itr : _lens)
+        _total += itr;
+
+    if(_total > static_cast<unsigned long long>(std::numeric_limits<int>::max()))
+    {
+        if(_rank != root)
+        {
+            send(str, root, 0, comm);
+            return;
+        }
+        results.resize(_size);
+        for(int i = 0; i < _size; ++i)
+        {
+            if(i == root)
+                results[i] = str;
+            else
+                recv(results[i], i, 0, comm);
+        }
+        return;
+    }
+
+    std::vector<int>  _counts(_size, 0);
+    std::vector<int>  _displs(_size, 0);
+    std::vector<char> _buffer((_rank == root) ? _total : 0);
+    for(int i = 0; i < _size; ++i)
+    {
+        _counts[i] = static_cast<int>(_lens[i]);
+        _displs[i] = (i == 0) ? 0 : (_displs[i - 1] + _counts[i - 1]);
+    }
+
+    MPI_Gatherv(const_cast<char*>(str.data()), static_cast<int>(_len), MPI_CHAR,
+                _buffer.data(), _counts.data(), _displs.data(), MPI_CHAR, root, comm);
+
+    if(_rank != root)
+        return;
+
+    results.resize(_size);
+    for(int i = 0; i < _size; ++i)
+        results[i].assign(_buffer.data() + _displs[i], _counts[i]);
+#else
+    consume_parameters(root, comm);
+    results = { str };
+#endif
+}
+
 //--------------------------------------------------------------------------------------//
 
 }  // namespace mpi
@@ -0,0 +1,452 @@
+// MIT License
+//
+// Copyright (c) 2020, The Regents of the University of California,
+// through Lawrence Berkeley National Laboratory (subject to receipt of any
+// required approvals from the U.S. Dept. of Energy).  All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+/** \file backends/perf_event.hpp
+ * \headerfile backends/perf_event.hpp "timemory/backends/perf_event.hpp"
+ * Provides hardware and software counters through the Linux perf_event_open system
+ * call. The counters of a thread are opened as one group so that all of them are
+ * read with a single read() and, when the kernel allows it, the hardware counters
+ * are read in user-space with rdpmc
+ *
+ */
+
+#pragma once
+
+#include "timemory/utility/macros.hpp"
+
+#include <cerrno>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#if defined(_LINUX)
+#    include <linux/perf_event.h>
+#    include <sys/ioctl.h>
+#    include <sys/mman.h>
+#    include <sys/syscall.h>
+#    include <unistd.h>
+#endif
+
+#if defined(_LINUX) && (defined(__x86_64__) || defined(__i386__))
+#    define TIMEMORY_RDPMC_AVAILABLE
+#endif
+
+//--------------------------------------------------------------------------------------//
+
+namespace tim
+{
+namespace perf_event
+{
+//--------------------------------------------------------------------------------------//
+//
+//  a counter which can be opened with perf_event_open
+//
+struct event_info
+{
+    bool        valid;
+    uint32_t    type;
+    uint64_t    config;
+    std::string symbol;
+    std::string description;
+};
+
+//--------------------------------------------------------------------------------------//
+
+#if defined(_LINUX)
+
+namespace impl
+{
+inline uint64_t
+cache_config(uint64_t _cache, uint64_t _op, uint64_t _result)
+{
+    return _cache | (_op << 8) | (_result << 16);
+}
+}  // namespace impl
+
+//--------------------------------------------------------------------------------------//
+//
+//  the generic events which the kernel maps to the counters of the CPU. The symbols
+//  are the same as those of the perf tool
+//
+inline const std::vector<event_info>&
+get_event_table()
+{
+    using namespace impl;
+    static const uint32_t _hw    = PERF_TYPE_HARDWARE;
+    static const uint32_t _sw    = PERF_TYPE_SOFTWARE;
+    static const uint32_t _cache = PERF_TYPE_HW_CACHE;
+    static const uint64_t _read  = PERF_COUNT_HW_CACHE_OP_READ;
+    static const uint64_t _acc   = PERF_COUNT_HW_CACHE_RESULT_ACCESS;
+    static const uint64_t _miss  = PERF_COUNT_HW_CACHE_RESULT_MISS;
+
+    static const std::vector<event_info> _instance = {
+        { true, _hw, PERF_COUNT_HW_CPU_CYCLES, "cycles", "CPU cycles" },
+        { true, _hw, PERF_COUNT_HW_INSTRUCTIONS, "instructions",
+          "Instructions retired" },
+        { true, _hw, PERF_COUNT_HW_CACHE_REFERENCES, "cache-references",
+          "Last level cache accesses" },
+        { true, _hw, PERF_COUNT_HW_CACHE_MISSES, "cache-misses",
+          "Last level cache misses" },
+        { true, _hw, PERF_COUNT_HW_BRANCH_INSTRUCTIONS, "branches",
+          "Branch instructions retired" },
+        { true, _hw, PERF_COUNT_HW_BRANCH_MISSES, "branch-misses",
+          "Mispredicted branch instructions" },
+        { true, _hw, PERF_COUNT_HW_BUS_CYCLES, "bus-cycles", "Bus cycles" },
+        { true, _hw, PERF_COUNT_HW_STALLED_CYCLES_FRONTEND, "stalled-cycles-frontend",
+          "Stalled cycles during issue" },
+        { true, _hw, PERF_COUNT_HW_STALLED_CYCLES_BACKEND, "stalled-cycles-backend",
+          "Stalled cycles during retirement" },
+        { true, _hw, PERF_COUNT_HW_REF_CPU_CYCLES, "ref-cycles",
+          "CPU cycles at the reference frequency" },
+        { true, _cache, cache_config(PERF_COUNT_HW_CACHE_L1D, _read, _acc),
+          "L1-dcache-loads", "L1 data cache loads" },
+        { true, _cache, cache_config(PERF_COUNT_HW_CACHE_L1D, _read, _miss),
+          "L1-dcache-load-misses", "L1 data cache load misses" },
+        { true, _cache, cache_config(PERF_COUNT_HW_CACHE_L1I, _read, _miss),
+          "L1-icache-load-misses", "L1 instruction cache load misses" },
+        { true, _cache, cache_config(PERF_COUNT_HW_CACHE_LL, _read, _acc), "LLC-loads",
+          "Last level cache loads" },
+        { true, _cache, cache_config(PERF_COUNT_HW_CACHE_LL, _read, _miss),
+          "LLC-load-misses", "Last level cache load misses" },
+        { true, _cache, cache_config(PERF_COUNT_HW_CACHE_DTLB, _read, _miss),
+          "dTLB-load-misses", "Data TLB load misses" },
+        { true, _cache, cache_config(PERF_COUNT_HW_CACHE_ITLB, _read, _miss),
+          "iTLB-load-misses", "Instruction TLB load misses" },
+        { true, _sw, PERF_COUNT_SW_CPU_CLOCK, "cpu-clock", "CPU clock (nsec)" },
+        { true, _sw, PERF_COUNT_SW_TASK_CLOCK, "task-clock", "Task clock (nsec)" },
+        { true, _sw, PERF_COUNT_SW_PAGE_FAULTS, "page-faults", "Page faults" },
+        { true, _sw, PERF_COUNT_SW_PAGE_FAULTS_MIN, "minor-faults",
+          "Minor page faults" },
+        { true, _sw, PERF_COUNT_SW_PAGE_FAULTS_MAJ, "major-faults",
+          "Major page faults" },
+        { true, _sw, PERF_COUNT_SW_CONTEXT_SWITCHES, "context-switches",
+          "Context switches" },
+        { true, _sw, PERF_COUNT_SW_CPU_MIGRATIONS, "cpu-migrations",
+          "Migrations to another CPU" },
+        { true, _sw, PERF_COUNT_SW_ALIGNMENT_FAULTS, "alignment-faults",
+          "Alignment faults" },
+        { true, _sw, PERF_COUNT_SW_EMULATION_FAULTS, "emulation-faults",
+          "Emulation faults" },
+    };
+    return _instance;
+}
+
+//--------------------------------------------------------------------------------------//
+//
+//  a symbol of the event table or a raw event of the CPU, e.g. "r01c2"
+//
+inline event_info
+get_event_info(const std::string& _symbol)
+{
+    for(const auto& itr : get_event_table())
+    {
+        if(itr.symbol == _symbol)
+            return itr;
+    }
+
+    if(_symbol.length() > 1 && _symbol[0] == 'r')
+    {
+        char* _end   = nullptr;
+        auto  _value = strtoull(_symbol.c_str() + 1, &_end, 16);
+        if(_end && *_end == '\0')
+            return event_info{ true, PERF_TYPE_RAW, _value, _symbol, "Raw CPU event" };
+    }
+
+    return event_info{ false, 0, 0, _symbol, "" };
+}
+
+//--------------------------------------------------------------------------------------//
+//
+//  a group of counters for the calling thread. The first counter which could be
+//  opened is the group leader. Counters which could not be opened read as zero so
+//  the position of each value matches the requested events
+//
+class group
+{
+public:
+    group()  = default;
+    ~group() { close(); }
+
+    group(const group&) = delete;
+    group& operator=(const group&) = delete;
+
+    //----------------------------------------------------------------------------------//
+    /// open and enable the counters. With _rdpmc the first page of each hardware
+    /// counter is mapped so that it can be read without a system call. Returns false
+    /// if no counters could be opened, _errors lists the events which failed
+    bool open(const std::vector<event_info>& _events, bool _rdpmc,
+              std::vector<std::string>* _errors = nullptr)
+    {
+        close();
+        auto _n = _events.size();
+        m_index.assign(_n, -1);
+        m_fds.reserve(_n);
+        m_pages.reserve(_n);
+
+        for(size_t i = 0; i < _n; ++i)
+        {
+            const auto& _evt = _events[i];
+            int         _fd  = -1;
+            if(_evt.valid)
+            {
+                struct perf_event_attr _attr;
+                memset(&_attr, 0, sizeof(_attr));
+                _attr.size           = sizeof(_attr);
+                _attr.type           = _evt.type;
+                _attr.config         = _evt.config;
+                _attr.disabled       = (m_fds.empty()) ? 1 : 0;
+                _attr.exclude_kernel = 1;
+                _attr.exclude_hv     = 1;
+                _attr.read_format    = PERF_FORMAT_GROUP |
+                                    PERF_FORMAT_TOTAL_TIME_ENABLED |
+                                    PERF_FORMAT_TOTAL_TIME_RUNNING;
+                auto _leader = (m_fds.empty()) ? -1 : m_fds.front();
+                _fd = static_cast<int>(
+                    syscall(__NR_perf_event_open, &_attr, 0, -1, _leader, 0));
+            }
+
+            if(_fd < 0)
+            {
+                if(_errors)
+                {
+                    std::string _why = (_evt.valid) ? strerror(errno) : "unknown event";
+                    _errors->push_back(_evt.symbol + " (" + _why + ")");
+                }
+                continue;
+            }
+
+            m_index[i] = static_cast<int>(m_fds.size());
+            m_fds.push_back(_fd);
+            m_pages.push_back(nullptr);
+#if defined(TIMEMORY_RDPMC_AVAILABLE)
+            if(_rdpmc && _evt.type != PERF_TYPE_SOFTWARE)
+            {
+                auto _page = ::mmap(nullptr, sysconf(_SC_PAGESIZE), PROT_READ,
+                                    MAP_SHARED, _fd, 0);
+                if(_page != MAP_FAILED)
+                    m_pages.back() = static_cast<perf_event_mmap_page*>(_page);
+            }
+#else
+            consume_parameters(_rdpmc);
+#endif
+        }
+
+        if(m_fds.empty())
+            return false;
+
+        // the user-space reads require that every counter in the group is mapped
+        m_rdpmc = true;
+        for(const auto& itr : m_pages)
+            m_rdpmc = m_rdpmc && (itr != nullptr);
+
+        m_buffer.assign(3 + m_fds.size(), 0);
+        m_values.assign(m_fds.size(), 0);
+        ioctl(m_fds.front(), PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+        ioctl(m_fds.front(), PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+        return true;
+    }
+
+    //----------------------------------------------------------------------------------//
+    /// disable and close the counters
+    void close()
+    {
+        if(!m_fds.empty())
+            ioctl(m_fds.front(), PERF_EVENT_IOC_DISABLE, PERF_IOC_FLAG_GROUP);
+        for(auto& itr : m_pages)
+        {
+            if(itr)
+                ::munmap(itr, sysconf(_SC_PAGESIZE));
+        }
+        // the leader is closed last
+        for(size_t i = m_fds.size(); i > 0; --i)
+            ::close(m_fds[i - 1]);
+        m_fds.clear();
+        m_pages.clear();
+        m_index.clear();
+        m_rdpmc = false;
+    }
+
+    bool   is_open() const { return !m_fds.empty(); }
+    bool   uses_rdpmc() const { return m_rdpmc; }
+    size_t size() const { return m_index.size(); }
+
+    //----------------------------------------------------------------------------------//
+    /// read the values of all the requested events into _values. The values are scaled
+    /// by the fraction of the time the group was scheduled when the counters are
+    /// multiplexed. Does not allocate
+    template <typename _Tp>
+    bool read(_Tp* _values)
+    {
+        if(m_fds.empty())
+            return false;
+
+        if(!(m_rdpmc && read_user()) && !read_group())
+            return false;
+
+        for(size_t i = 0; i < m_index.size(); ++i)
+        {
+            auto _idx  = m_index[i];
+            _values[i] = (_idx < 0) ? _Tp(0) : static_cast<_Tp>(m_values[_idx]);
+        }
+        return true;
+    }
+
+private:
+    //----------------------------------------------------------------------------------//
+    //  one read() of the leader returns { nr, time_enabled, time_running, values[nr] }
+    //
+    bool read_group()
+    {
+        auto _bytes = m_buffer.size() * sizeof(uint64_t);
+        if(::read(m_fds.front(), m_buffer.data(), _bytes) != static_cast<ssize_t>(_bytes))
+            return false;
+
+        auto _enabled = m_buffer[1];
+        auto _running = m_buffer[2];
+        for(size_t i = 0; i < m_values.size(); ++i)
+        {
+            auto _value = m_buffer[3 + i];
+            if(_running == 0)
+                _value = 0;
+            else if(_running < _enabled)
+                _value = static_cast<uint64_t>(static_cast<double>(_value) *
+                                               _enabled / _running);
+            m_values[i] = _value;
+        }
+        return true;
+    }
+
+    //----------------------------------------------------------------------------------//
+    //  reads the counters with rdpmc. The kernel publishes the offset and the index of
+    //  the hardware counter in the mapped page, which is re-read if the kernel updated
+    //  it while it was being read. Returns false if a counter is not on the CPU right
+    //  now or the group has been multiplexed, in which case read() is used instead
+    //
+    bool read_user()
+    {
+#if defined(TIMEMORY_RDPMC_AVAILABLE)
+        for(size_t i = 0; i < m_pages.size(); ++i)
+        {
+            volatile perf_event_mmap_page* _page = m_pages[i];
+            uint32_t                       _seq  = 0;
+            uint32_t                       _idx  = 0;
+            uint64_t                       _val  = 0;
+            uint64_t                       _ena  = 0;
+            uint64_t                       _run  = 0;
+            do
+            {
+                _seq = _page->lock;
+                asm volatile("" ::: "memory");
+                _ena = _page->time_enabled;
+                _run = _page->time_running;
+                _idx = _page->index;
+                _val = _page->offset;
+                if(_page->cap_user_rdpmc && _idx != 0)
+                {
+                    auto    _width = _page->pmc_width;
+                    int64_t _pmc   = static_cast<int64_t>(rdpmc(_idx - 1));
+                    // sign-extend the counter from its width
+                    _pmc <<= (64 - _width);
+                    _pmc >>= (64 - _width);
+                    _val += _pmc;
+                }
+                asm volatile("" ::: "memory");
+            } while(_page->lock != _seq);
+
+            if(_idx == 0 || _ena != _run)
+            {
+                m_rdpmc = (_ena == _run);
+                return false;
+            }
+            m_values[i] = _val;
+        }
+        return true;
+#else
+        return false;
+#endif
+    }
+
+#if defined(TIMEMORY_RDPMC_AVAILABLE)
+    static uint64_t rdpmc(uint32_t _counter)
+    {
+        uint32_t _lo = 0;
+        uint32_t _hi = 0;
+        asm volatile("rdpmc" : "=a"(_lo), "=d"(_hi) : "c"(_counter));
+        return (static_cast<uint64_t>(_hi) << 32) | _lo;
+    }
+#endif
+
+private:
+    bool                               m_rdpmc  = false;
+    std::vector<int>                   m_index  = {};
+    std::vector<int>                   m_fds    = {};
+    std::vector<perf_event_mmap_page*> m_pages  = {};
+    std::vector<uint64_t>              m_buffer = {};
+    std::vector<uint64_t>              m_values = {};
+};
+
+#else
+
+//--------------------------------------------------------------------------------------//
+
+inline const std::vector<event_info>&
+get_event_table()
+{
+    static const std::vector<event_info> _instance = {};
+    return _instance;
+}
+
+inline event_info
+get_event_info(const std::string& _symbol)
+{
+    return event_info{ false, 0, 0, _symbol, "" };
+}
+
+class group
+{
+public:
+    bool open(const std::vector<event_info>&, bool,
+              std::vector<std::string>* = nullptr)
+    {
+        return false;
+    }
+    void   close() {}
+    bool   is_open() const { return false; }
+    bool   uses_rdpmc() const { return false; }
+    size_t size() const { return 0; }
+    template <typename _Tp>
+    bool read(_Tp*)
+    {
+        return false;
+    }
+};
+
+#endif
+
+//--------------------------------------------------------------------------------------//
+
+}  // namespace perf_event
+}  // namespace tim
@@ -33,10 +33,12 @@
 
 #include <algorithm>
 #include <cstdint>
+#include <cstring>
 #include <fstream>
 #include <iomanip>
 #include <ios>
 #include <iostream>
+#include <sstream>
 #include <stdio.h>
 #include <string>
 
@@ -45,6 +47,7 @@
 //======================================================================================//
 
 #if defined(_UNIX)
+#    include <fcntl.h>
 #    include <sys/resource.h>
 #    include <unistd.h>
 #    if defined(_MACOS)
@@ -126,6 +129,64 @@ get_bytes_written();
 int64_t
 get_virt_mem();
 
+//--------------------------------------------------------------------------------------//
+/// the number of getrusage calls and /proc/<pid> reads made on this thread
+int64_t&
+get_rusage_syscalls();
+
+//--------------------------------------------------------------------------------------//
+/// \class rusage_snapshot
+/// \brief While an instance is alive on a thread, the first call to a get_* function
+/// above that needs getrusage, /proc/<pid>/statm, or /proc/<pid>/io performs the
+/// read and the subsequent calls on the thread re-use the values. The bundles
+/// create one around the start and stop of their components so that every
+/// rusage-derived component shares a single read. Nested instances are no-ops.
+///
+class rusage_snapshot
+{
+public:
+    rusage_snapshot();
+    ~rusage_snapshot();
+
+    rusage_snapshot(const rusage_snapshot&) = delete;
+    rusage_snapshot(rusage_snapshot&&)      = delete;
+    rusage_snapshot& operator=(const rusage_snapshot&) = delete;
+    rusage_snapshot& operator=(rusage_snapshot&&) = delete;
+
+    struct state
+    {
+        bool active    = false;
+        bool has_usage = false;
+        bool has_statm = false;
+        bool has_io    = false;
+#if defined(_UNIX)
+        struct rusage usage;
+#endif
+        /// size, resident, shared, text, lib, data, dt (in pages)
+        int64_t statm[7] = { 0, 0, 0, 0, 0, 0, 0 };
+        /// read_bytes, write_bytes
+        int64_t io[2] = { 0, 0 };
+    };
+
+    static state& get_state();
+    static bool   is_active() { return get_state().active; }
+
+private:
+    bool m_owner = false;
+};
+
+//--------------------------------------------------------------------------------------//
+/// a rusage_snapshot when _Enabled is true, otherwise does nothing. Used by the bundles
+/// which only need a snapshot when they contain a rusage-derived component
+///
+template <bool _Enabled>
+struct conditional_rusage_snapshot : rusage_snapshot
+{};
+
+template <>
+struct conditional_rusage_snapshot<false>
+{};
+
 //--------------------------------------------------------------------------------------//
 
 }  // namespace tim
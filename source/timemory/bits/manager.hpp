@@ -317,7 +317,8 @@ manager::write_metadata(const char* context)
                 oa.setNextName("output");
                 oa.startNode();
                 oa(cereal::make_nvp("text", m_text_files),
-                   cereal::make_nvp("json", m_json_files));
+                   cereal::make_nvp("json", m_json_files),
+                   cereal::make_nvp("binary", m_binary_files));
                 oa.finishNode();
             }
             auto _env = env_settings::instance()->get();
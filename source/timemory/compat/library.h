@@ -85,6 +85,7 @@ extern "C"
                                                 const char*);
 
     extern uint64_t timemory_get_unique_id(void);
+    // the id is a handle to a toolset owned by the calling thread
     extern void timemory_create_record(const char* name, uint64_t* id, int n, int* ct);
     extern void timemory_delete_record(uint64_t nid);
     extern void timemory_init_library(int argc, char** argv);
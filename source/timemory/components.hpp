@@ -83,6 +83,11 @@
 #    include "timemory/components/roofline/cpu.hpp"
 #endif
 
+// CPU hardware counters without PAPI
+#if defined(_LINUX)
+#    include "timemory/components/perf_event/array.hpp"
+#endif
+
 // TAU component
 #if defined(TIMEMORY_USE_TAU)
 #    include "timemory/components/tau.hpp"
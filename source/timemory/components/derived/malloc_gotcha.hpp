@@ -29,14 +29,31 @@
 #include "timemory/components/types.hpp"
 #include "timemory/mpl/apply.hpp"
 #include "timemory/settings.hpp"
+#include "timemory/utility/environment.hpp"
+#include "timemory/utility/pointer_table.hpp"
 
 #if defined(TIMEMORY_USE_CUDA)
 #    include "timemory/backends/cuda.hpp"
 #endif
 
+#include <array>
+#include <atomic>
 #include <cstdint>
+#include <deque>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+#include <map>
+#include <mutex>
+#include <new>
+#include <ostream>
+#include <sstream>
 #include <string>
 #include <tuple>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+#include <vector>
 
 namespace tim
 {
@@ -64,6 +81,21 @@ struct supports_args<component::malloc_gotcha, std::tuple<std::string, void*>>
 : std::true_type
 {};
 
+template <>
+struct supports_args<component::malloc_gotcha,
+                     std::tuple<component::gotcha_index, size_t>> : std::true_type
+{};
+
+template <>
+struct supports_args<component::malloc_gotcha,
+                     std::tuple<component::gotcha_index, size_t, size_t>> : std::true_type
+{};
+
+template <>
+struct supports_args<component::malloc_gotcha,
+                     std::tuple<component::gotcha_index, void*>> : std::true_type
+{};
+
 #if defined(TIMEMORY_USE_CUDA)
 template <>
 struct supports_args<component::malloc_gotcha, std::tuple<std::string, void**, size_t>>
@@ -102,12 +134,26 @@ struct malloc_gotcha : base<malloc_gotcha, double>
     static constexpr uintmax_t num_alloc = 2;
 #endif
 
+    /// position of each function in the hash array
+    enum function_index : uintmax_t
+    {
+        malloc_idx = 0,
+        calloc_idx = 1,
+#if defined(TIMEMORY_USE_CUDA)
+        cuda_malloc_idx = 2,
+        free_idx        = 3,
+        cuda_free_idx   = 4,
+#else
+        free_idx = 2,
+#endif
+        unknown_idx = std::numeric_limits<uintmax_t>::max()
+    };
+
     // clang-format off
     using value_type   = double;
     using this_type    = malloc_gotcha;
     using base_type    = base<this_type, value_type>;
     using storage_type = typename base_type::storage_type;
-    using string_hash  = std::hash<std::string>;
     // clang-format on
 
     // formatting
@@ -182,26 +228,133 @@ public:
 
     //----------------------------------------------------------------------------------//
 
-    static void global_finalize(storage_type*) {}
+    static void global_finalize(storage_type*)
+    {
+        if(attribution())
+            report_allocation_sites(std::cout);
+    }
 
     //----------------------------------------------------------------------------------//
 
     static uintmax_t get_index(uintmax_t _hash)
     {
-        uintmax_t idx = std::numeric_limits<uintmax_t>::max();
         for(uintmax_t i = 0; i < get_hash_array().size(); ++i)
         {
             if(_hash == get_hash_array()[i])
-                idx = i;
+                return i;
         }
-        return idx;
+        return unknown_idx;
+    }
+
+    //----------------------------------------------------------------------------------//
+    //  the position in the hash array is cached per GOTCHA wrapper index. The hash is
+    //  stored alongside because several gotcha types may use this component with a
+    //  different ordering of the functions
+    //
+    static uintmax_t get_index(const gotcha_index& _data)
+    {
+        if(_data.index >= data_size)
+            return get_index(_data.hash);
+
+        auto& _entry = get_index_cache()[_data.index];
+        if(_entry.first != _data.hash || _entry.second == 0)
+            _entry = { _data.hash, get_index(_data.hash) + 1 };
+        return _entry.second - 1;
+    }
+
+    //----------------------------------------------------------------------------------//
+    /// the number of allocations which have not been freed
+    static size_t get_allocation_count() { return get_allocation_table().size(); }
+
+    //----------------------------------------------------------------------------------//
+    //  allocation attribution: when enabled, every tracked pointer is tagged with the
+    //  call-graph node which allocated it and the free is credited back to that node,
+    //  regardless of the thread that frees it. The node is the parent of the
+    //  malloc/calloc entry in the call-graph of this component so including
+    //  malloc_gotcha in the bundles of the regions attributes the allocations to the
+    //  regions
+    //
+    /// allocation statistics of a call-graph node on one thread
+    struct allocation_site
+    {
+        explicit allocation_site(const std::string& _path)
+        : path(_path)
+        {}
+
+        std::atomic<int64_t> live_bytes{ 0 };   /// bytes not yet freed
+        std::atomic<int64_t> live_count{ 0 };   /// allocations not yet freed
+        std::atomic<int64_t> peak_bytes{ 0 };   /// high-water mark of live_bytes
+        std::atomic<int64_t> total_bytes{ 0 };  /// bytes allocated
+        std::atomic<int64_t> total_count{ 0 };  /// number of allocations
+        const std::string    path;              /// the call-graph path of the node
+    };
+
+    /// statistics of a call-graph path summed over all the threads
+    struct allocation_record
+    {
+        std::string path        = "";
+        int64_t     live_bytes  = 0;
+        int64_t     live_count  = 0;
+        int64_t     peak_bytes  = 0;
+        int64_t     total_bytes = 0;
+        int64_t     total_count = 0;
+    };
+
+    /// enable the allocation attribution (default: TIMEMORY_MALLOC_GOTCHA_ATTRIBUTION)
+    static bool& attribution()
+    {
+        static bool _instance = get_env<bool>("TIMEMORY_MALLOC_GOTCHA_ATTRIBUTION", false);
+        return _instance;
+    }
+
+    /// the allocation statistics of every call-graph path, sorted by the path
+    static std::vector<allocation_record> get_allocation_sites()
+    {
+        std::map<std::string, allocation_record> _records;
+        {
+            std::lock_guard<std::mutex> _lk(get_site_mutex());
+            for(auto& itr : get_sites())
+            {
+                auto& _rec = _records[itr.path];
+                _rec.path  = itr.path;
+                _rec.live_bytes += itr.live_bytes.load(std::memory_order_relaxed);
+                _rec.live_count += itr.live_count.load(std::memory_order_relaxed);
+                _rec.peak_bytes += itr.peak_bytes.load(std::memory_order_relaxed);
+                _rec.total_bytes += itr.total_bytes.load(std::memory_order_relaxed);
+                _rec.total_count += itr.total_count.load(std::memory_order_relaxed);
+            }
+        }
+
+        std::vector<allocation_record> _ret;
+        for(auto& itr : _records)
+            _ret.push_back(itr.second);
+        return _ret;
+    }
+
+    /// print the call-graph paths with outstanding allocations
+    static void report_allocation_sites(std::ostream& os)
+    {
+        std::stringstream ss;
+        for(auto& itr : get_allocation_sites())
+        {
+            if(itr.live_count == 0)
+                continue;
+            ss << "    " << std::setw(14) << itr.live_bytes << " bytes in "
+               << std::setw(8) << itr.live_count << " allocations (peak: "
+               << std::setw(14) << itr.peak_bytes << " bytes, total: " << std::setw(8)
+               << itr.total_count << " allocations) : " << itr.path << "\n";
+        }
+        if(ss.str().empty())
+            return;
+        os << "[" << this_type::label() << "]> outstanding allocations:\n"
+           << ss.str() << std::flush;
     }
 
 public:
     //----------------------------------------------------------------------------------//
 
     malloc_gotcha(const std::string& _prefix = "")
-    : prefix_hash(string_hash()(_prefix))
+    : prefix_hash(get_hash(_prefix))
     , prefix_idx(get_index(prefix_hash))
     , prefix(_prefix)
     {
@@ -243,20 +396,14 @@ public:
 
     //----------------------------------------------------------------------------------//
 
-    void audit(const std::string& fname, size_t nbytes)
+    //  the GOTCHA wrappers pass the index with the precomputed hash of the label
+    //
+    void audit(const gotcha_index& _data, size_t nbytes)
     {
-        auto _hash = string_hash()(fname);
-        auto idx   = get_index(_hash);
-
-        if(idx > get_hash_array().size())
-        {
-            if(settings::verbose() > 1 || settings::debug())
-                printf("[%s]> unknown function: '%s'\n", this_type::label().c_str(),
-                       fname.c_str());
+        if(!is_known(_data, get_index(_data)))
             return;
-        }
 
-        if(_hash == prefix_hash)
+        if(_data.hash == prefix_hash)
         {
             // malloc
             value = (nbytes);
@@ -266,27 +413,19 @@ public:
         {
             if(settings::verbose() > 1 || settings::debug())
                 printf("[%s]> skipped function '%s with hash %llu'\n",
-                       this_type::label().c_str(), fname.c_str(),
-                       (long long unsigned) _hash);
+                       this_type::label().c_str(), _data.label->c_str(),
+                       (long long unsigned) _data.hash);
         }
     }
 
     //----------------------------------------------------------------------------------//
 
-    void audit(const std::string& fname, size_t nmemb, size_t size)
+    void audit(const gotcha_index& _data, size_t nmemb, size_t size)
     {
-        auto _hash = string_hash()(fname);
-        auto idx   = get_index(_hash);
-
-        if(idx > get_hash_array().size())
-        {
-            if(settings::verbose() > 1 || settings::debug())
-                printf("[%s]> unknown function: '%s'\n", this_type::label().c_str(),
-                       fname.c_str());
+        if(!is_known(_data, get_index(_data)))
             return;
-        }
 
-        if(_hash == prefix_hash)
+        if(_data.hash == prefix_hash)
         {
             // calloc
             value = (nmemb * size);
@@ -296,69 +435,80 @@ public:
         {
             if(settings::verbose() > 1 || settings::debug())
                 printf("[%s]> skipped function '%s with hash %llu'\n",
-                       this_type::label().c_str(), fname.c_str(),
-                       (long long unsigned) _hash);
+                       this_type::label().c_str(), _data.label->c_str(),
+                       (long long unsigned) _data.hash);
         }
     }
 
     //----------------------------------------------------------------------------------//
 
-    void audit(const std::string& fname, void* ptr)
+    void audit(const gotcha_index& _data, void* ptr)
     {
-        if(!ptr)
+        auto _idx = get_index(_data);
+        if(!ptr || !is_known(_data, _idx))
             return;
-        auto _hash = string_hash()(fname);
-        auto idx   = get_index(_hash);
 
-        if(idx > get_hash_array().size())
+        switch(_idx)
         {
-            if(settings::verbose() > 1 || settings::debug())
-                printf("[%s]> unknown function: '%s'\n", this_type::label().c_str(),
-                       fname.c_str());
-            return;
-        }
-
-        // malloc
-        if(idx < num_alloc)
-            get_allocation_map()[ptr] = value;
-        else
-        {
-            auto itr = get_allocation_map().find(ptr);
-            if(itr != get_allocation_map().end())
+            case malloc_idx:
+            case calloc_idx:
             {
-                value = itr->second;
-                accum += itr->second;
-                get_allocation_map().erase(itr);
+                allocation_t _alloc{ static_cast<size_t>(value), nullptr };
+                if(attribution())
+                    _alloc.site = get_allocation_site();
+                if(_alloc.site)
+                    allocated(_alloc);
+                get_allocation_table().insert(ptr, _alloc);
+                break;
             }
-            else
+            case free_idx:
             {
-                if(settings::verbose() > 1 || settings::debug())
+                allocation_t _alloc{ 0, nullptr };
+                if(get_allocation_table().erase(ptr, _alloc))
+                {
+                    value = _alloc.bytes;
+                    accum += _alloc.bytes;
+                    if(_alloc.site)
+                        deallocated(_alloc);
+                }
+                else if(settings::verbose() > 1 || settings::debug())
+                {
                     printf("[%s]> free of unknown pointer size: %p\n",
                            this_type::label().c_str(), ptr);
+                }
+                break;
             }
+            default: break;
         }
     }
 
     //----------------------------------------------------------------------------------//
+    //  the function name is hashed when called directly
+    //
+    void audit(const std::string& fname, size_t nbytes)
+    {
+        audit(make_index(fname), nbytes);
+    }
+
+    void audit(const std::string& fname, size_t nmemb, size_t size)
+    {
+        audit(make_index(fname), nmemb, size);
+    }
+
+    void audit(const std::string& fname, void* ptr) { audit(make_index(fname), ptr); }
+
+    //----------------------------------------------------------------------------------//
 
 #if defined(TIMEMORY_USE_CUDA)
 
     //----------------------------------------------------------------------------------//
 
-    void audit(const std::string& fname, void** devPtr, size_t size)
+    void audit(const gotcha_index& _data, void** devPtr, size_t size)
     {
-        auto _hash = string_hash()(fname);
-        auto idx   = get_index(_hash);
-
-        if(idx > get_hash_array().size())
-        {
-            if(settings::verbose() > 1 || settings::debug())
-                printf("[%s]> unknown function: '%s'\n", this_type::label().c_str(),
-                       fname.c_str());
+        if(!is_known(_data, get_index(_data)))
             return;
-        }
 
-        if(_hash == prefix_hash)
+        if(_data.hash == prefix_hash)
         {
             // malloc
             value = (size);
@@ -369,36 +519,30 @@ public:
         {
             if(settings::verbose() > 1 || settings::debug())
                 printf("[%s]> skipped function '%s with hash %llu'\n",
-                       this_type::label().c_str(), fname.c_str(),
-                       (long long unsigned) _hash);
+                       this_type::label().c_str(), _data.label->c_str(),
+                       (long long unsigned) _data.hash);
         }
     }
 
     //----------------------------------------------------------------------------------//
 
-    void audit(const std::string& fname, cuda::error_t)
+    void audit(const gotcha_index& _data, cuda::error_t)
     {
-        auto _hash = string_hash()(fname);
-        auto idx   = get_index(_hash);
-
-        if(idx > get_hash_array().size())
-        {
-            if(settings::verbose() > 1 || settings::debug())
-                printf("[%s]> unknown function: '%s'\n", this_type::label().c_str(),
-                       fname.c_str());
+        auto idx = get_index(_data);
+        if(!is_known(_data, idx))
             return;
-        }
 
-        if(_hash == prefix_hash && idx < num_alloc)
+        if(_data.hash == prefix_hash && idx < num_alloc)
         {
             // cudaMalloc
             if(m_last_addr)
             {
-                void* ptr                 = (void*) ((char**) (m_last_addr)[0]);
-                get_allocation_map()[ptr] = value;
+                void* ptr = (void*) ((char**) (m_last_addr)[0]);
+                get_allocation_table().insert(
+                    ptr, allocation_t{ static_cast<size_t>(value), nullptr });
             }
         }
-        else if(_hash == prefix_hash && idx >= num_alloc)
+        else if(_data.hash == prefix_hash && idx >= num_alloc)
         {
             // cudaFree
         }
@@ -406,13 +550,25 @@ public:
         {
             if(settings::verbose() > 1 || settings::debug())
                 printf("[%s]> skipped function '%s with hash %llu'\n",
-                       this_type::label().c_str(), fname.c_str(),
-                       (long long unsigned) _hash);
+                       this_type::label().c_str(), _data.label->c_str(),
+                       (long long unsigned) _data.hash);
         }
     }
 
     //----------------------------------------------------------------------------------//
 
+    void audit(const std::string& fname, void** devPtr, size_t size)
+    {
+        audit(make_index(fname), devPtr, size);
+    }
+
+    void audit(const std::string& fname, cuda::error_t err)
+    {
+        audit(make_index(fname), err);
+    }
+
+    //----------------------------------------------------------------------------------//
+
 #endif
 
     //----------------------------------------------------------------------------------//
@@ -420,12 +576,8 @@ public:
     void set_prefix(const std::string& _prefix)
     {
         prefix      = _prefix;
-        prefix_hash = add_hash_id(prefix);
-        for(uintmax_t i = 0; i < get_hash_array().size(); ++i)
-        {
-            if(prefix_hash == get_hash_array()[i])
-                prefix_idx = i;
-        }
+        prefix_hash = get_hash(prefix);
+        prefix_idx  = get_index(prefix_hash);
     }
 
     //----------------------------------------------------------------------------------//
@@ -451,16 +603,128 @@ public:
     }
 
 private:
-    using alloc_map_t  = std::unordered_map<void*, size_t>;
-    using vaddr_map_t  = std::unordered_map<void**, size_t>;
-    using hash_array_t = std::array<uintmax_t, data_size>;
+    /// the value of the allocation table
+    struct allocation_t
+    {
+        size_t           bytes;
+        allocation_site* site;
+    };
+
+    using alloc_table_t = pointer_table<allocation_t>;
+    using site_cache_t =
+        std::unordered_map<const void*, std::pair<uint64_t, allocation_site*>>;
+    using vaddr_map_t   = std::unordered_map<void**, size_t>;
+    using hash_array_t  = std::array<uintmax_t, data_size>;
+    using index_cache_t = std::array<std::pair<uintmax_t, uintmax_t>, data_size>;
+
+    //  shared by all threads so that a pointer freed on a different thread than the one
+    //  which allocated it is found. The table is constructed in static storage and
+    //  never destroyed: frees during process teardown must remain valid and the
+    //  construction must not call the wrapped malloc
+    static alloc_table_t& get_allocation_table()
+    {
+        using buffer_t = typename std::aligned_storage<sizeof(alloc_table_t),
+                                                       alignof(alloc_table_t)>::type;
+        static buffer_t       _buffer;
+        static alloc_table_t* _instance = new(&_buffer) alloc_table_t{};
+        return *_instance;
+    }
 
-    static alloc_map_t& get_allocation_map()
+    static index_cache_t& get_index_cache()
     {
-        static thread_local alloc_map_t _instance;
+        static thread_local index_cache_t _instance = {};
         return _instance;
     }
 
+    //  the sites are never removed so the pointers in the allocation table and the
+    //  thread-local caches remain valid
+    static std::deque<allocation_site>& get_sites()
+    {
+        static std::deque<allocation_site> _instance;
+        return _instance;
+    }
+
+    static std::mutex& get_site_mutex()
+    {
+        static std::mutex _instance;
+        return _instance;
+    }
+
+    //  maps the address of a call-graph node on this thread to its site. The id of
+    //  the node is stored to detect a node address re-used after the graph is reset
+    static site_cache_t& get_site_cache()
+    {
+        static thread_local site_cache_t _instance;
+        return _instance;
+    }
+
+    //----------------------------------------------------------------------------------//
+    //  the site of the node which called malloc. Only the first allocation from a node
+    //  on a thread acquires a lock
+    //
+    allocation_site* get_allocation_site() const
+    {
+        if(!graph_itr)
+            return nullptr;
+
+        auto* _node = (graph_itr.node->parent) ? graph_itr.node->parent : graph_itr.node;
+        auto  _id   = _node->data.id();
+
+        // the last node is checked first since allocations are typically repeated
+        static thread_local const void*      _last_node = nullptr;
+        static thread_local uint64_t         _last_id   = 0;
+        static thread_local allocation_site* _last_site = nullptr;
+        if(_node == _last_node && _id == _last_id)
+            return _last_site;
+
+        auto& _cache = get_site_cache();
+        auto  itr    = _cache.find(_node);
+        if(itr == _cache.end() || itr->second.first != _id)
+        {
+            // build the path from the root to the node
+            std::string _path = "";
+            for(auto* _itr = _node; _itr && _itr->data.depth() > 0; _itr = _itr->parent)
+                _path = (_path.empty()) ? _itr->data.get_prefix()
+                                        : (_itr->data.get_prefix() + "/" + _path);
+            if(_path.empty())
+                _path = "<root>";
+
+            std::lock_guard<std::mutex> _lk(get_site_mutex());
+            get_sites().emplace_back(_path);
+            _cache[_node] = { _id, &get_sites().back() };
+            itr           = _cache.find(_node);
+        }
+
+        _last_node = _node;
+        _last_id   = _id;
+        _last_site = itr->second.second;
+        return _last_site;
+    }
+
+    static void allocated(const allocation_t& _alloc)
+    {
+        auto  _nbytes = static_cast<int64_t>(_alloc.bytes);
+        auto* _site   = _alloc.site;
+        auto  _live = _site->live_bytes.fetch_add(_nbytes, std::memory_order_relaxed) +
+                     _nbytes;
+        _site->live_count.fetch_add(1, std::memory_order_relaxed);
+        _site->total_bytes.fetch_add(_nbytes, std::memory_order_relaxed);
+        _site->total_count.fetch_add(1, std::memory_order_relaxed);
+        auto _peak = _site->peak_bytes.load(std::memory_order_relaxed);
+        while(_live > _peak && !_site->peak_bytes.compare_exchange_weak(
+                                   _peak, _live, std::memory_order_relaxed))
+        {
+        }
+    }
+
+    static void deallocated(const allocation_t& _alloc)
+    {
+        auto  _nbytes = static_cast<int64_t>(_alloc.bytes);
+        auto* _site   = _alloc.site;
+        _site->live_bytes.fetch_sub(_nbytes, std::memory_order_relaxed);
+        _site->live_count.fetch_sub(1, std::memory_order_relaxed);
+    }
+
     static vaddr_map_t& get_void_address_map()
     {
         static thread_local vaddr_map_t _instance;
@@ -472,15 +736,12 @@ private:
         static auto _get = []() {
 #if defined(TIMEMORY_USE_CUDA)
             hash_array_t _instance = {
-                { string_hash()("malloc"),
-                  string_hash()("calloc"),
-                  string_hash()("cudaMalloc"),
-                  string_hash()("free"),
-                  string_hash()("cudaFree") }
+                { get_hash("malloc"), get_hash("calloc"), get_hash("cudaMalloc"),
+                  get_hash("free"), get_hash("cudaFree") }
             };
 #else
-            hash_array_t _instance = { { string_hash()("malloc"), string_hash()("calloc"),
-                                         string_hash()("free") } };
+            hash_array_t _instance = { { get_hash("malloc"), get_hash("calloc"),
+                                         get_hash("free") } };
 #endif
 
             return _instance;
@@ -490,8 +751,24 @@ private:
         return _instance;
     }
 
+    static gotcha_index make_index(const std::string& fname)
+    {
+        return gotcha_index{ std::numeric_limits<size_t>::max(), get_hash(fname),
+                             &fname };
+    }
+
+    static bool is_known(const gotcha_index& _data, uintmax_t _idx)
+    {
+        if(_idx < get_hash_array().size())
+            return true;
+        if(settings::verbose() > 1 || settings::debug())
+            printf("[%s]> unknown function: '%s'\n", this_type::label().c_str(),
+                   _data.label->c_str());
+        return false;
+    }
+
 private:
-    uintmax_t   prefix_hash = string_hash()("");
+    uintmax_t   prefix_hash = get_hash("");
     uintmax_t   prefix_idx  = std::numeric_limits<uintmax_t>::max();
     std::string prefix      = "";
 #if defined(TIMEMORY_USE_CUDA)
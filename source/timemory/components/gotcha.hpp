@@ -33,6 +33,8 @@
 #include "timemory/backends/gotcha.hpp"
 #include "timemory/components/base.hpp"
 #include "timemory/components/types.hpp"
+#include "timemory/general/hash.hpp"
+#include "timemory/general/source_location.hpp"
 #include "timemory/mpl/apply.hpp"
 #include "timemory/mpl/filters.hpp"
 #include "timemory/settings.hpp"
@@ -93,6 +95,43 @@ public:
         bool& m_value;
         bool  m_if_equal;
     };
+
+    /// increments a thread-local re-entrancy depth for the lifetime of the object
+    struct auto_depth
+    {
+        explicit auto_depth(int32_t& _value)
+        : m_value(_value)
+        {
+            ++m_value;
+        }
+
+        ~auto_depth() { --m_value; }
+
+        auto_depth(const auto_depth&) = delete;
+        auto_depth(auto_depth&&)      = delete;
+        auto_depth& operator=(const auto_depth&) = delete;
+        auto_depth& operator=(auto_depth&&) = delete;
+
+    private:
+        int32_t& m_value;
+    };
+};
+
+//======================================================================================//
+///
+/// \class component::gotcha_index
+/// \brief The identifier of the wrapper passed as the first argument to audit(...).
+/// The hash of the label is computed once when the wrapper is constructed so
+/// components can dispatch on integers. Converts to the label so components that
+/// implement audit(const std::string&, ...) are still supported
+///
+struct gotcha_index
+{
+    size_t             index;  /// index of the wrapper
+    hash_result_type   hash;   /// hash of the label
+    const std::string* label;  /// the label (tool_id)
+
+    operator const std::string&() const { return *label; }
 };
 
 //======================================================================================//
@@ -107,55 +146,6 @@ struct gotcha_invoker
     using value_type = typename Type::value_type;
     using base_type  = typename Type::base_type;
 
-    template <typename... _Args>
-    static _Ret invoke(_Tp& _obj, bool& _ready, _Ret (*_func)(_Args...), _Args&&... _args)
-    {
-        return invoke_sfinae(_obj, _ready, _func, std::forward<_Args>(_args)...);
-    }
-
-private:
-    //----------------------------------------------------------------------------------//
-    //  Call:
-    //
-    //      _Ret Type::operator()(_Args...)
-    //
-    //  instead of gotcha_wrappee
-    //
-    template <typename... _Args>
-    static auto invoke_sfinae_impl(_Tp& _obj, int, bool& _ready, _Ret (*)(_Args...),
-                                   _Args&&... _args)
-        -> decltype(_obj(std::forward<_Args>(_args)...), _Ret())
-    {
-        gotcha_suppression::auto_toggle suppress_lock(_ready);
-        return _obj(std::forward<_Args>(_args)...);
-    }
-
-    //----------------------------------------------------------------------------------//
-    //  Call the original gotcha_wrappee
-    //
-    template <typename... _Args>
-    static auto invoke_sfinae_impl(_Tp&, long, bool& _ready, _Ret (*_func)(_Args...),
-                                   _Args&&... _args)
-        -> decltype(_func(std::forward<_Args>(_args)...), _Ret())
-    {
-        gotcha_suppression::auto_toggle suppress_lock(_ready);
-        return _func(std::forward<_Args>(_args)...);
-    }
-
-    //----------------------------------------------------------------------------------//
-    //  Wrapper that calls one of two above
-    //
-    template <typename... _Args>
-    static auto invoke_sfinae(_Tp& _obj, bool& _ready, _Ret (*_func)(_Args...),
-                              _Args&&... _args)
-        -> decltype(invoke_sfinae_impl(_obj, 0, _ready, _func,
-                                       std::forward<_Args>(_args)...),
-                    _Ret())
-    {
-        return invoke_sfinae_impl(_obj, 0, _ready, _func, std::forward<_Args>(_args)...);
-    }
-
-    //==================================================================================//
 public:
     template <typename... _Args>
     static _Ret invoke(_Tp& _obj, _Ret (*_func)(_Args...), _Args&&... _args)
@@ -205,57 +195,6 @@ struct gotcha_invoker<_Tp, void>
     using value_type  = typename Type::value_type;
     using base_type   = typename Type::base_type;
 
-    template <typename... _Args>
-    static _Ret invoke(_Tp& _obj, bool& _ready, _Ret (*_func)(_Args...), _Args&&... _args)
-    {
-        invoke_sfinae(_obj, _ready, _func, std::forward<_Args>(_args)...);
-    }
-
-private:
-    //----------------------------------------------------------------------------------//
-    //  Call:
-    //
-    //      _Ret Type::operator()(_Args...)
-    //
-    //  instead of gotcha_wrappee
-    //
-    template <typename... _Args>
-    static auto invoke_sfinae_impl(_Tp& _obj, int, bool& _ready, _Ret (*)(_Args...),
-                                   _Args&&... _args)
-        -> decltype(_obj(std::forward<_Args>(_args)...), _Ret())
-    {
-        gotcha_suppression::auto_toggle suppress_lock(_ready);
-        _obj(std::forward<_Args>(_args)...);
-    }
-
-    //----------------------------------------------------------------------------------//
-    //  Call the original gotcha_wrappee
-    //
-    template <typename... _Args>
-    static auto invoke_sfinae_impl(_Tp&, long, bool& _ready, _Ret (*_func)(_Args...),
-                                   _Args&&... _args)
-        -> decltype(_func(std::forward<_Args>(_args)...), _Ret())
-    {
-        gotcha_suppression::auto_toggle suppress_lock(_ready);
-        _func(std::forward<_Args>(_args)...);
-    }
-
-    //----------------------------------------------------------------------------------//
-    //  Wrapper that calls one of two above
-    //
-    template <typename... _Args>
-    static auto invoke_sfinae(_Tp& _obj, bool& _ready, _Ret (*_func)(_Args...),
-                              _Args&&... _args)
-        -> decltype(invoke_sfinae_impl(_obj, 0, _ready, _func,
-                                       std::forward<_Args>(_args)...),
-                    _Ret())
-    {
-        invoke_sfinae_impl(_obj, 0, _ready, _func, std::forward<_Args>(_args)...);
-    }
-    //
-    //----------------------------------------------------------------------------------//
-
-    //==================================================================================//
 public:
     template <typename... _Args>
     static _Ret invoke(_Tp& _obj, _Ret (*_func)(_Args...), _Args&&... _args)
@@ -449,13 +388,13 @@ struct gotcha : public base<gotcha<_Nt, _Components, _Differentiator>, void>
             }
 
             // ensure the hash to string pairing is stored
-            storage_type::instance()->add_hash_id(_label);
+            _data.tool_hash = storage_type::instance()->add_hash_id(_label);
 
             _data.filled      = true;
             _data.priority    = _priority;
             _data.tool_id     = _label;
             _data.wrap_id     = _func;
-            _data.ready       = get_default_ready();
+            _data.ready.store(get_default_ready());
             _data.constructor = [=]() {
                 this_type::construct<_N, _Ret, _Args...>(_data.wrap_id);
             };
@@ -509,7 +448,7 @@ struct gotcha : public base<gotcha<_Nt, _Components, _Differentiator>, void>
             check_error<_N>(ret_wrap, "unwrap binding");
             */
 
-            _data.ready = get_default_ready();
+            _data.ready.store(get_default_ready());
         }
     }
 
@@ -592,9 +531,9 @@ struct gotcha : public base<gotcha<_Nt, _Components, _Differentiator>, void>
 
     static void thread_init(storage_type*)
     {
-        auto& _data = get_data();
-        for(size_type i = 0; i < _Nt; ++i)
-            _data[i].ready = (_data[i].filled && get_default_ready());
+        // the enable state is shared by all threads, only the re-entrancy depth is
+        // specific to the thread
+        get_thread_depth().fill(0);
     }
 
 public:
@@ -638,7 +577,7 @@ public:
         {
             auto& _data = get_data();
             for(size_type i = 0; i < _Nt; ++i)
-                _data[i].ready = _data[i].filled;
+                _data[i].ready.store(_data[i].filled);
         }
     }
 
@@ -658,21 +597,17 @@ public:
         }
 #endif
 
-        if(_t == 0)
-        {
-            auto& _data = get_data();
-            for(size_type i = 0; i < _Nt; ++i)
-                _data[i].ready = false;
-        }
-
+        // stopping on one thread does not disable the wrappers on the other threads
         if(_n == 0)
         {
             for(auto& itr : get_data())
             {
+                itr.ready.store(false);
                 if(!itr.is_finalized)
                     itr.destructor();
             }
         }
+        consume_parameters(_t);
     }
 
 public:
@@ -705,29 +640,26 @@ private:
     {
         gotcha_data() = default;
 
-        bool          ready        = get_default_ready();  /// ready to be used
-        bool          filled       = false;                /// structure is populated
-        bool          is_active    = false;                /// is currently wrapping
-        bool          is_finalized = false;                /// no more wrapping is allowed
-        int           priority     = 0;                    /// current priority
-        binding_t     binding      = binding_t{};          /// hold the binder set
-        wrappee_t     wrapper      = 0x0;      /// the func pointer doing wrapping
-        wrappee_t     wrappee      = 0x0;      /// the func pointer being wrapped
-        wrappid_t     wrap_id      = "";       /// the function name (possibly mangled)
-        wrappid_t     tool_id      = "";       /// the function name (unmangled)
-        constructor_t constructor  = []() {};  /// wrap the function
-        destructor_t  destructor   = []() {};  /// unwrap the function
+        atomic_bool_t    ready{ get_default_ready() };  /// ready to be used
+        bool             filled       = false;  /// structure is populated
+        bool             is_active    = false;  /// is currently wrapping
+        bool             is_finalized = false;  /// no more wrapping is allowed
+        int              priority     = 0;      /// current priority
+        binding_t        binding      = binding_t{};  /// hold the binder set
+        wrappee_t        wrapper      = 0x0;  /// the func pointer doing wrapping
+        wrappee_t        wrappee      = 0x0;  /// the func pointer being wrapped
+        wrappid_t        wrap_id      = "";   /// the function name (possibly mangled)
+        wrappid_t        tool_id      = "";   /// the function name (unmangled)
+        hash_result_type tool_hash    = 0;    /// the hash of tool_id
+        constructor_t    constructor  = []() {};  /// wrap the function
+        destructor_t     destructor   = []() {};  /// unwrap the function
     };
 
     //----------------------------------------------------------------------------------//
 
     static array_t<gotcha_data>& get_data()
     {
-        static auto _get = []() {
-            array_t<gotcha_data> _arr;
-            return _arr;
-        };
-        static array_t<gotcha_data> _instance = _get();
+        static array_t<gotcha_data> _instance;
         return _instance;
     }
 
@@ -749,6 +681,15 @@ private:
         return _instance;
     }
 
+    //----------------------------------------------------------------------------------//
+    /// \brief get_thread_depth()
+    /// Thread-local re-entrancy depth of each wrapper
+    static array_t<int32_t>& get_thread_depth()
+    {
+        static thread_local array_t<int32_t> _instance = {};
+        return _instance;
+    }
+
     //----------------------------------------------------------------------------------//
     /// \brief is_permitted()
     /// Check the permit list and reject list for whether the component is permitted
@@ -945,65 +886,6 @@ private:
 
     //----------------------------------------------------------------------------------//
 
-    template <typename _Comp, typename _Ret, typename... _Args,
-              typename _This                                         = this_type,
-              enable_if_t<(_This::differentiator_is_component), int> = 0,
-              enable_if_t<!(std::is_same<_Ret, void>::value), int>   = 0>
-    static _Ret invoke(_Comp& _comp, bool& _ready, _Ret (*_func)(_Args...),
-                       _Args&&... _args)
-    {
-        using _Type    = _Differentiator;
-        using _Invoker = gotcha_invoker<_Type, _Ret>;
-        _Type& _obj    = _comp.template get<_Type>();
-        return _Invoker::invoke(_obj, _ready, _func, std::forward<_Args>(_args)...);
-    }
-
-    //----------------------------------------------------------------------------------//
-
-    template <typename _Comp, typename _Ret, typename... _Args,
-              typename _This                                          = this_type,
-              enable_if_t<!(_This::differentiator_is_component), int> = 0,
-              enable_if_t<!(std::is_same<_Ret, void>::value), int>    = 0>
-    static _Ret invoke(_Comp&, bool& _ready, _Ret (*_func)(_Args...), _Args&&... _args)
-    {
-        gotcha_suppression::auto_toggle suppress_lock(_ready);
-        // _ready    = true;
-        _Ret _ret = _func(std::forward<_Args>(_args)...);
-        // _ready    = false;
-        return _ret;
-    }
-
-    //----------------------------------------------------------------------------------//
-
-    template <typename _Comp, typename _Ret, typename... _Args,
-              typename _This                                         = this_type,
-              enable_if_t<(_This::differentiator_is_component), int> = 0,
-              enable_if_t<(std::is_same<_Ret, void>::value), int>    = 0>
-    static void invoke(_Comp& _comp, bool& _ready, _Ret (*_func)(_Args...),
-                       _Args&&... _args)
-    {
-        using _Type    = _Differentiator;
-        using _Invoker = gotcha_invoker<_Type, _Ret>;
-        _Type& _obj    = _comp.template get<_Type>();
-        _Invoker::invoke(_obj, _ready, _func, std::forward<_Args>(_args)...);
-    }
-
-    //----------------------------------------------------------------------------------//
-
-    template <typename _Comp, typename _Ret, typename... _Args,
-              typename _This                                          = this_type,
-              enable_if_t<!(_This::differentiator_is_component), int> = 0,
-              enable_if_t<(std::is_same<_Ret, void>::value), int>     = 0>
-    static void invoke(_Comp&, bool& _ready, _Ret (*_func)(_Args...), _Args&&... _args)
-    {
-        gotcha_suppression::auto_toggle suppress_lock(_ready);
-        // _ready    = true;
-        _func(std::forward<_Args>(_args)...);
-        // _ready    = false;
-    }
-
-    //----------------------------------------------------------------------------------//
-
     template <typename _Comp, typename _Ret, typename... _Args,
               typename _This                                         = this_type,
               enable_if_t<(_This::differentiator_is_component), int> = 0,
@@ -1059,13 +941,14 @@ private:
     {
         static_assert(_N < _Nt, "Error! _N must be less than _Nt!");
 #if defined(TIMEMORY_USE_GOTCHA)
-        auto& _data = get_data()[_N];
+        auto& _data  = get_data()[_N];
+        auto& _depth = get_thread_depth()[_N];
 
         typedef _Ret (*func_t)(_Args...);
         func_t _orig = (func_t)(gotcha_get_wrappee(_data.wrappee));
 
         auto& _global_suppress = gotcha_suppression::get();
-        if(!_data.ready || _global_suppress)
+        if(!_data.ready.load(std::memory_order_relaxed) || _global_suppress || _depth > 0)
         {
             if(settings::debug())
             {
@@ -1073,39 +956,37 @@ private:
                 static thread_local int64_t _tid = _tcount++;
                 std::stringstream           ss;
                 ss << "[T" << _tid << "]> is either not ready (" << std::boolalpha
-                   << _data.ready << ") or is globally suppressed (" << _global_suppress
-                   << ")...\n";
+                   << _data.ready.load() << "), is globally suppressed ("
+                   << _global_suppress << "), or is re-entrant (" << _depth << ")...\n";
                 std::cout << ss.str() << std::flush;
             }
             return (_orig) ? (*_orig)(_args...) : _Ret{};
         }
 
-        // make sure the function is not recursively entered (important for
-        // allocation-based wrappers)
-        _data.ready = false;
+        // make sure the function is not recursively entered on this thread (important
+        // for allocation-based wrappers). Other threads are unaffected
+        gotcha_suppression::auto_depth  depth_lock(_depth);
         gotcha_suppression::auto_toggle suppress_lock(gotcha_suppression::get());
 
         if(_orig)
         {
+            // the hash was computed when the wrapper was constructed so the label is
+            // not re-hashed and the storage finds the node in the child cache
+            source_location::captured _loc(_data.tool_hash, _data.tool_id);
+            gotcha_index              _idx{ _N, _data.tool_hash, &_data.tool_id };
+
             // component_type is always: component_{tuple,list,hybrid}
-            component_type _obj(_data.tool_id, true, settings::flat_profile());
+            component_type _obj(_loc, true, settings::flat_profile());
             _obj.start();
-            _obj.audit(_data.tool_id, _args...);
-            _Ret _ret = invoke<component_type>(_obj, _data.ready, _orig,
-                                               std::forward<_Args>(_args)...);
-            _obj.audit(_data.tool_id, _ret);
+            _obj.audit(_idx, _args...);
+            _Ret _ret =
+                invoke<component_type>(_obj, _orig, std::forward<_Args>(_args)...);
+            _obj.audit(_idx, _ret);
             _obj.stop();
-
-            // allow re-entrance into wrapper
-            _data.ready = true;
-
             return _ret;
         }
         if(settings::debug())
             PRINT_HERE("%s", "nullptr to original function!");
-
-        // allow re-entrance into wrapper
-        _data.ready = true;
 #else
         consume_parameters(_args...);
         PRINT_HERE("%s", "should not be here!");
@@ -1120,12 +1001,13 @@ private:
     {
         static_assert(_N < _Nt, "Error! _N must be less than _Nt!");
 #if defined(TIMEMORY_USE_GOTCHA)
-        auto& _data = get_data()[_N];
+        auto& _data  = get_data()[_N];
+        auto& _depth = get_thread_depth()[_N];
 
         auto _orig = (void (*)(_Args...)) gotcha_get_wrappee(_data.wrappee);
 
         auto& _global_suppress = gotcha_suppression::get();
-        if(!_data.ready || _global_suppress)
+        if(!_data.ready.load(std::memory_order_relaxed) || _global_suppress || _depth > 0)
         {
             if(settings::debug())
             {
@@ -1133,8 +1015,8 @@ private:
                 static thread_local int64_t _tid = _tcount++;
                 std::stringstream           ss;
                 ss << "[T" << _tid << "]> is either not ready (" << std::boolalpha
-                   << _data.ready << ") or is globally suppressed (" << _global_suppress
-                   << ")...\n";
+                   << _data.ready.load() << "), is globally suppressed ("
+                   << _global_suppress << "), or is re-entrant (" << _depth << ")...\n";
                 std::cout << ss.str() << std::flush;
             }
             if(_orig)
@@ -1142,28 +1024,27 @@ private:
             return;
         }
 
-        // make sure the function is not recursively entered (important for
-        // allocation-based wrappers)
-        _data.ready = false;
+        // make sure the function is not recursively entered on this thread (important
+        // for allocation-based wrappers). Other threads are unaffected
+        gotcha_suppression::auto_depth  depth_lock(_depth);
         gotcha_suppression::auto_toggle suppress_lock(gotcha_suppression::get());
 
         if(_orig)
         {
-            component_type _obj(_data.tool_id, true, settings::flat_profile());
+            source_location::captured _loc(_data.tool_hash, _data.tool_id);
+            gotcha_index              _idx{ _N, _data.tool_hash, &_data.tool_id };
+
+            component_type _obj(_loc, true, settings::flat_profile());
             _obj.start();
-            _obj.audit(_data.tool_id, _args...);
-            invoke<component_type>(_obj, _data.ready, _orig,
-                                   std::forward<_Args>(_args)...);
-            _obj.audit(_data.tool_id);
+            _obj.audit(_idx, _args...);
+            invoke<component_type>(_obj, _orig, std::forward<_Args>(_args)...);
+            _obj.audit(_idx);
             _obj.stop();
         }
         else if(settings::debug())
         {
             PRINT_HERE("%s", "nullptr to original function!");
         }
-
-        // allow re-entrance into wrapper
-        _data.ready = true;
 #else
         consume_parameters(_args...);
         PRINT_HERE("%s", "should not be here!");
@@ -1183,15 +1064,14 @@ private:
         typedef _Ret (*func_t)(_Args...);
         using wrap_type = tim::component_tuple<operator_type>;
 
-        auto _orig = (func_t) gotcha_get_wrappee(_data.wrappee);
-        if(!_data.ready)
+        auto& _depth = get_thread_depth()[_N];
+        auto  _orig  = (func_t) gotcha_get_wrappee(_data.wrappee);
+        if(!_data.ready.load(std::memory_order_relaxed) || _depth > 0)
             return (*_orig)(_args...);
 
-        _data.ready = false;
-        static thread_local wrap_type _obj(_data.tool_id, false);
-        _Ret _ret   = invoke(_obj, _orig, std::forward<_Args>(_args)...);
-        _data.ready = true;
-        return _ret;
+        gotcha_suppression::auto_depth depth_lock(_depth);
+        static thread_local wrap_type  _obj(_data.tool_id, false);
+        return invoke(_obj, _orig, std::forward<_Args>(_args)...);
 #else
         consume_parameters(_args...);
         PRINT_HERE("%s", "should not be here!");
@@ -1208,17 +1088,17 @@ private:
 #if defined(TIMEMORY_USE_GOTCHA)
         static auto& _data = get_data()[_N];
         typedef void (*func_t)(_Args...);
-        auto _orig      = (func_t) gotcha_get_wrappee(_data.wrappee);
+        auto  _orig     = (func_t) gotcha_get_wrappee(_data.wrappee);
+        auto& _depth    = get_thread_depth()[_N];
         using wrap_type = tim::component_tuple<operator_type>;
 
-        if(!_data.ready)
+        if(!_data.ready.load(std::memory_order_relaxed) || _depth > 0)
             (*_orig)(_args...);
         else
         {
-            _data.ready = false;
-            static thread_local wrap_type _obj(_data.tool_id, false);
+            gotcha_suppression::auto_depth depth_lock(_depth);
+            static thread_local wrap_type  _obj(_data.tool_id, false);
             invoke(_obj, _orig, std::forward<_Args>(_args)...);
-            _data.ready = true;
         }
 #else
         consume_parameters(_args...);
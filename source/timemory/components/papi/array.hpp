@@ -156,9 +156,21 @@ struct papi_array
 
     //----------------------------------------------------------------------------------//
 
-    static event_list get_events()
+    static const event_list& get_events()
     {
-        static event_list _instance = get_initializer()();
+        static event_list _instance = []() {
+            auto _events = get_initializer()();
+            // the counters are read into an array of MaxNumEvents
+            if(_events.size() > MaxNumEvents)
+            {
+                fprintf(stderr,
+                        "[papi_array]> Warning! Only the first %i of %i events will be "
+                        "recorded\n",
+                        (int) MaxNumEvents, (int) _events.size());
+                _events.resize(MaxNumEvents);
+            }
+            return _events;
+        }();
         return _instance;
     }
 
@@ -168,7 +180,7 @@ struct papi_array
     {
         if(!initialize_papi())
             return;
-        auto events = get_events();
+        auto& events = get_events();
         if(events.size() > 0)
         {
             papi::create_event_set(&_event_set(), settings::papi_multiplexing());
@@ -183,7 +195,7 @@ struct papi_array
     {
         if(!initialize_papi())
             return;
-        auto events = get_events();
+        auto& events = get_events();
         if(events.size() > 0 && _event_set() != PAPI_NULL && _event_set() >= 0)
         {
             value_type values;
@@ -198,7 +210,6 @@ struct papi_array
     //----------------------------------------------------------------------------------//
 
     explicit papi_array()
-    : events(get_events())
     {
         apply<void>::set_value(value, 0);
         apply<void>::set_value(accum, 0);
@@ -212,21 +223,26 @@ struct papi_array
     this_type& operator=(const this_type&) = default;
     this_type& operator=(this_type&&) = default;
 
-    // data types
-    event_list events;
-
     //----------------------------------------------------------------------------------//
 
-    std::size_t size() { return events.size(); }
+    static std::size_t size() { return get_events().size(); }
 
     //----------------------------------------------------------------------------------//
-
-    static value_type record()
+    // read the counters directly into the fixed-size array, no heap allocations
+    //
+    static void record(value_type& read_value)
     {
-        value_type read_value;
         apply<void>::set_value(read_value, 0);
         if(initialize_papi() && _event_set() != PAPI_NULL)
             papi::read(_event_set(), read_value.data());
+    }
+
+    //----------------------------------------------------------------------------------//
+
+    static value_type record()
+    {
+        value_type read_value;
+        record(read_value);
         return read_value;
     }
 
@@ -237,9 +253,9 @@ struct papi_array
     {
         std::vector<_Tp> values;
         auto&            _data = (is_transient) ? accum : value;
-        for(auto& itr : _data)
-            values.push_back(itr);
-        values.resize(events.size());
+        values.reserve(size());
+        for(size_type i = 0; i < size(); ++i)
+            values.push_back(_data[i]);
         return values;
     }
 
@@ -249,17 +265,18 @@ struct papi_array
     void start()
     {
         set_started();
-        value = record();
+        record(value);
     }
 
     //----------------------------------------------------------------------------------//
 
     void stop()
     {
-        auto tmp = record();
-        for(size_type i = 0; i < events.size(); ++i)
+        value_type tmp;
+        record(tmp);
+        for(size_type i = 0; i < size(); ++i)
             accum[i] += (tmp[i] - value[i]);
-        value = std::move(tmp);
+        value = tmp;
         set_stopped();
     }
 
@@ -267,9 +284,9 @@ struct papi_array
 
     this_type& operator+=(const this_type& rhs)
     {
-        for(size_type i = 0; i < events.size(); ++i)
+        for(size_type i = 0; i < size(); ++i)
             accum[i] += rhs.accum[i];
-        for(size_type i = 0; i < events.size(); ++i)
+        for(size_type i = 0; i < size(); ++i)
             value[i] += rhs.value[i];
         if(rhs.is_transient)
             is_transient = rhs.is_transient;
@@ -280,9 +297,9 @@ struct papi_array
 
     this_type& operator-=(const this_type& rhs)
     {
-        for(size_type i = 0; i < events.size(); ++i)
+        for(size_type i = 0; i < size(); ++i)
             accum[i] -= rhs.accum[i];
-        for(size_type i = 0; i < events.size(); ++i)
+        for(size_type i = 0; i < size(); ++i)
             value[i] -= rhs.value[i];
         if(rhs.is_transient)
             is_transient = rhs.is_transient;
@@ -332,7 +349,7 @@ public:
         array_t<double> _disp;
         array_t<double> _value;
         array_t<double> _accum;
-        for(size_type i = 0; i < events.size(); ++i)
+        for(size_type i = 0; i < size(); ++i)
         {
             _disp[i]  = get_display(i);
             _value[i] = value[i];
@@ -349,8 +366,8 @@ public:
     array_t<std::string> label_array() const
     {
         array_t<std::string> arr;
-        for(size_type i = 0; i < events.size(); ++i)
-            arr[i] = papi::get_event_info(events[i]).short_descr;
+        for(size_type i = 0; i < size(); ++i)
+            arr[i] = papi::get_event_info(get_events()[i]).short_descr;
         return arr;
     }
 
@@ -360,8 +377,8 @@ public:
     array_t<std::string> descript_array() const
     {
         array_t<std::string> arr;
-        for(size_type i = 0; i < events.size(); ++i)
-            arr[i] = papi::get_event_info(events[i]).long_descr;
+        for(size_type i = 0; i < size(); ++i)
+            arr[i] = papi::get_event_info(get_events()[i]).long_descr;
         return arr;
     }
 
@@ -371,8 +388,8 @@ public:
     array_t<std::string> display_unit_array() const
     {
         array_t<std::string> arr;
-        for(size_type i = 0; i < events.size(); ++i)
-            arr[i] = papi::get_event_info(events[i]).units;
+        for(size_type i = 0; i < size(); ++i)
+            arr[i] = papi::get_event_info(get_events()[i]).units;
         return arr;
     }
 
@@ -382,7 +399,7 @@ public:
     array_t<int64_t> unit_array() const
     {
         array_t<int64_t> arr;
-        for(size_type i = 0; i < events.size(); ++i)
+        for(size_type i = 0; i < size(); ++i)
             arr[i] = 1;
         return arr;
     }
@@ -391,12 +408,12 @@ public:
 
     string_t get_display() const
     {
-        if(events.size() == 0)
+        if(size() == 0)
             return "";
         auto val          = (is_transient) ? accum : value;
         auto _get_display = [&](std::ostream& os, size_type idx) {
             auto     _obj_value = val[idx];
-            auto     _evt_type  = events[idx];
+            auto     _evt_type  = get_events()[idx];
             string_t _label     = papi::get_event_info(_evt_type).short_descr;
             string_t _disp      = papi::get_event_info(_evt_type).units;
             auto     _prec      = base_type::get_precision();
@@ -415,10 +432,10 @@ public:
         };
 
         std::stringstream ss;
-        for(size_type i = 0; i < events.size(); ++i)
+        for(size_type i = 0; i < size(); ++i)
         {
             _get_display(ss, i);
-            if(i + 1 < events.size())
+            if(i + 1 < size())
                 ss << ", ";
         }
         return ss.str();
@@ -428,7 +445,7 @@ public:
 
     friend std::ostream& operator<<(std::ostream& os, const this_type& obj)
     {
-        if(obj.events.size() == 0)
+        if(obj.size() == 0)
             return os;
         // output the metrics
         auto _value = obj.get_display();
@@ -0,0 +1,460 @@
+// MIT License
+//
+// Copyright (c) 2020, The Regents of the University of California,
+// through Lawrence Berkeley National Laboratory (subject to receipt of any
+// required approvals from the U.S. Dept. of Energy).  All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+#include "timemory/backends/perf_event.hpp"
+#include "timemory/components/base.hpp"
+#include "timemory/components/types.hpp"
+#include "timemory/units.hpp"
+#include "timemory/utility/macros.hpp"
+#include "timemory/utility/serializer.hpp"
+#include "timemory/utility/storage.hpp"
+
+#include <iostream>
+
+//======================================================================================//
+
+namespace tim
+{
+namespace component
+{
+#if defined(TIMEMORY_EXTERN_TEMPLATES) && !defined(TIMEMORY_BUILD_EXTERN_TEMPLATE)
+
+extern template struct base<perf_event_array<8>, std::array<long long, 8>>;
+extern template struct base<perf_event_array<16>, std::array<long long, 16>>;
+
+#endif
+
+//--------------------------------------------------------------------------------------//
+//
+//              Array of counters read with perf_event_open (Linux)
+//
+//--------------------------------------------------------------------------------------//
+//
+//  The counters of each thread are opened as one group when the thread is initialized
+//  and keep counting until the thread is finalized. start() and stop() read the group
+//  and the difference is accumulated, i.e. the same semantics as papi_array
+//
+template <size_t MaxNumEvents>
+struct perf_event_array
+: public base<perf_event_array<MaxNumEvents>, std::array<long long, MaxNumEvents>>
+{
+    using size_type         = std::size_t;
+    using event_list        = std::vector<std::string>;
+    using info_list         = std::vector<perf_event::event_info>;
+    using value_type        = std::array<long long, MaxNumEvents>;
+    using entry_type        = typename value_type::value_type;
+    using this_type         = perf_event_array<MaxNumEvents>;
+    using base_type         = base<this_type, value_type>;
+    using storage_type      = typename base_type::storage_type;
+    using get_initializer_t = std::function<event_list()>;
+
+    static const short precision = 3;
+    static const short width     = 8;
+
+    template <typename _Tp>
+    using array_t = std::array<_Tp, MaxNumEvents>;
+
+    //----------------------------------------------------------------------------------//
+
+    static get_initializer_t& get_initializer()
+    {
+        static get_initializer_t _instance = []() {
+            auto events_str = settings::perf_events();
+
+            if(settings::verbose() > 1 || settings::debug())
+            {
+                static std::atomic<int> _once(0);
+                if(_once++ == 0)
+                {
+                    printf("[perf_event_array]> TIMEMORY_PERF_EVENTS: '%s'...\n",
+                           events_str.c_str());
+                }
+            }
+
+            event_list events_list;
+            for(const auto& itr : delimit(events_str))
+            {
+                if(itr.length() == 0)
+                    continue;
+                if(events_list.size() == MaxNumEvents)
+                {
+                    fprintf(stderr,
+                            "[perf_event_array]> Warning! Ignoring '%s', the maximum "
+                            "number of events is %i\n",
+                            itr.c_str(), (int) MaxNumEvents);
+                    continue;
+                }
+                events_list.push_back(itr);
+            }
+            return events_list;
+        };
+        return _instance;
+    }
+
+    //----------------------------------------------------------------------------------//
+
+    static const event_list& get_events()
+    {
+        static event_list _instance = get_initializer()();
+        return _instance;
+    }
+
+    //----------------------------------------------------------------------------------//
+
+    static const info_list& get_event_info()
+    {
+        static info_list _instance = []() {
+            info_list _info;
+            for(const auto& itr : get_events())
+                _info.push_back(perf_event::get_event_info(itr));
+            return _info;
+        }();
+        return _instance;
+    }
+
+    //----------------------------------------------------------------------------------//
+    /// opens the group of the calling thread on the first call after the thread
+    /// started or was finalized
+    static bool initialize_group()
+    {
+        bool& _initialized = _group_initialized();
+        bool& _working     = _group_working();
+        if(!_initialized)
+        {
+            _initialized = true;
+            if(get_events().empty())
+                return false;
+
+            std::vector<std::string> _errors;
+            _working = _group().open(get_event_info(), settings::perf_event_rdpmc(),
+                                     &_errors);
+
+            static std::atomic<int> _once(0);
+            if(!_errors.empty() && _once++ == 0)
+            {
+                std::cerr << "Warning! perf_event_open failed for the following "
+                             "events, they will be reported as zero:\n";
+                for(const auto& itr : _errors)
+                    std::cerr << "    " << itr << "\n";
+                std::cerr << std::flush;
+            }
+        }
+        return _working;
+    }
+
+    //----------------------------------------------------------------------------------//
+
+    static void thread_init(storage_type*) { initialize_group(); }
+
+    //----------------------------------------------------------------------------------//
+
+    static void thread_finalize(storage_type*)
+    {
+        _group().close();
+        _group_initialized() = false;
+        _group_working()     = false;
+    }
+
+    //----------------------------------------------------------------------------------//
+
+    explicit perf_event_array()
+    {
+        apply<void>::set_value(value, 0);
+        apply<void>::set_value(accum, 0);
+    }
+
+    //----------------------------------------------------------------------------------//
+
+    ~perf_event_array() {}
+    perf_event_array(const perf_event_array& rhs) = default;
+    perf_event_array(perf_event_array&& rhs)      = default;
+    this_type& operator=(const this_type&) = default;
+    this_type& operator=(this_type&&) = default;
+
+    //----------------------------------------------------------------------------------//
+
+    static std::size_t size() { return get_events().size(); }
+
+    //----------------------------------------------------------------------------------//
+
+    static void record(value_type& read_value)
+    {
+        apply<void>::set_value(read_value, 0);
+        if(initialize_group())
+            _group().read(read_value.data());
+    }
+
+    //----------------------------------------------------------------------------------//
+
+    static value_type record()
+    {
+        value_type read_value;
+        record(read_value);
+        return read_value;
+    }
+
+    //----------------------------------------------------------------------------------//
+
+    template <typename _Tp = double>
+    std::vector<_Tp> get() const
+    {
+        std::vector<_Tp> values;
+        auto&            _data = (is_transient) ? accum : value;
+        values.reserve(size());
+        for(size_type i = 0; i < size(); ++i)
+            values.push_back(_data[i]);
+        return values;
+    }
+
+    //----------------------------------------------------------------------------------//
+    // start
+    //
+    void start()
+    {
+        set_started();
+        record(value);
+    }
+
+    //----------------------------------------------------------------------------------//
+
+    void stop()
+    {
+        value_type tmp;
+        record(tmp);
+        for(size_type i = 0; i < size(); ++i)
+            accum[i] += (tmp[i] - value[i]);
+        value = tmp;
+        set_stopped();
+    }
+
+    //----------------------------------------------------------------------------------//
+
+    this_type& operator+=(const this_type& rhs)
+    {
+        for(size_type i = 0; i < size(); ++i)
+            accum[i] += rhs.accum[i];
+        for(size_type i = 0; i < size(); ++i)
+            value[i] += rhs.value[i];
+        if(rhs.is_transient)
+            is_transient = rhs.is_transient;
+        return *this;
+    }
+
+    //----------------------------------------------------------------------------------//
+
+    this_type& operator-=(const this_type& rhs)
+    {
+        for(size_type i = 0; i < size(); ++i)
+            accum[i] -= rhs.accum[i];
+        for(size_type i = 0; i < size(); ++i)
+            value[i] -= rhs.value[i];
+        if(rhs.is_transient)
+            is_transient = rhs.is_transient;
+        return *this;
+    }
+
+    //----------------------------------------------------------------------------------//
+
+protected:
+    using base_type::accum;
+    using base_type::is_transient;
+    using base_type::laps;
+    using base_type::set_started;
+    using base_type::set_stopped;
+    using base_type::value;
+
+    friend struct base<this_type, value_type>;
+
+    using base_type::implements_storage_v;
+    friend class impl::storage<this_type, implements_storage_v>;
+
+public:
+    //==================================================================================//
+    //
+    //      data representation
+    //
+    //==================================================================================//
+
+    static std::string label() { return "perf_event_array"; }
+    static std::string description()
+    {
+        return "Array of HW counters read with perf_event_open";
+    }
+
+    entry_type get_display(int evt_type) const
+    {
+        auto val = (is_transient) ? accum[evt_type] : value[evt_type];
+        return val;
+    }
+
+    //----------------------------------------------------------------------------------//
+    // serialization
+    //
+    template <typename Archive>
+    void serialize(Archive& ar, const unsigned int)
+    {
+        array_t<double> _disp;
+        array_t<double> _value;
+        array_t<double> _accum;
+        for(size_type i = 0; i < size(); ++i)
+        {
+            _disp[i]  = get_display(i);
+            _value[i] = value[i];
+            _accum[i] = accum[i];
+        }
+        ar(cereal::make_nvp("is_transient", is_transient), cereal::make_nvp("laps", laps),
+           cereal::make_nvp("repr_data", _disp), cereal::make_nvp("value", _value),
+           cereal::make_nvp("accum", _accum), cereal::make_nvp("display", _disp));
+    }
+
+    //----------------------------------------------------------------------------------//
+    // array of descriptions
+    //
+    array_t<std::string> label_array() const
+    {
+        array_t<std::string> arr;
+        for(size_type i = 0; i < size(); ++i)
+            arr[i] = get_event_info()[i].symbol;
+        return arr;
+    }
+
+    //----------------------------------------------------------------------------------//
+    // array of labels
+    //
+    array_t<std::string> descript_array() const
+    {
+        array_t<std::string> arr;
+        for(size_type i = 0; i < size(); ++i)
+            arr[i] = get_event_info()[i].description;
+        return arr;
+    }
+
+    //----------------------------------------------------------------------------------//
+    // array of unit
+    //
+    array_t<std::string> display_unit_array() const
+    {
+        array_t<std::string> arr;
+        for(size_type i = 0; i < size(); ++i)
+            arr[i] = "";
+        return arr;
+    }
+
+    //----------------------------------------------------------------------------------//
+    // array of unit values
+    //
+    array_t<int64_t> unit_array() const
+    {
+        array_t<int64_t> arr;
+        for(size_type i = 0; i < size(); ++i)
+            arr[i] = 1;
+        return arr;
+    }
+
+    //----------------------------------------------------------------------------------//
+
+    string_t get_display() const
+    {
+        if(size() == 0)
+            return "";
+        auto val          = (is_transient) ? accum : value;
+        auto _get_display = [&](std::ostream& os, size_type idx) {
+            auto     _obj_value = val[idx];
+            string_t _label     = get_event_info()[idx].symbol;
+            auto     _prec      = base_type::get_precision();
+            auto     _width     = base_type::get_width();
+            auto     _flags     = base_type::get_format_flags();
+
+            std::stringstream ss, ssv, ssi;
+            ssv.setf(_flags);
+            ssv << std::setw(_width) << std::setprecision(_prec) << _obj_value;
+            if(!_label.empty())
+                ssi << " " << _label;
+            ss << ssv.str() << ssi.str();
+            os << ss.str();
+        };
+
+        std::stringstream ss;
+        for(size_type i = 0; i < size(); ++i)
+        {
+            _get_display(ss, i);
+            if(i + 1 < size())
+                ss << ", ";
+        }
+        return ss.str();
+    }
+
+    //----------------------------------------------------------------------------------//
+
+    friend std::ostream& operator<<(std::ostream& os, const this_type& obj)
+    {
+        if(obj.size() == 0)
+            return os;
+        // output the metrics
+        auto _value = obj.get_display();
+        auto _label = this_type::get_label();
+        auto _disp  = this_type::display_unit();
+        auto _prec  = this_type::get_precision();
+        auto _width = this_type::get_width();
+        auto _flags = this_type::get_format_flags();
+
+        std::stringstream ss_value;
+        std::stringstream ss_extra;
+        ss_value.setf(_flags);
+        ss_value << std::setw(_width) << std::setprecision(_prec) << _value;
+        if(!_disp.empty())
+            ss_extra << " " << _disp;
+        else if(!_label.empty())
+            ss_extra << " " << _label;
+        os << ss_value.str() << ss_extra.str();
+        return os;
+    }
+
+private:
+    //----------------------------------------------------------------------------------//
+
+    static perf_event::group& _group()
+    {
+        static thread_local perf_event::group _instance;
+        return _instance;
+    }
+
+    static bool& _group_initialized()
+    {
+        static thread_local bool _instance = false;
+        return _instance;
+    }
+
+    static bool& _group_working()
+    {
+        static thread_local bool _instance = false;
+        return _instance;
+    }
+};
+
+//--------------------------------------------------------------------------------------//
+}  // namespace component
+}  // namespace tim
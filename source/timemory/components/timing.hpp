@@ -57,6 +57,7 @@ extern template struct base<process_cpu_clock>;
 extern template struct base<cpu_util, std::pair<int64_t, int64_t>>;
 extern template struct base<process_cpu_util, std::pair<int64_t, int64_t>>;
 extern template struct base<thread_cpu_util, std::pair<int64_t, int64_t>>;
+extern template struct base<tsc_clock>;
 
 #endif
 
@@ -355,6 +356,43 @@ struct process_cpu_clock : public base<process_cpu_clock>
     }
 };
 
+//--------------------------------------------------------------------------------------//
+// real-time clock from the time-stamp counter of the CPU, converted to the time of
+// CLOCK_MONOTONIC_RAW. The rate of the counter is calibrated against CLOCK_MONOTONIC_RAW
+// once (at global_init or the first record) and reading it does not enter the kernel
+// so it is suited for fine-grained regions. When the counter is not invariant (i.e. the
+// rate depends on the frequency of the core) this falls back to CLOCK_MONOTONIC_RAW.
+struct tsc_clock : public base<tsc_clock>
+{
+    using ratio_t    = std::nano;
+    using value_type = int64_t;
+    using base_type  = base<tsc_clock, value_type>;
+
+    static std::string label() { return "tsc_clock"; }
+    static std::string description() { return "time-stamp counter time"; }
+    static value_type  record() { return tim::get_clock_tsc_now<int64_t, ratio_t>(); }
+    static void        global_init(storage_type*) { tim::tsc::get_calibration(); }
+    double             get_display() const
+    {
+        auto val = (is_transient) ? static_cast<value_type>(accum) : value;
+        return static_cast<double>(val / static_cast<double>(ratio_t::den) *
+                                   base_type::get_unit());
+    }
+    double get() const { return get_display(); }
+    void   start()
+    {
+        set_started();
+        value = record();
+    }
+    void stop()
+    {
+        auto tmp = record();
+        accum += (tmp - value);
+        value = std::move(tmp);
+        set_stopped();
+    }
+};
+
 //--------------------------------------------------------------------------------------//
 // this computes the CPU utilization percentage for the calling process and child
 // processes.
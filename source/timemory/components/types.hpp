@@ -45,6 +45,10 @@
 #    define TIMEMORY_PAPI_ARRAY_SIZE 8
 #endif
 
+#if !defined(TIMEMORY_PERF_EVENT_ARRAY_SIZE)
+#    define TIMEMORY_PERF_EVENT_ARRAY_SIZE 8
+#endif
+
 //======================================================================================//
 //
 namespace tim
@@ -84,6 +88,7 @@ struct monotonic_clock;
 struct monotonic_raw_clock;
 struct thread_cpu_clock;
 struct process_cpu_clock;
+struct tsc_clock;
 struct cpu_util;
 struct process_cpu_util;
 struct thread_cpu_util;
@@ -145,6 +150,13 @@ using papi_array16_t = papi_array<16>;
 using papi_array32_t = papi_array<32>;
 using papi_array_t   = papi_array<TIMEMORY_PAPI_ARRAY_SIZE>;
 
+// perf_event
+template <size_t MaxNumEvents>
+struct perf_event_array;
+
+// always defined
+using perf_event_array_t = perf_event_array<TIMEMORY_PERF_EVENT_ARRAY_SIZE>;
+
 // cupti
 struct cupti_counters;
 struct cupti_activity;
@@ -363,6 +375,12 @@ TIMEMORY_PROPERTY_SPECIALIZATION(peak_rss, PEAK_RSS, "peak_rss")
 
 //--------------------------------------------------------------------------------------//
 
+TIMEMORY_PROPERTY_SPECIALIZATION(perf_event_array_t, PERF_EVENT_ARRAY,
+                                 "perf_event_array_t", "perf_event_array", "perf_event",
+                                 "perf")
+
+//--------------------------------------------------------------------------------------//
+
 TIMEMORY_PROPERTY_SPECIALIZATION(priority_context_switch, PRIORITY_CONTEXT_SWITCH,
                                  "priority_context_switch")
 
@@ -405,6 +423,10 @@ TIMEMORY_PROPERTY_SPECIALIZATION(trip_count, TRIP_COUNT, "trip_count")
 
 //--------------------------------------------------------------------------------------//
 
+TIMEMORY_PROPERTY_SPECIALIZATION(tsc_clock, TSC_CLOCK, "tsc_clock")
+
+//--------------------------------------------------------------------------------------//
+
 TIMEMORY_PROPERTY_SPECIALIZATION(user_clock, USER_CLOCK, "user_clock")
 
 //--------------------------------------------------------------------------------------//
@@ -35,13 +35,17 @@
 
 #include "timemory/components/base.hpp"
 #include "timemory/components/types.hpp"
+#include "timemory/general/source_location.hpp"
 #include "timemory/mpl/apply.hpp"
 #include "timemory/mpl/types.hpp"
 #include "timemory/settings.hpp"
 #include "timemory/variadic/types.hpp"
 
+#include <atomic>
 #include <cassert>
+#include <cstddef>
 #include <cstdint>
+#include <memory>
 
 //======================================================================================//
 
@@ -77,6 +81,40 @@ struct user_bundle : public base<user_bundle<_Idx, _Tag>, void>
     using mutex_t = std::mutex;
     using lock_t  = std::unique_lock<mutex_t>;
 
+    using captured_location_t = source_location::captured;
+
+    //----------------------------------------------------------------------------------//
+    //  The typed configure<...>() overloads register an entry in an immutable table
+    //  of function pointers. The tools are constructed in-place in the per-instance
+    //  state (at "offset") with a key that is hashed once per prefix. The state is
+    //  allocated at the first start so the copies in the call-graph stay small and a
+    //  move transfers the running tools without moving them. The tools in the
+    //  table are started and stopped before the start/stop functions, regardless of
+    //  the order of the configure calls
+    //
+    struct tool_entry
+    {
+        using start_func_ptr_t = void (*)(void*, const captured_location_t&, bool);
+        using stop_func_ptr_t  = void (*)(void*);
+
+        size_t           offset = 0;
+        bool             flat   = false;
+        start_func_ptr_t start  = nullptr;
+        stop_func_ptr_t  stop   = nullptr;
+    };
+
+    struct tool_table
+    {
+        size_t                  size    = 0;
+        std::vector<tool_entry> entries = {};
+    };
+
+    using table_ptr_t = std::unique_ptr<tool_table>;
+    using table_vec_t = std::vector<table_ptr_t>;
+    using state_type  = typename std::aligned_storage<sizeof(std::max_align_t),
+                                                     alignof(std::max_align_t)>::type;
+    using state_ptr_t = std::unique_ptr<state_type[]>;
+
     static std::string label() { return "user_bundle"; }
     static std::string description() { return "user-defined bundle of tools"; }
     static value_type  record() {}
@@ -88,11 +126,13 @@ public:
     //
     user_bundle(const std::string& _prefix = "")
     : m_prefix(_prefix)
+    , m_table(get_table())
     , m_bundle(void_vec_t{})
     , m_start(get_start())
     , m_stop(get_stop())
     {
         assert(m_start.size() == m_stop.size());
+        update_location();
     }
 
     //----------------------------------------------------------------------------------//
@@ -100,6 +140,7 @@ public:
     //
     user_bundle(const start_func_vec_t& _start, const stop_func_vec_t& _stop)
     : m_prefix("")
+    , m_table(&get_empty_table())
     , m_bundle(std::max(_start.size(), _stop.size()), nullptr)
     , m_start(_start)
     , m_stop(_stop)
@@ -113,11 +154,74 @@ public:
     user_bundle(const std::string& _prefix, const start_func_vec_t& _start,
                 const stop_func_vec_t& _stop)
     : m_prefix(_prefix)
+    , m_table(&get_empty_table())
     , m_bundle(std::max(_start.size(), _stop.size()), nullptr)
     , m_start(_start)
     , m_stop(_stop)
     {
         assert(m_start.size() == m_stop.size());
+        update_location();
+    }
+
+    //----------------------------------------------------------------------------------//
+    //  The tools constructed in the state of "rhs" are not shared with the copy
+    //
+    user_bundle(const user_bundle& rhs)
+    : base_type(rhs)
+    , m_prefix(rhs.m_prefix)
+    , m_location(rhs.m_location)
+    , m_table(rhs.m_table)
+    , m_bundle(rhs.m_bundle)
+    , m_start(rhs.m_start)
+    , m_stop(rhs.m_stop)
+    {}
+
+    //----------------------------------------------------------------------------------//
+    //  The running tools constructed in the state of "rhs" are moved to this instance
+    //
+    user_bundle(user_bundle&& rhs)
+    : base_type(std::move(rhs))
+    , m_prefix(std::move(rhs.m_prefix))
+    , m_location(rhs.m_location)
+    , m_table(rhs.m_table)
+    , m_bundle(std::move(rhs.m_bundle))
+    , m_start(std::move(rhs.m_start))
+    , m_stop(std::move(rhs.m_stop))
+    {
+        move_table(rhs);
+    }
+
+    ~user_bundle() { stop_table(); }
+
+    user_bundle& operator=(const user_bundle& rhs)
+    {
+        if(this == &rhs)
+            return *this;
+        stop_table();
+        base_type::operator=(rhs);
+        m_prefix   = rhs.m_prefix;
+        m_location = rhs.m_location;
+        m_table    = rhs.m_table;
+        m_bundle   = rhs.m_bundle;
+        m_start    = rhs.m_start;
+        m_stop     = rhs.m_stop;
+        return *this;
+    }
+
+    user_bundle& operator=(user_bundle&& rhs)
+    {
+        if(this == &rhs)
+            return *this;
+        stop_table();
+        base_type::operator=(std::move(rhs));
+        m_prefix   = std::move(rhs.m_prefix);
+        m_location = rhs.m_location;
+        m_table    = rhs.m_table;
+        m_bundle   = std::move(rhs.m_bundle);
+        m_start    = std::move(rhs.m_start);
+        m_stop     = std::move(rhs.m_stop);
+        move_table(rhs);
+        return *this;
     }
 
 public:
@@ -153,22 +257,7 @@ public:
         internal_init<_Toolset>();
 
         using _Toolset_t = auto_tuple<_Toolset>;
-        auto _start      = [=](const std::string& _prefix) {
-            _Toolset_t* _result = new _Toolset_t(_prefix, _flat);
-            _result->start();
-            return (void*) _result;
-        };
-
-        auto _stop = [=](void* v_result) {
-            _Toolset_t* _result = static_cast<_Toolset_t*>(v_result);
-            _result->stop();
-            delete _result;
-        };
-
-        lock_t lk(get_lock());
-        get_typeids().insert(_typeid_hash);
-        get_start().emplace_back(_start);
-        get_stop().emplace_back(_stop);
+        register_tool<_Toolset_t>(_typeid_hash, _flat, &start_tool<_Toolset_t>);
     }
 
     //----------------------------------------------------------------------------------//
@@ -191,24 +280,7 @@ public:
 
         internal_init();
 
-        auto _start = [=](const std::string& _prefix) {
-            constexpr bool is_component_type = _Toolset::is_component_type;
-            _Toolset* _result = (is_component_type) ? new _Toolset(_prefix, true, _flat)
-                                                    : new _Toolset(_prefix, _flat);
-            _result->start();
-            return (void*) _result;
-        };
-
-        auto _stop = [=](void* v_result) {
-            _Toolset* _result = static_cast<_Toolset*>(v_result);
-            _result->stop();
-            delete _result;
-        };
-
-        lock_t lk(get_lock());
-        get_typeids().insert(_typeid_hash);
-        get_start().emplace_back(_start);
-        get_stop().emplace_back(_stop);
+        register_tool<_Toolset>(_typeid_hash, _flat, &start_tool<_Toolset>);
     }
 
     //----------------------------------------------------------------------------------//
@@ -311,6 +383,12 @@ public:
         return _instance;
     }
 
+    //----------------------------------------------------------------------------------//
+    //  The current table of the typed configurations. A published table is never
+    //  modified or deleted so instances only need to copy the pointer
+    //
+    static const tool_table* get_table() { return get_table_ptr().load(); }
+
     //----------------------------------------------------------------------------------//
     //  Explicitly clear the previous configurations
     //
@@ -320,6 +398,7 @@ public:
         get_start().clear();
         get_stop().clear();
         get_typeids().clear();
+        get_table_ptr().store(&get_empty_table());
     }
 
 public:
@@ -329,6 +408,7 @@ public:
     void start()
     {
         base_type::set_started();
+        start_table();
         m_bundle.resize(m_start.size(), nullptr);
         for(int64_t i = 0; i < (int64_t) m_start.size(); ++i)
             m_bundle[i] = m_start[i](m_prefix);
@@ -336,6 +416,7 @@ public:
 
     void stop()
     {
+        stop_table();
         assert(m_stop.size() == m_bundle.size());
         for(int64_t i = 0; i < (int64_t) m_stop.size(); ++i)
             m_stop[i](m_bundle[i]);
@@ -346,12 +427,17 @@ public:
     {
         if(base_type::is_running)
             stop();
+        m_table = &get_empty_table();
         m_start.clear();
         m_stop.clear();
         m_bundle.clear();
     }
 
-    void set_prefix(const std::string& _prefix) { m_prefix = _prefix; }
+    void set_prefix(const std::string& _prefix)
+    {
+        m_prefix = _prefix;
+        update_location();
+    }
 
 public:
     //----------------------------------------------------------------------------------//
@@ -490,12 +576,153 @@ public:
     }
 
 protected:
-    std::string      m_prefix;
-    void_vec_t       m_bundle;
-    start_func_vec_t m_start;
-    stop_func_vec_t  m_stop;
+    std::string         m_prefix;
+    captured_location_t m_location = {};
+    const tool_table*   m_table    = nullptr;
+    size_t              m_active   = 0;
+    state_ptr_t         m_state      = state_ptr_t{};
+    size_t              m_state_size = 0;
+    void_vec_t          m_bundle;
+    start_func_vec_t    m_start;
+    stop_func_vec_t     m_stop;
 
 private:
+    //----------------------------------------------------------------------------------//
+    //  Hash the prefix once instead of once per tool per start
+    //
+    void update_location()
+    {
+        auto _hash  = add_hash_id(m_prefix);
+        auto _entry = get_hash_ids()->find(_hash);
+        m_location  = (_entry) ? captured_location_t(_hash, _entry->value)
+                              : captured_location_t{};
+    }
+
+    //----------------------------------------------------------------------------------//
+    //  Per-instance storage for the tools in the table, allocated once and reused by
+    //  every subsequent start of this instance
+    //
+    char* get_state()
+    {
+        auto _n = (m_table->size + sizeof(state_type) - 1) / sizeof(state_type);
+        if(_n > m_state_size)
+        {
+            m_state      = state_ptr_t(new state_type[_n]);
+            m_state_size = _n;
+        }
+        return reinterpret_cast<char*>(m_state.get());
+    }
+
+    void start_table()
+    {
+        if(m_active > 0 || m_table->entries.empty())
+            return;
+        char* _state = get_state();
+        for(const auto& itr : m_table->entries)
+            (*itr.start)(_state + itr.offset, m_location, itr.flat);
+        m_active = m_table->entries.size();
+    }
+
+    void stop_table()
+    {
+        if(m_active == 0)
+            return;
+        char* _state = get_state();
+        for(size_t i = 0; i < m_active; ++i)
+        {
+            const auto& itr = m_table->entries[i];
+            (*itr.stop)(_state + itr.offset);
+        }
+        m_active = 0;
+    }
+
+    //----------------------------------------------------------------------------------//
+    //  Take over the running tools of "rhs", which must have the same table. The
+    //  tools stay where they were constructed, only the state changes owner
+    //
+    void move_table(user_bundle& rhs)
+    {
+        if(rhs.m_active == 0)
+            return;
+        m_state          = std::move(rhs.m_state);
+        m_state_size     = rhs.m_state_size;
+        m_active         = rhs.m_active;
+        rhs.m_state_size = 0;
+        rhs.m_active     = 0;
+    }
+
+    //----------------------------------------------------------------------------------//
+    //  Entries of the table
+    //
+    template <typename _Toolset, enable_if_t<(_Toolset::is_component_type), char> = 0>
+    static void start_tool(void* _ptr, const captured_location_t& _loc, bool _flat)
+    {
+        (new(_ptr) _Toolset(_loc, true, _flat))->start();
+    }
+
+    template <typename _Toolset, enable_if_t<!(_Toolset::is_component_type), char> = 0>
+    static void start_tool(void* _ptr, const captured_location_t& _loc, bool _flat)
+    {
+        (new(_ptr) _Toolset(_loc, _flat))->start();
+    }
+
+    template <typename _Toolset>
+    static void stop_tool(void* _ptr)
+    {
+        _Toolset* _result = static_cast<_Toolset*>(_ptr);
+        _result->stop();
+        _result->~_Toolset();
+    }
+
+    //----------------------------------------------------------------------------------//
+    //  Publish a copy of the current table with the new entry appended
+    //
+    template <typename _Toolset>
+    static void register_tool(size_t _typeid_hash, bool _flat,
+                              typename tool_entry::start_func_ptr_t _start)
+    {
+        static_assert(alignof(_Toolset) <= alignof(state_type),
+                      "Toolset is over-aligned for the user_bundle state");
+
+        lock_t lk(get_lock());
+        if(get_typeids().count(_typeid_hash) > 0)
+            return;
+
+        constexpr size_t _align  = alignof(_Toolset);
+        table_ptr_t      _table  = table_ptr_t(new tool_table(*get_table()));
+        size_t           _offset = (_table->size + _align - 1) / _align * _align;
+        tool_entry       _entry;
+        _entry.offset = _offset;
+        _entry.flat   = _flat;
+        _entry.start  = _start;
+        _entry.stop   = &stop_tool<_Toolset>;
+        _table->entries.push_back(_entry);
+        _table->size = _offset + sizeof(_Toolset);
+
+        get_typeids().insert(_typeid_hash);
+        get_table_ptr().store(_table.get());
+        get_tables().emplace_back(std::move(_table));
+    }
+
+    static const tool_table& get_empty_table()
+    {
+        static tool_table _instance{};
+        return _instance;
+    }
+
+    static std::atomic<const tool_table*>& get_table_ptr()
+    {
+        static std::atomic<const tool_table*> _instance{ &get_empty_table() };
+        return _instance;
+    }
+
+    //  every table ever published, kept alive for the instances referencing them
+    static table_vec_t& get_tables()
+    {
+        static table_vec_t _instance{};
+        return _instance;
+    }
+
     //----------------------------------------------------------------------------------//
     //  Get lock
     //
@@ -0,0 +1,281 @@
+//  MIT License
+//
+//  Copyright (c) 2020, The Regents of the University of California,
+//  through Lawrence Berkeley National Laboratory (subject to receipt of any
+//  required approvals from the U.S. Dept. of Energy).  All rights reserved.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to
+//  deal in the Software without restriction, including without limitation the
+//  rights to use, copy, modify, merge, publish, distribute, sublicense, and
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+//  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+//  IN THE SOFTWARE.
+
+/** \file timemory/data/quantile_sketch.hpp
+ * \headerfile timemory/data/quantile_sketch.hpp "timemory/data/quantile_sketch.hpp"
+ * Fixed-memory estimate of the quantiles of a stream of values. The values are
+ * counted in logarithmically-sized bins (DDSketch) so that any quantile is reported
+ * within 1% of the true value and two sketches are merged by adding the counts of
+ * the bins.
+ *
+ */
+
+#pragma once
+
+//----------------------------------------------------------------------------//
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+#include "timemory/utility/macros.hpp"
+#include "timemory/utility/serializer.hpp"
+
+namespace tim
+{
+//======================================================================================//
+
+class quantile_sketch
+{
+public:
+    using count_type = uint64_t;
+    using index_type = int32_t;
+
+    /// the maximum number of bins for each sign. When a stream spans more than this
+    /// range (a factor of ~1e17 at 1% accuracy) the lowest bins are collapsed together
+    static constexpr size_t max_bins = 2048;
+
+    /// the reported quantiles are within this fraction of the true value
+    static double relative_accuracy() { return 0.01; }
+
+public:
+    //----------------------------------------------------------------------------------//
+    /// add a value to the sketch
+    void insert(double val, count_type n = 1)
+    {
+        if(!std::isfinite(val) || n == 0)
+            return;
+        if(std::fabs(val) < min_value())
+            m_zero += n;
+        else if(val > 0.0)
+            m_positive.add(index(val), n);
+        else
+            m_negative.add(index(-val), n);
+    }
+
+    //----------------------------------------------------------------------------------//
+    /// add the counts of another sketch
+    void merge(const quantile_sketch& rhs)
+    {
+        m_zero += rhs.m_zero;
+        m_positive.merge(rhs.m_positive);
+        m_negative.merge(rhs.m_negative);
+    }
+
+    //----------------------------------------------------------------------------------//
+    /// map each value x to (x * _scale + _shift). The values are re-binned from the
+    /// middle of their bin so each transform can add up to relative_accuracy() of error
+    void transform(double _scale, double _shift)
+    {
+        if(empty() || (_scale == 1.0 && _shift == 0.0))
+            return;
+
+        quantile_sketch _ret;
+        _ret.insert(_shift, m_zero);
+        for(size_t i = 0; i < m_positive.size(); ++i)
+        {
+            auto _val = value(m_positive.offset + static_cast<index_type>(i));
+            _ret.insert(_val * _scale + _shift, m_positive.bins[i]);
+        }
+        for(size_t i = 0; i < m_negative.size(); ++i)
+        {
+            auto _val = -value(m_negative.offset + static_cast<index_type>(i));
+            _ret.insert(_val * _scale + _shift, m_negative.bins[i]);
+        }
+        *this = std::move(_ret);
+    }
+
+    //----------------------------------------------------------------------------------//
+    /// the value at quantile _q (in [0, 1]), zero if the sketch is empty
+    double quantile(double _q) const
+    {
+        auto _n = count();
+        if(_n == 0)
+            return 0.0;
+
+        _q         = std::min<double>(std::max<double>(_q, 0.0), 1.0);
+        auto _rank = static_cast<count_type>(_q * (_n - 1));
+
+        // the negative values in descending order of magnitude, then zero, then the
+        // positive values in ascending order
+        count_type _sum = 0;
+        for(size_t i = m_negative.bins.size(); i > 0; --i)
+        {
+            _sum += m_negative.bins[i - 1];
+            if(_sum > _rank)
+                return -value(m_negative.offset + static_cast<index_type>(i - 1));
+        }
+
+        _sum += m_zero;
+        if(_sum > _rank)
+            return 0.0;
+
+        for(size_t i = 0; i < m_positive.bins.size(); ++i)
+        {
+            _sum += m_positive.bins[i];
+            if(_sum > _rank)
+                return value(m_positive.offset + static_cast<index_type>(i));
+        }
+
+        return value(m_positive.offset + static_cast<index_type>(m_positive.size()) - 1);
+    }
+
+    //----------------------------------------------------------------------------------//
+    /// the number of values in the sketch
+    count_type count() const { return m_zero + m_positive.count() + m_negative.count(); }
+
+    bool empty() const { return count() == 0; }
+
+    void reset()
+    {
+        m_zero = 0;
+        m_positive.reset();
+        m_negative.reset();
+    }
+
+    template <typename _Archive>
+    void serialize(_Archive& ar, const unsigned int)
+    {
+        ar(cereal::make_nvp("zero", m_zero),
+           cereal::make_nvp("offset", m_positive.offset),
+           cereal::make_nvp("bins", m_positive.bins),
+           cereal::make_nvp("negative_offset", m_negative.offset),
+           cereal::make_nvp("negative_bins", m_negative.bins));
+    }
+
+private:
+    //----------------------------------------------------------------------------------//
+    //  contiguous counts of the bins starting at the bin index "offset"
+    //
+    struct store
+    {
+        index_type              offset = 0;
+        std::vector<count_type> bins   = {};
+
+        size_t size() const { return bins.size(); }
+
+        count_type count() const
+        {
+            count_type _n = 0;
+            for(const auto& itr : bins)
+                _n += itr;
+            return _n;
+        }
+
+        void reset()
+        {
+            offset = 0;
+            bins.clear();
+        }
+
+        void add(index_type _idx, count_type _n)
+        {
+            if(bins.empty())
+            {
+                offset = _idx;
+                bins.assign(1, _n);
+                return;
+            }
+
+            if(_idx < offset)
+            {
+                auto _extra = static_cast<size_t>(offset - _idx);
+                if(size() + _extra > max_bins)
+                {
+                    // the range is full, the low values go into the lowest bin
+                    _extra = max_bins - size();
+                    _idx   = offset - static_cast<index_type>(_extra);
+                }
+                bins.insert(bins.begin(), _extra, 0);
+                offset -= static_cast<index_type>(_extra);
+            }
+            else if(_idx >= offset + static_cast<index_type>(size()))
+            {
+                bins.resize(static_cast<size_t>(_idx - offset) + 1, 0);
+                if(size() > max_bins)
+                    collapse(size() - max_bins);
+            }
+
+            bins[static_cast<size_t>(_idx - offset)] += _n;
+        }
+
+        void merge(const store& rhs)
+        {
+            for(size_t i = 0; i < rhs.size(); ++i)
+            {
+                if(rhs.bins[i] > 0)
+                    add(rhs.offset + static_cast<index_type>(i), rhs.bins[i]);
+            }
+        }
+
+        // fold the lowest _n bins into the bin above them
+        void collapse(size_t _n)
+        {
+            count_type _sum = 0;
+            for(size_t i = 0; i < _n; ++i)
+                _sum += bins[i];
+            bins.erase(bins.begin(), bins.begin() + _n);
+            bins.front() += _sum;
+            offset += static_cast<index_type>(_n);
+        }
+    };
+
+private:
+    static double gamma()
+    {
+        return (1.0 + relative_accuracy()) / (1.0 - relative_accuracy());
+    }
+
+    static double log_gamma()
+    {
+        static const double _value = std::log(gamma());
+        return _value;
+    }
+
+    // magnitudes below this are counted as zero
+    static double min_value() { return 1.0e-9; }
+
+    static index_type index(double _val)
+    {
+        return static_cast<index_type>(std::ceil(std::log(_val) / log_gamma()));
+    }
+
+    // the value in the middle of the bin, i.e. within relative_accuracy of every value
+    // counted in the bin
+    static double value(index_type _idx)
+    {
+        return 2.0 * std::pow(gamma(), _idx) / (gamma() + 1.0);
+    }
+
+private:
+    count_type m_zero     = 0;
+    store      m_positive = {};
+    store      m_negative = {};
+};
+
+//======================================================================================//
+
+}  // namespace tim
@@ -25,7 +25,9 @@
 
 /** \file timemory/data/statistics.hpp
  * \headerfile timemory/data/statistics.hpp "timemory/data/statistics.hpp"
- * This provides accumulation capabilities
+ * This provides accumulation capabilities. For arithmetic types, the mean and variance
+ * of the accumulated values (Welford's algorithm) and an estimate of their quantiles
+ * (see quantile_sketch.hpp) are also recorded
  *
  */
 
@@ -42,6 +44,7 @@
 #include <limits>
 
 #include "timemory/data/functional.hpp"
+#include "timemory/data/quantile_sketch.hpp"
 #include "timemory/mpl/math.hpp"
 #include "timemory/utility/macros.hpp"
 #include "timemory/utility/serializer.hpp"
@@ -57,6 +60,9 @@ public:
     using value_type   = _Tp;
     using compute_type = math::compute<_Tp>;
 
+    /// the mean, variance, and quantiles are only recorded for arithmetic types
+    static constexpr bool has_moments = std::is_arithmetic<_Tp>::value;
+
 public:
     inline statistics()                  = default;
     inline ~statistics()                 = default;
@@ -96,13 +102,36 @@ public:
     inline const value_type& get_min() const { return m_min; }
     inline const value_type& get_max() const { return m_max; }
     inline const value_type& get_sum() const { return m_sum; }
+    inline int64_t           get_count() const { return m_cnt; }
+
+    // Moments and quantiles of the accumulated values (zero when !has_moments)
+    inline double get_mean() const { return m_mean; }
+    inline double get_variance() const
+    {
+        return (m_cnt > 1) ? (m_m2 / static_cast<double>(m_cnt - 1)) : 0.0;
+    }
+    inline double get_stddev() const { return std::sqrt(get_variance()); }
+
+    /// the value at quantile _q in [0, 1], e.g. 0.5 for the median and 0.999 for p99.9
+    inline double get_quantile(double _q) const { return get_quantile(_q, m_min); }
+
+    inline const quantile_sketch& get_sketch() const { return m_sketch; }
 
     // Conversion
     inline operator const value_type&() const { return m_sum; }
     inline operator value_type&() { return m_sum; }
 
     // Modifications
-    inline void reset();
+    inline void reset()
+    {
+        m_cnt  = 0;
+        m_sum  = value_type();
+        m_min  = value_type();
+        m_max  = value_type();
+        m_mean = 0.0;
+        m_m2   = 0.0;
+        m_sketch.reset();
+    }
 
     inline statistics& get_min(const value_type& val)
     {
@@ -132,6 +161,7 @@ public:
             m_min = compute_type::min(m_min, val);
         m_max = compute_type::max(m_max, val);
         ++m_cnt;
+        update_moments(val);
         return *this;
     }
 
@@ -140,6 +170,7 @@ public:
         compute_type::minus(m_sum, val);
         compute_type::minus(m_min, val);
         compute_type::minus(m_max, val);
+        shift_moments(val);
         return *this;
     }
 
@@ -148,6 +179,7 @@ public:
         compute_type::multiply(m_sum, val);
         compute_type::multiply(m_min, val);
         compute_type::multiply(m_max, val);
+        scale_moments(val, false);
         return *this;
     }
 
@@ -156,6 +188,7 @@ public:
         compute_type::divide(m_sum, val);
         compute_type::divide(m_min, val);
         compute_type::divide(m_max, val);
+        scale_moments(val, true);
         return *this;
     }
 
@@ -169,16 +202,125 @@ public:
         else
             m_min = compute_type::min(m_min, rhs.m_min);
         m_max = compute_type::max(m_max, rhs.m_max);
+        merge_moments(rhs);
         m_cnt += rhs.m_cnt;
         return *this;
     }
 
+private:
+    //----------------------------------------------------------------------------------//
+    //  Welford's update of the mean and the sum of the squared deviations. Expects
+    //  m_cnt to include val
+    //
+    template <typename _Up = _Tp,
+              typename std::enable_if<std::is_arithmetic<_Up>::value, int>::type = 0>
+    inline void update_moments(const _Up& val)
+    {
+        auto _val   = static_cast<double>(val);
+        auto _delta = _val - m_mean;
+        m_mean += _delta / static_cast<double>(m_cnt);
+        m_m2 += _delta * (_val - m_mean);
+        m_sketch.insert(_val);
+    }
+
+    template <typename _Up = _Tp,
+              typename std::enable_if<!std::is_arithmetic<_Up>::value, int>::type = 0>
+    inline void update_moments(const _Up&)
+    {}
+
+    //----------------------------------------------------------------------------------//
+    //  the moments and the distribution after val was subtracted from each value
+    //
+    template <typename _Up = _Tp,
+              typename std::enable_if<std::is_arithmetic<_Up>::value, int>::type = 0>
+    inline void shift_moments(const _Up& val)
+    {
+        m_mean -= static_cast<double>(val);
+        m_sketch.transform(1.0, -static_cast<double>(val));
+    }
+
+    template <typename _Up = _Tp,
+              typename std::enable_if<!std::is_arithmetic<_Up>::value, int>::type = 0>
+    inline void shift_moments(const _Up&)
+    {}
+
+    //----------------------------------------------------------------------------------//
+    //  the moments and the distribution after each value was multiplied (or divided)
+    //  by val
+    //
+    template <typename _Up = _Tp,
+              typename std::enable_if<std::is_arithmetic<_Up>::value, int>::type = 0>
+    inline void scale_moments(const _Up& val, bool _divide)
+    {
+        auto _factor = static_cast<double>(val);
+        if(_divide)
+            _factor = 1.0 / _factor;
+        m_mean *= _factor;
+        m_m2 *= _factor * _factor;
+        m_sketch.transform(_factor, 0.0);
+    }
+
+    template <typename _Up = _Tp,
+              typename std::enable_if<!std::is_arithmetic<_Up>::value, int>::type = 0>
+    inline void scale_moments(const _Up&, bool)
+    {}
+
+    //----------------------------------------------------------------------------------//
+    //  pairwise combination of the mean and the sum of the squared deviations (Chan et
+    //  al.). Expects m_cnt to not include rhs.m_cnt yet
+    //
+    inline void merge_moments(const statistics& rhs)
+    {
+        if(rhs.m_cnt == 0)
+            return;
+        if(m_cnt == 0)
+        {
+            m_mean   = rhs.m_mean;
+            m_m2     = rhs.m_m2;
+            m_sketch = rhs.m_sketch;
+            return;
+        }
+        auto _na    = static_cast<double>(m_cnt);
+        auto _nb    = static_cast<double>(rhs.m_cnt);
+        auto _n     = _na + _nb;
+        auto _delta = rhs.m_mean - m_mean;
+        m_mean += _delta * _nb / _n;
+        m_m2 += rhs.m_m2 + _delta * _delta * _na * _nb / _n;
+        m_sketch.merge(rhs.m_sketch);
+    }
+
+    //----------------------------------------------------------------------------------//
+    //  the sketch is accurate to within 1%, the result is bounded by the exact min/max
+    //
+    template <typename _Up = _Tp,
+              typename std::enable_if<std::is_arithmetic<_Up>::value, int>::type = 0>
+    inline double get_quantile(double _q, const _Up&) const
+    {
+        if(m_sketch.empty())
+            return 0.0;
+        auto _val = m_sketch.quantile(_q);
+        _val      = std::max<double>(_val, static_cast<double>(m_min));
+        return std::min<double>(_val, static_cast<double>(m_max));
+    }
+
+    template <typename _Up = _Tp,
+              typename std::enable_if<!std::is_arithmetic<_Up>::value, int>::type = 0>
+    inline double get_quantile(double, const _Up&) const
+    {
+        return 0.0;
+    }
+
 private:
     // summation of each history^1
     int64_t    m_cnt = 0;
     value_type m_sum = value_type();
     value_type m_min = value_type();
     value_type m_max = value_type();
+    // mean and sum of the squared deviations from the mean of each history
+    double m_mean = 0.0;
+    double m_m2   = 0.0;
+    // estimate of the distribution of each history
+    quantile_sketch m_sketch = {};
 
 public:
     // friend operator for output
@@ -200,10 +342,37 @@ public:
     }
 
     template <typename _Archive>
-    void serialize(_Archive& ar, const unsigned int)
+    void save(_Archive& ar, const unsigned int) const
+    {
+        ar(cereal::make_nvp("sum", m_sum), cereal::make_nvp("min", m_min),
+           cereal::make_nvp("max", m_max));
+        if(!has_moments)
+            return;
+        ar(cereal::make_nvp("count", m_cnt), cereal::make_nvp("mean", m_mean),
+           cereal::make_nvp("stddev", get_stddev()),
+           cereal::make_nvp("p50", get_quantile(0.5)),
+           cereal::make_nvp("p99", get_quantile(0.99)),
+           cereal::make_nvp("p999", get_quantile(0.999)),
+           cereal::make_nvp("sketch", m_sketch));
+    }
+
+    template <typename _Archive>
+    void load(_Archive& ar, const unsigned int)
     {
         ar(cereal::make_nvp("sum", m_sum), cereal::make_nvp("min", m_min),
            cereal::make_nvp("max", m_max));
+        if(!has_moments)
+            return;
+        // the quantiles are re-computed from the sketch
+        double _stddev = 0.0;
+        double _p50    = 0.0;
+        double _p99    = 0.0;
+        double _p999   = 0.0;
+        ar(cereal::make_nvp("count", m_cnt), cereal::make_nvp("mean", m_mean),
+           cereal::make_nvp("stddev", _stddev), cereal::make_nvp("p50", _p50),
+           cereal::make_nvp("p99", _p99), cereal::make_nvp("p999", _p999),
+           cereal::make_nvp("sketch", m_sketch));
+        m_m2 = (m_cnt > 1) ? (_stddev * _stddev * static_cast<double>(m_cnt - 1)) : 0.0;
     }
 };
 
@@ -139,24 +139,26 @@ enum TIMEMORY_COMPONENT
     PAGE_RSS                 = 30,
     PAPI_ARRAY               = 31,
     PEAK_RSS                 = 32,
-    PRIORITY_CONTEXT_SWITCH  = 33,
-    PROCESS_CPU_CLOCK        = 34,
-    PROCESS_CPU_UTIL         = 35,
-    READ_BYTES               = 36,
-    STACK_RSS                = 37,
-    SYS_CLOCK                = 38,
-    TAU_MARKER               = 39,
-    THREAD_CPU_CLOCK         = 40,
-    THREAD_CPU_UTIL          = 41,
-    TRIP_COUNT               = 42,
-    USER_CLOCK               = 43,
-    USER_LIST_BUNDLE         = 44,
-    USER_TUPLE_BUNDLE        = 45,
-    VIRTUAL_MEMORY           = 46,
-    VOLUNTARY_CONTEXT_SWITCH = 47,
-    VTUNE_EVENT              = 48,
-    VTUNE_FRAME              = 49,
-    WALL_CLOCK               = 50,
-    WRITTEN_BYTES            = 51,
-    TIMEMORY_COMPONENTS_END  = 52
+    PERF_EVENT_ARRAY         = 33,
+    PRIORITY_CONTEXT_SWITCH  = 34,
+    PROCESS_CPU_CLOCK        = 35,
+    PROCESS_CPU_UTIL         = 36,
+    READ_BYTES               = 37,
+    STACK_RSS                = 38,
+    SYS_CLOCK                = 39,
+    TAU_MARKER               = 40,
+    THREAD_CPU_CLOCK         = 41,
+    THREAD_CPU_UTIL          = 42,
+    TRIP_COUNT               = 43,
+    TSC_CLOCK                = 44,
+    USER_CLOCK               = 45,
+    USER_LIST_BUNDLE         = 46,
+    USER_TUPLE_BUNDLE        = 47,
+    VIRTUAL_MEMORY           = 48,
+    VOLUNTARY_CONTEXT_SWITCH = 49,
+    VTUNE_EVENT              = 50,
+    VTUNE_FRAME              = 51,
+    WALL_CLOCK               = 52,
+    WRITTEN_BYTES            = 53,
+    TIMEMORY_COMPONENTS_END  = 54
 };
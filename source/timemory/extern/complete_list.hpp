@@ -58,12 +58,13 @@ TIMEMORY_DECLARE_EXTERN_LIST(
     ::tim::component::num_msg_sent, ::tim::component::num_signals,
     ::tim::component::num_swap, ::tim::component::nvtx_marker, ::tim::component::page_rss,
     ::tim::component::papi_array_t, ::tim::component::peak_rss,
-    ::tim::component::priority_context_switch, ::tim::component::process_cpu_clock,
-    ::tim::component::process_cpu_util, ::tim::component::read_bytes,
-    ::tim::component::wall_clock, ::tim::component::stack_rss,
-    ::tim::component::system_clock, ::tim::component::tau_marker,
-    ::tim::component::thread_cpu_clock, ::tim::component::thread_cpu_util,
-    ::tim::component::trip_count, ::tim::component::user_tuple_bundle,
+    ::tim::component::perf_event_array_t, ::tim::component::priority_context_switch,
+    ::tim::component::process_cpu_clock, ::tim::component::process_cpu_util,
+    ::tim::component::read_bytes, ::tim::component::wall_clock,
+    ::tim::component::stack_rss, ::tim::component::system_clock,
+    ::tim::component::tau_marker, ::tim::component::thread_cpu_clock,
+    ::tim::component::thread_cpu_util, ::tim::component::trip_count,
+    ::tim::component::tsc_clock, ::tim::component::user_tuple_bundle,
     ::tim::component::user_list_bundle, ::tim::component::user_clock,
     ::tim::component::virtual_memory, ::tim::component::voluntary_context_switch,
     ::tim::component::written_bytes)
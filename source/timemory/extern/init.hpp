@@ -89,6 +89,9 @@ TIMEMORY_DECLARE_EXTERN_INIT(page_rss)
 TIMEMORY_DECLARE_EXTERN_INIT(papi_array_t)
 #    endif
 TIMEMORY_DECLARE_EXTERN_INIT(peak_rss)
+#    if defined(_LINUX)
+TIMEMORY_DECLARE_EXTERN_INIT(perf_event_array_t)
+#    endif
 TIMEMORY_DECLARE_EXTERN_INIT(priority_context_switch)
 TIMEMORY_DECLARE_EXTERN_INIT(process_cpu_clock)
 TIMEMORY_DECLARE_EXTERN_INIT(process_cpu_util)
@@ -102,6 +105,7 @@ TIMEMORY_DECLARE_EXTERN_INIT(tau_marker)
 TIMEMORY_DECLARE_EXTERN_INIT(thread_cpu_clock)
 TIMEMORY_DECLARE_EXTERN_INIT(thread_cpu_util)
 TIMEMORY_DECLARE_EXTERN_INIT(trip_count)
+TIMEMORY_DECLARE_EXTERN_INIT(tsc_clock)
 TIMEMORY_DECLARE_EXTERN_INIT(user_tuple_bundle)
 TIMEMORY_DECLARE_EXTERN_INIT(user_list_bundle)
 TIMEMORY_DECLARE_EXTERN_INIT(user_clock)
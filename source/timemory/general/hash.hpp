@@ -35,7 +35,11 @@
 #include "timemory/settings.hpp"
 
 #include <array>
+#include <atomic>
 #include <cstddef>
+#include <cstdint>
+#include <iomanip>
+#include <limits>
 #include <ostream>
 #include <sstream>
 #include <string>
@@ -43,6 +47,17 @@
 #include <utility>
 #include <vector>
 
+//--------------------------------------------------------------------------------------//
+//  number of buckets in the process-wide hash tables (must be a power of two)
+//
+#if !defined(TIMEMORY_HASH_ID_BUCKETS)
+#    define TIMEMORY_HASH_ID_BUCKETS 4096
+#endif
+
+#if !defined(TIMEMORY_HASH_ALIAS_BUCKETS)
+#    define TIMEMORY_HASH_ALIAS_BUCKETS 16384
+#endif
+
 namespace tim
 {
 //--------------------------------------------------------------------------------------//
@@ -51,12 +66,272 @@ namespace tim
 //
 //--------------------------------------------------------------------------------------//
 
-using hash_result_type          = std::size_t;
-using graph_hash_map_t          = std::unordered_map<hash_result_type, std::string>;
-using graph_hash_alias_t        = std::unordered_map<hash_result_type, hash_result_type>;
-using graph_hash_map_ptr_t      = std::shared_ptr<graph_hash_map_t>;
-using graph_hash_map_ptr_pair_t = std::pair<graph_hash_map_ptr_t, graph_hash_map_ptr_t>;
-using graph_hash_alias_ptr_t    = std::shared_ptr<graph_hash_alias_t>;
+using hash_result_type = std::size_t;
+using hash_index_type  = uint32_t;
+
+//--------------------------------------------------------------------------------------//
+//
+//  64-bit FNV-1a which can be evaluated at compile-time. The std::string overload
+//  produces the identical value at runtime so the hash of a string literal
+//  computed by the compiler matches the hash of the same label built at runtime.
+//
+//--------------------------------------------------------------------------------------//
+
+namespace impl
+{
+constexpr hash_result_type fnv1a_offset = 14695981039346656037ULL;
+constexpr hash_result_type fnv1a_prime  = 1099511628211ULL;
+
+//--------------------------------------------------------------------------------------//
+
+constexpr hash_result_type
+fnv1a_char(char _c, hash_result_type _hash)
+{
+    return (_hash ^ static_cast<hash_result_type>(static_cast<unsigned char>(_c))) *
+           fnv1a_prime;
+}
+
+//--------------------------------------------------------------------------------------//
+
+constexpr hash_result_type
+fnv1a_str(const char* _str, hash_result_type _hash)
+{
+    return (!_str || *_str == '\0') ? _hash
+                                     : fnv1a_str(_str + 1, fnv1a_char(*_str, _hash));
+}
+
+//--------------------------------------------------------------------------------------//
+//  hashes the decimal representation of a non-negative integer, e.g. __LINE__
+//
+constexpr hash_result_type
+fnv1a_int(int _val, hash_result_type _hash)
+{
+    return (_val < 10) ? fnv1a_char(static_cast<char>('0' + _val), _hash)
+                       : fnv1a_char(static_cast<char>('0' + _val % 10),
+                                    fnv1a_int(_val / 10, _hash));
+}
+
+//--------------------------------------------------------------------------------------//
+//  returns the portion of the path following the last delimiter, e.g. __FILE__
+//
+constexpr const char*
+basename(const char* _str, char _delim, const char* _last)
+{
+    return (*_str == '\0')
+               ? _last
+               : basename(_str + 1, _delim, (*_str == _delim) ? _str + 1 : _last);
+}
+
+}  // namespace impl
+
+//--------------------------------------------------------------------------------------//
+
+constexpr hash_result_type
+get_hash(const char* _str, hash_result_type _seed = impl::fnv1a_offset)
+{
+    return impl::fnv1a_str(_str, _seed);
+}
+
+//--------------------------------------------------------------------------------------//
+
+inline hash_result_type
+get_hash(const std::string& _str, hash_result_type _seed = impl::fnv1a_offset)
+{
+    for(const auto& itr : _str)
+        _seed = impl::fnv1a_char(itr, _seed);
+    return _seed;
+}
+
+//--------------------------------------------------------------------------------------//
+//
+//  Append-only table shared by all threads. Entries are never modified or removed
+//  once they are published so find() is wait-free: it follows at most the length
+//  of one bucket chain. insert() is lock-free: a new entry is published with a
+//  single compare-and-swap on the head of the bucket. Each entry is assigned a
+//  small, stable integer index in the order of insertion.
+//
+//--------------------------------------------------------------------------------------//
+
+template <typename _Tp, size_t _Buckets>
+class interned_table
+{
+    static_assert((_Buckets & (_Buckets - 1)) == 0,
+                  "interned_table requires the number of buckets to be a power of two");
+
+public:
+    using this_type  = interned_table<_Tp, _Buckets>;
+    using key_type   = hash_result_type;
+    using index_type = hash_index_type;
+    using value_type = _Tp;
+
+    struct entry
+    {
+        entry(key_type _key, const value_type& _value, index_type _index, entry* _next)
+        : key(_key)
+        , index(_index)
+        , value(_value)
+        , next(_next)
+        {}
+
+        const key_type   key;
+        const index_type index;
+        const value_type value;
+        entry*           next;
+    };
+
+    using bucket_t = std::atomic<entry*>;
+    using slot_t   = std::atomic<entry*>;
+
+    // the index -> entry lookup is a sequence of segments that double in size
+    static constexpr size_t segment_base  = 1024;
+    static constexpr size_t segment_count = 32;
+
+public:
+    interned_table()
+    {
+        for(auto& itr : m_buckets)
+            itr.store(nullptr, std::memory_order_relaxed);
+        for(auto& itr : m_segments)
+            itr.store(nullptr, std::memory_order_relaxed);
+    }
+
+    // the entries live for the duration of the process
+    ~interned_table()                 = default;
+    interned_table(const this_type&) = delete;
+    interned_table(this_type&&)      = delete;
+    this_type& operator=(const this_type&) = delete;
+    this_type& operator=(this_type&&) = delete;
+
+public:
+    /// returns nullptr if the key has not been inserted
+    const entry* find(key_type _key) const
+    {
+        return find(m_buckets[bucket(_key)].load(std::memory_order_acquire), nullptr,
+                    _key);
+    }
+
+    /// returns the existing entry if the key was already inserted
+    const entry* insert(key_type _key, const value_type& _value)
+    {
+        auto&  _bucket = m_buckets[bucket(_key)];
+        entry* _head   = _bucket.load(std::memory_order_acquire);
+        auto   _found  = find(_head, nullptr, _key);
+        if(_found)
+            return _found;
+
+        auto _index = m_count.fetch_add(1, std::memory_order_relaxed);
+        auto _entry = new entry(_key, _value, _index, _head);
+        slot(_index).store(_entry, std::memory_order_release);
+
+        while(!_bucket.compare_exchange_weak(_entry->next, _entry,
+                                             std::memory_order_acq_rel,
+                                             std::memory_order_acquire))
+        {
+            // only the entries inserted since the last attempt need to be checked.
+            // If another thread won the race, the entry remains reachable through
+            // the index lookup so it is not deleted
+            _found = find(_entry->next, _head, _key);
+            if(_found)
+                return _found;
+            _head = _entry->next;
+        }
+        return _entry;
+    }
+
+    /// lookup by the small integer index. Returns nullptr if out of range
+    const entry* at(index_type _index) const
+    {
+        if(_index >= m_count.load(std::memory_order_acquire))
+            return nullptr;
+        size_t _seg = 0;
+        size_t _off = 0;
+        locate(_index, _seg, _off);
+        auto _slots = m_segments[_seg].load(std::memory_order_acquire);
+        return (_slots) ? _slots[_off].load(std::memory_order_acquire) : nullptr;
+    }
+
+    size_t size() const { return m_count.load(std::memory_order_acquire); }
+    bool   empty() const { return size() == 0; }
+
+    /// invoke the function with each entry in the order of insertion. Entries
+    /// which lost an insertion race with an identical key are skipped
+    template <typename _Func>
+    void for_each(_Func&& _func) const
+    {
+        auto _n = size();
+        for(size_t i = 0; i < _n; ++i)
+        {
+            auto _entry = at(i);
+            if(_entry && find(_entry->key) == _entry)
+                _func(*_entry);
+        }
+    }
+
+private:
+    static size_t bucket(key_type _key)
+    {
+        // mix the bits since the keys are sums and products of other hashes
+        uint64_t _val = _key;
+        _val ^= _val >> 33;
+        _val *= 0xff51afd7ed558ccdULL;
+        _val ^= _val >> 33;
+        return static_cast<size_t>(_val & (_Buckets - 1));
+    }
+
+    static const entry* find(const entry* _beg, const entry* _end, key_type _key)
+    {
+        for(auto itr = _beg; itr != _end; itr = itr->next)
+        {
+            if(itr->key == _key)
+                return itr;
+        }
+        return nullptr;
+    }
+
+    static void locate(size_t _index, size_t& _seg, size_t& _off)
+    {
+        size_t _q = _index / segment_base + 1;
+        _seg      = 0;
+        while(_q >>= 1)
+            ++_seg;
+        _off = _index - segment_base * ((size_t(1) << _seg) - 1);
+    }
+
+    slot_t& slot(size_t _index)
+    {
+        size_t _seg = 0;
+        size_t _off = 0;
+        locate(_index, _seg, _off);
+        auto _slots = m_segments[_seg].load(std::memory_order_acquire);
+        if(!_slots)
+        {
+            size_t _n   = segment_base << _seg;
+            auto   _new = new slot_t[_n];
+            for(size_t i = 0; i < _n; ++i)
+                _new[i].store(nullptr, std::memory_order_relaxed);
+            if(m_segments[_seg].compare_exchange_strong(_slots, _new,
+                                                        std::memory_order_acq_rel,
+                                                        std::memory_order_acquire))
+                _slots = _new;
+            else
+                delete[] _new;
+        }
+        return _slots[_off];
+    }
+
+private:
+    std::atomic<size_t>                             m_count{ 0 };
+    std::array<bucket_t, _Buckets>                  m_buckets;
+    std::array<std::atomic<slot_t*>, segment_count> m_segments;
+};
+
+//--------------------------------------------------------------------------------------//
+
+using graph_hash_map_t       = interned_table<std::string, TIMEMORY_HASH_ID_BUCKETS>;
+using graph_hash_alias_t =
+    interned_table<hash_result_type, TIMEMORY_HASH_ALIAS_BUCKETS>;
+using graph_hash_map_ptr_t   = graph_hash_map_t*;
+using graph_hash_alias_ptr_t = graph_hash_alias_t*;
 
 //--------------------------------------------------------------------------------------//
 
@@ -71,20 +346,22 @@ get_hash_aliases();
 #else
 
 //--------------------------------------------------------------------------------------//
-
+//  process-wide table of hash -> string. Intentionally never deleted.
+//
 inline graph_hash_map_ptr_t
 get_hash_ids()
 {
-    static thread_local auto _inst = get_shared_ptr_pair_instance<graph_hash_map_t>();
+    static graph_hash_map_ptr_t _inst = new graph_hash_map_t();
     return _inst;
 }
 
 //--------------------------------------------------------------------------------------//
-
+//  process-wide table of alias hash -> hash. Intentionally never deleted.
+//
 inline graph_hash_alias_ptr_t
 get_hash_aliases()
 {
-    static thread_local auto _inst = get_shared_ptr_pair_instance<graph_hash_alias_t>();
+    static graph_hash_alias_ptr_t _inst = new graph_hash_alias_t();
     return _inst;
 }
 
@@ -93,18 +370,16 @@ get_hash_aliases()
 //--------------------------------------------------------------------------------------//
 
 inline hash_result_type
-add_hash_id(graph_hash_map_ptr_t& _hash_map, const std::string& prefix)
+add_hash_id(graph_hash_map_ptr_t _hash_map, const std::string& prefix)
 {
-    hash_result_type _hash_id = std::hash<std::string>()(prefix.c_str());
-    if(_hash_map && _hash_map->find(_hash_id) == _hash_map->end())
+    hash_result_type _hash_id = get_hash(prefix);
+    if(_hash_map && !_hash_map->find(_hash_id))
     {
         if(settings::debug())
             printf("[%s@'%s':%i]> adding hash id: %s = %llu...\n", __FUNCTION__, __FILE__,
                    __LINE__, prefix.c_str(), (long long unsigned) _hash_id);
 
-        (*_hash_map)[_hash_id] = prefix;
-        if(_hash_map->bucket_count() < _hash_map->size())
-            _hash_map->rehash(_hash_map->size() + 10);
+        _hash_map->insert(_hash_id, prefix);
     }
     return _hash_id;
 }
@@ -114,8 +389,7 @@ add_hash_id(graph_hash_map_ptr_t& _hash_map, const std::string& prefix)
 inline hash_result_type
 add_hash_id(const std::string& prefix)
 {
-    static thread_local auto _hash_map = get_hash_ids();
-    return add_hash_id(_hash_map, prefix);
+    return add_hash_id(get_hash_ids(), prefix);
 }
 
 //--------------------------------------------------------------------------------------//
@@ -124,13 +398,8 @@ inline void
 add_hash_id(graph_hash_map_ptr_t _hash_map, graph_hash_alias_ptr_t _hash_alias,
             hash_result_type _hash_id, hash_result_type _alias_hash_id)
 {
-    if(_hash_alias->find(_alias_hash_id) == _hash_alias->end() &&
-       _hash_map->find(_hash_id) != _hash_map->end())
-    {
-        (*_hash_alias)[_alias_hash_id] = _hash_id;
-        if(_hash_alias->bucket_count() < _hash_alias->size())
-            _hash_alias->rehash(_hash_alias->size() + 10);
-    }
+    if(!_hash_alias->find(_alias_hash_id) && _hash_map->find(_hash_id))
+        _hash_alias->insert(_alias_hash_id, _hash_id);
 }
 
 //--------------------------------------------------------------------------------------//
@@ -141,38 +410,60 @@ add_hash_id(hash_result_type _hash_id, hash_result_type _alias_hash_id)
     add_hash_id(get_hash_ids(), get_hash_aliases(), _hash_id, _alias_hash_id);
 }
 
+//--------------------------------------------------------------------------------------//
+//  returns the small integer index of the hash (or alias of the hash). Returns the
+//  max value if the hash has not been added
+//
+inline hash_index_type
+get_hash_index(hash_result_type _hash_id)
+{
+    auto _entry = get_hash_ids()->find(_hash_id);
+    if(!_entry)
+    {
+        auto _alias = get_hash_aliases()->find(_hash_id);
+        if(_alias)
+            _entry = get_hash_ids()->find(_alias->value);
+    }
+    return (_entry) ? _entry->index : std::numeric_limits<hash_index_type>::max();
+}
+
 //--------------------------------------------------------------------------------------//
 
 inline std::string
 get_hash_identifier(graph_hash_map_ptr_t _hash_map, graph_hash_alias_ptr_t _hash_alias,
                     hash_result_type _hash_id)
 {
-    auto _map_itr   = _hash_map->find(_hash_id);
-    auto _alias_itr = _hash_alias->find(_hash_id);
+    auto _map_itr = _hash_map->find(_hash_id);
+    if(_map_itr)
+        return _map_itr->value;
 
-    if(_map_itr != _hash_map->end())
-        return _map_itr->second;
-    else if(_alias_itr != _hash_alias->end())
+    auto _alias_itr = _hash_alias->find(_hash_id);
+    if(_alias_itr)
     {
-        _map_itr = _hash_map->find(_alias_itr->second);
-        if(_map_itr != _hash_map->end())
-            return _map_itr->second;
+        _map_itr = _hash_map->find(_alias_itr->value);
+        if(_map_itr)
+            return _map_itr->value;
     }
 
     if(settings::verbose() > 0 || settings::debug())
     {
+        using map_entry_t   = graph_hash_map_t::entry;
+        using alias_entry_t = graph_hash_alias_t::entry;
+
         std::stringstream ss;
         ss << "Error! node with hash " << _hash_id
            << " did not have an associated prefix!\n";
         ss << "Hash map:\n";
         auto _w = 30;
-        for(const auto& itr : *_hash_map)
-            ss << "    " << std::setw(_w) << itr.first << " : " << (itr.second) << "\n";
+        _hash_map->for_each([&](const map_entry_t& itr) {
+            ss << "    " << std::setw(_w) << itr.key << " : " << itr.value << "\n";
+        });
         if(_hash_alias->size() > 0)
         {
             ss << "Alias hash map:\n";
-            for(const auto& itr : *_hash_alias)
-                ss << "    " << std::setw(_w) << itr.first << " : " << itr.second << "\n";
+            _hash_alias->for_each([&](const alias_entry_t& itr) {
+                ss << "    " << std::setw(_w) << itr.key << " : " << itr.value << "\n";
+            });
         }
         fprintf(stderr, "%s\n", ss.str().c_str());
     }
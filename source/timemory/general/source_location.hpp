@@ -69,15 +69,24 @@ public:
 
     //==================================================================================//
     //
+    //  the identifier is a reference to the string in the hash registry so copying
+    //  does not allocate
+    //
     struct captured
     {
     public:
-        const std::string&      get_id() const { return std::get<0>(m_result); }
-        const hash_result_type& get_hash() const { return std::get<1>(m_result); }
-        const result_type&      get() const { return m_result; }
+        const std::string&      get_id() const { return (m_id) ? *m_id : empty_id(); }
+        const hash_result_type& get_hash() const { return m_hash; }
+        result_type             get() const { return result_type(get_id(), m_hash); }
 
         explicit captured(const result_type& _result)
-        : m_result(_result)
+        : m_hash(std::get<1>(_result))
+        , m_id(&get_interned(m_hash, [&]() { return std::get<0>(_result); }))
+        {}
+
+        captured(hash_result_type _hash, const std::string& _interned)
+        : m_hash(_hash)
+        , m_id(&_interned)
         {}
 
         captured()  = default;
@@ -91,28 +100,36 @@ public:
 
     protected:
         friend class source_location;
-        result_type m_result = result_type("", 0);
+        hash_result_type   m_hash = 0;
+        const std::string* m_id   = nullptr;
+
+        static const std::string& empty_id()
+        {
+            static std::string _instance = "";
+            return _instance;
+        }
 
         template <typename... _Args>
         captured& set(const source_location& obj, _Args&&... _args)
         {
+            std::string _tmp = "";
             switch(obj.m_mode)
             {
                 case mode::blank:
                 {
-                    auto&& _tmp = join_type::join("", std::forward<_Args>(_args)...);
-                    m_result    = result_type(_tmp, add_hash_id(_tmp));
+                    _tmp = join_type::join("", std::forward<_Args>(_args)...);
                     break;
                 }
                 case mode::basic:
                 case mode::full:
                 {
                     auto&& _suffix = join_type::join("", std::forward<_Args>(_args)...);
-                    auto   _tmp    = join_type::join("/", obj.m_prefix.c_str(), _suffix);
-                    m_result       = result_type(_tmp, add_hash_id(_tmp));
+                    _tmp           = join_type::join("/", obj.m_prefix.c_str(), _suffix);
                     break;
                 }
             }
+            m_hash = ::tim::get_hash(_tmp);
+            m_id   = &get_interned(m_hash, [&]() { return _tmp; });
             return *this;
         }
     };
@@ -132,6 +149,83 @@ public:
         return _loc.get_captured(std::forward<_Args>(_args)...);
     }
 
+    //==================================================================================//
+    //  overloads used by the macros where the hash of the function, file, and line
+    //  is computed at compile-time. The label is only built the first time the
+    //  hash is encountered by the process
+    //
+    template <hash_result_type _PrefixHash, typename... _Args>
+    static captured get_captured_inline(const mode& _mode, const char* _func, int _line,
+                                        const char* _fname, _Args&&... _args)
+    {
+        return get_captured_inline(_mode, _func, _line, _fname,
+                                   std::forward<_Args>(_args)...);
+    }
+
+    template <hash_result_type _PrefixHash>
+    static captured get_captured_inline(const mode& _mode, const char* _func, int _line,
+                                        const char* _fname, const char* _arg)
+    {
+        auto _hash = get_label_hash(_mode, _PrefixHash, _arg);
+        return captured(_hash, get_interned(_hash, [&]() {
+                            return get_label(_mode, _func, _line, _fname, _arg);
+                        }));
+    }
+
+    template <hash_result_type _PrefixHash>
+    static captured get_captured_inline(const mode& _mode, const char* _func, int _line,
+                                        const char* _fname, const char* _arg1,
+                                        const char* _arg2)
+    {
+        auto _hash = get_label_hash(_mode, _PrefixHash, _arg1, _arg2);
+        return captured(_hash, get_interned(_hash, [&]() {
+                            return get_label(_mode, _func, _line, _fname, _arg1, _arg2);
+                        }));
+    }
+
+    //==================================================================================//
+    //  hash of "" (blank), "<func>" (basic), or "<func>@<file>:<line>" (full)
+    //
+    static constexpr hash_result_type get_prefix_hash(mode _mode, const char* _func,
+                                                      int _line, const char* _fname)
+    {
+        return (_mode == mode::blank)
+                   ? impl::fnv1a_offset
+                   : (_mode == mode::basic) ? ::tim::get_hash(_func)
+                                            : get_full_hash(_func, _line, _fname);
+    }
+
+    static constexpr hash_result_type get_full_hash(const char* _func, int _line,
+                                                    const char* _fname)
+    {
+        using impl::fnv1a_char;
+        return impl::fnv1a_int(
+            _line, fnv1a_char(':', ::tim::get_hash(
+                                       get_basename(_fname),
+                                       fnv1a_char('@', ::tim::get_hash(_func)))));
+    }
+
+    //==================================================================================//
+    //  hash of the prefix joined with the argument(s)
+    //
+    static constexpr hash_result_type get_label_hash(mode _mode, hash_result_type _prefix,
+                                                     const char* _arg)
+    {
+        return (_mode == mode::blank)
+                   ? ::tim::get_hash(_arg, _prefix)
+                   : (!_arg || *_arg == '\0')
+                         ? _prefix
+                         : ::tim::get_hash(_arg, impl::fnv1a_char('/', _prefix));
+    }
+
+    static constexpr hash_result_type get_label_hash(mode _mode, hash_result_type _prefix,
+                                                     const char* _arg1, const char* _arg2)
+    {
+        return (_mode == mode::blank || (_arg1 && *_arg1 != '\0'))
+                   ? ::tim::get_hash(_arg2, get_label_hash(_mode, _prefix, _arg1))
+                   : get_label_hash(_mode, _prefix, _arg2);
+    }
+
 public:
     //
     //  Constructors, destructors, etc.
@@ -159,34 +253,11 @@ public:
                     const char* _arg)
     : m_mode(_mode)
     {
-        switch(m_mode)
-        {
-            case mode::blank:
-            {
-                // label and hash
-                auto&& _label = std::string(_arg);
-                auto&& _hash  = add_hash_id(_label);
-                m_captured    = captured(result_type{ _label, _hash });
-                break;
-            }
-            case mode::basic:
-            {
-                compute_data(_func);
-                auto&& _label = (_arg) ? _join(_arg) : std::string(m_prefix);
-                auto&& _hash  = add_hash_id(_label);
-                m_captured    = captured(result_type{ _label, _hash });
-                break;
-            }
-            case mode::full:
-            {
-                compute_data(_func, _line, _fname);
-                // label and hash
-                auto&& _label = (_arg) ? _join(_arg) : std::string(m_prefix);
-                auto&& _hash  = add_hash_id(_label);
-                m_captured    = captured(result_type{ _label, _hash });
-                break;
-            }
-        }
+        auto _hash =
+            get_label_hash(_mode, get_prefix_hash(_mode, _func, _line, _fname), _arg);
+        m_captured = captured(_hash, get_interned(_hash, [&]() {
+                                  return get_label(_mode, _func, _line, _fname, _arg);
+                              }));
     }
 
     //----------------------------------------------------------------------------------//
@@ -196,35 +267,12 @@ public:
                     const char* _arg1, const char* _arg2)
     : m_mode(_mode)
     {
-        const char* _arg = join_type::join("", _arg1, _arg2).c_str();
-        switch(m_mode)
-        {
-            case mode::blank:
-            {
-                // label and hash
-                auto&& _label = std::string(_arg);
-                auto&& _hash  = add_hash_id(_label);
-                m_captured    = captured(result_type{ _label, _hash });
-                break;
-            }
-            case mode::basic:
-            {
-                compute_data(_func);
-                auto&& _label = _join(_arg);
-                auto&& _hash  = add_hash_id(_label);
-                m_captured    = captured(result_type{ _label, _hash });
-                break;
-            }
-            case mode::full:
-            {
-                compute_data(_func, _line, _fname);
-                // label and hash
-                auto&& _label = _join(_arg);
-                auto&& _hash  = add_hash_id(_label);
-                m_captured    = captured(result_type{ _label, _hash });
-                break;
-            }
-        }
+        auto _hash = get_label_hash(_mode, get_prefix_hash(_mode, _func, _line, _fname),
+                                    _arg1, _arg2);
+        m_captured = captured(_hash, get_interned(_hash, [&]() {
+                                  return get_label(_mode, _func, _line, _fname, _arg1,
+                                                   _arg2);
+                              }));
     }
 
     //----------------------------------------------------------------------------------//
@@ -237,6 +285,17 @@ public:
     source_location& operator=(source_location&&) = default;
 
 protected:
+    //----------------------------------------------------------------------------------//
+    //
+    static constexpr const char* get_basename(const char* _fname)
+    {
+#if defined(_WINDOWS)
+        return impl::basename(_fname, '\\', _fname);
+#else
+        return impl::basename(_fname, '/', _fname);
+#endif
+    }
+
     //----------------------------------------------------------------------------------//
     //
     void compute_data(const char* _func) { m_prefix = _func; }
@@ -245,15 +304,44 @@ protected:
     //
     void compute_data(const char* _func, int _line, const char* _fname)
     {
-#if defined(_WINDOWS)
-        static const char delim = '\\';
-#else
-        static const char delim = '/';
-#endif
-        std::string _filename(_fname);
-        if(_filename.find(delim) != std::string::npos)
-            _filename = _filename.substr(_filename.find_last_of(delim) + 1).c_str();
-        m_prefix = join_type::join("", _func, "@", _filename, ":", _line);
+        m_prefix = join_type::join("", _func, "@", get_basename(_fname), ":", _line);
+    }
+
+    //----------------------------------------------------------------------------------//
+    //  the string equivalent of get_label_hash
+    //
+    static std::string get_label(const mode& _mode, const char* _func, int _line,
+                                 const char* _fname, const char* _arg1,
+                                 const char* _arg2 = nullptr)
+    {
+        std::string _arg = std::string((_arg1) ? _arg1 : "") + ((_arg2) ? _arg2 : "");
+        if(_mode == mode::blank)
+            return _arg;
+
+        std::string _prefix = _func;
+        if(_mode == mode::full)
+            _prefix = join_type::join("", _func, "@", get_basename(_fname), ":", _line);
+        return (_arg.empty()) ? _prefix : join_type::join("/", _prefix.c_str(), _arg);
+    }
+
+    //----------------------------------------------------------------------------------//
+    //  returns the string registered for the hash. The label is only generated if
+    //  the hash has not been registered
+    //
+    template <typename _Func>
+    static const std::string& get_interned(hash_result_type _hash, _Func&& _get_label)
+    {
+        auto _hash_ids = get_hash_ids();
+        auto _entry    = _hash_ids->find(_hash);
+        if(!_entry)
+        {
+            auto _label = _get_label();
+            if(settings::debug())
+                printf("[%s@'%s':%i]> adding hash id: %s = %llu...\n", __FUNCTION__,
+                       __FILE__, __LINE__, _label.c_str(), (long long unsigned) _hash);
+            _entry = _hash_ids->insert(_hash, _label);
+        }
+        return _entry->value;
     }
 
 public:
@@ -279,13 +367,6 @@ private:
     mode        m_mode;
     std::string m_prefix = "";
     captured    m_captured;
-
-private:
-    std::string _join(const char* _arg)
-    {
-        return (strcmp(_arg, "") == 0) ? m_prefix
-                                       : join_type::join("/", m_prefix.c_str(), _arg);
-    }
 };
 
 }  // namespace tim
@@ -302,8 +383,12 @@ private:
 
 #    define TIMEMORY_CAPTURE_ARGS(...) _AUTO_LOCATION(__LINE__).get_captured(__VA_ARGS__)
 
+#    define _TIM_SRC_LOCATION_HASH(MODE)                                                 \
+        ::tim::source_location::get_prefix_hash(TIMEMORY_CAPTURE_MODE(MODE),            \
+                                                __FUNCTION__, __LINE__, __FILE__)
+
 #    define TIMEMORY_INLINE_SOURCE_LOCATION(MODE, ...)                                   \
-        ::tim::source_location::get_captured_inline(                                     \
+        ::tim::source_location::get_captured_inline<_TIM_SRC_LOCATION_HASH(MODE)>(       \
             TIMEMORY_CAPTURE_MODE(MODE), __FUNCTION__, __LINE__, __FILE__, __VA_ARGS__)
 
 #    define _TIM_STATIC_SRC_LOCATION(MODE, ...)                                          \
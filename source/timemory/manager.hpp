@@ -113,6 +113,11 @@ public:
         m_json_files[_label].insert(_file);
     }
 
+    void add_binary_output(const string_t& _label, const string_t& _file)
+    {
+        m_binary_files[_label].insert(_file);
+    }
+
     void    write_metadata(const char* = "");
     int32_t get_rank() const { return m_rank; }
 
@@ -200,7 +205,7 @@ private:
         {
             auto ret = storage_type::noninit_instance();
             if(ret)
-                ret->data().reset();
+                ret->reset();
 
             if(settings::debug())
                 printf("[%s]> pointer: %p. has storage: %s. empty: %s...\n",
@@ -441,6 +446,7 @@ private:
     auto_lock_t*           m_lock = nullptr;
     strmap_t               m_text_files;
     strmap_t               m_json_files;
+    strmap_t               m_binary_files;
 
 private:
     /// num-threads based on number of managers created
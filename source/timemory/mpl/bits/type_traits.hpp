@@ -75,6 +75,10 @@ template <>
 struct is_timing_category<component::process_cpu_clock> : std::true_type
 {};
 
+template <>
+struct is_timing_category<component::tsc_clock> : std::true_type
+{};
+
 template <>
 struct is_timing_category<component::cuda_event> : std::true_type
 {};
@@ -195,6 +199,10 @@ template <>
 struct uses_timing_units<component::process_cpu_clock> : std::true_type
 {};
 
+template <>
+struct uses_timing_units<component::tsc_clock> : std::true_type
+{};
+
 template <>
 struct uses_timing_units<component::cuda_event> : std::true_type
 {};
@@ -255,5 +263,137 @@ template <>
 struct uses_percent_units<component::thread_cpu_util> : std::true_type
 {};
 
+//--------------------------------------------------------------------------------------//
+//
+//                              USES RUSAGE SNAPSHOT
+//
+//--------------------------------------------------------------------------------------//
+
+template <>
+struct uses_rusage_snapshot<component::peak_rss> : std::true_type
+{};
+
+template <>
+struct uses_rusage_snapshot<component::page_rss> : std::true_type
+{};
+
+template <>
+struct uses_rusage_snapshot<component::stack_rss> : std::true_type
+{};
+
+template <>
+struct uses_rusage_snapshot<component::data_rss> : std::true_type
+{};
+
+template <>
+struct uses_rusage_snapshot<component::num_swap> : std::true_type
+{};
+
+template <>
+struct uses_rusage_snapshot<component::num_io_in> : std::true_type
+{};
+
+template <>
+struct uses_rusage_snapshot<component::num_io_out> : std::true_type
+{};
+
+template <>
+struct uses_rusage_snapshot<component::num_minor_page_faults> : std::true_type
+{};
+
+template <>
+struct uses_rusage_snapshot<component::num_major_page_faults> : std::true_type
+{};
+
+template <>
+struct uses_rusage_snapshot<component::num_msg_sent> : std::true_type
+{};
+
+template <>
+struct uses_rusage_snapshot<component::num_msg_recv> : std::true_type
+{};
+
+template <>
+struct uses_rusage_snapshot<component::num_signals> : std::true_type
+{};
+
+template <>
+struct uses_rusage_snapshot<component::voluntary_context_switch> : std::true_type
+{};
+
+template <>
+struct uses_rusage_snapshot<component::priority_context_switch> : std::true_type
+{};
+
+template <>
+struct uses_rusage_snapshot<component::read_bytes> : std::true_type
+{};
+
+template <>
+struct uses_rusage_snapshot<component::written_bytes> : std::true_type
+{};
+
+template <>
+struct uses_rusage_snapshot<component::virtual_memory> : std::true_type
+{};
+
+//--------------------------------------------------------------------------------------//
+//
+//                              USES CLOCK SNAPSHOT
+//
+//--------------------------------------------------------------------------------------//
+
+template <>
+struct uses_clock_snapshot<component::wall_clock> : std::true_type
+{};
+
+template <>
+struct uses_clock_snapshot<component::system_clock> : std::true_type
+{};
+
+template <>
+struct uses_clock_snapshot<component::user_clock> : std::true_type
+{};
+
+template <>
+struct uses_clock_snapshot<component::cpu_clock> : std::true_type
+{};
+
+template <>
+struct uses_clock_snapshot<component::monotonic_clock> : std::true_type
+{};
+
+template <>
+struct uses_clock_snapshot<component::monotonic_raw_clock> : std::true_type
+{};
+
+template <>
+struct uses_clock_snapshot<component::thread_cpu_clock> : std::true_type
+{};
+
+template <>
+struct uses_clock_snapshot<component::process_cpu_clock> : std::true_type
+{};
+
+template <>
+struct uses_clock_snapshot<component::cpu_util> : std::true_type
+{};
+
+template <>
+struct uses_clock_snapshot<component::process_cpu_util> : std::true_type
+{};
+
+template <>
+struct uses_clock_snapshot<component::thread_cpu_util> : std::true_type
+{};
+
+template <>
+struct uses_clock_snapshot<component::read_bytes> : std::true_type
+{};
+
+template <>
+struct uses_clock_snapshot<component::written_bytes> : std::true_type
+{};
+
 }  // namespace trait
 }  // namespace tim
@@ -567,6 +567,16 @@ using modifiers =
 template <typename... Types>
 using filter_gotchas = impl::filter_false<trait::is_gotcha, std::tuple<Types...>>;
 
+/// filter out any types that do not read getrusage or /proc/<pid>
+template <typename... Types>
+using filter_rusage_snapshot =
+    impl::filter_false<trait::uses_rusage_snapshot, std::tuple<Types...>>;
+
+/// filter out any types that do not read a clock
+template <typename... Types>
+using filter_clock_snapshot =
+    impl::filter_false<trait::uses_clock_snapshot, std::tuple<Types...>>;
+
 //======================================================================================//
 //
 //      {auto,component}_{hybrid,list,tuple} get() and get_labeled() types
@@ -236,12 +236,29 @@ struct split_serialization : std::false_type
 {};
 
 //--------------------------------------------------------------------------------------//
-/// trait that signifies the component will accumulate a min/max
+/// trait that signifies the component will accumulate a min/max. For arithmetic value
+/// types, the mean, standard deviation, and quantiles of the laps are also recorded
 ///
 template <typename _Tp>
 struct record_statistics : std::false_type
 {};
 
+//--------------------------------------------------------------------------------------//
+/// trait that signifies the component reads getrusage or /proc/<pid> and can share a
+/// single snapshot of those values with the other components of a bundle
+///
+template <typename _Tp>
+struct uses_rusage_snapshot : std::false_type
+{};
+
+//--------------------------------------------------------------------------------------//
+/// trait that signifies the component reads one or more clocks and can share a single
+/// sample of each clock with the other components of a bundle
+///
+template <typename _Tp>
+struct uses_clock_snapshot : std::false_type
+{};
+
 //--------------------------------------------------------------------------------------//
 
 template <typename _Trait>
@@ -373,6 +390,10 @@ struct array_serialization<component::cupti_counters> : std::true_type
 {};
 #endif
 
+template <std::size_t MaxNumEvents>
+struct array_serialization<component::perf_event_array<MaxNumEvents>> : std::true_type
+{};
+
 //--------------------------------------------------------------------------------------//
 //
 //                              START PRIORITY
@@ -604,6 +625,21 @@ struct supports_custom_record<component::cpu_roofline<_Types...>> : std::true_ty
 
 #endif  // TIMEMORY_USE_PAPI
 
+//--------------------------------------------------------------------------------------//
+//
+//                              PERF_EVENT
+//
+//--------------------------------------------------------------------------------------//
+//  disable if not Linux (perf_event_open)
+//
+#if !defined(_LINUX)
+
+template <std::size_t MaxNumEvents>
+struct is_available<component::perf_event_array<MaxNumEvents>> : std::false_type
+{};
+
+#endif
+
 //--------------------------------------------------------------------------------------//
 //
 //                              CUDA
@@ -152,6 +152,7 @@ configure(const TIMEMORY_COMPONENT& comp)
         case PAGE_RSS: _Bundle::template configure<page_rss>(); break;
         case PAPI_ARRAY: _Bundle::template configure<papi_array_t>(); break;
         case PEAK_RSS: _Bundle::template configure<peak_rss>(); break;
+        case PERF_EVENT_ARRAY: _Bundle::template configure<perf_event_array_t>(); break;
         case PRIORITY_CONTEXT_SWITCH:
             _Bundle::template configure<priority_context_switch>();
             break;
@@ -164,6 +165,7 @@ configure(const TIMEMORY_COMPONENT& comp)
         case THREAD_CPU_CLOCK: _Bundle::template configure<thread_cpu_clock>(); break;
         case THREAD_CPU_UTIL: _Bundle::template configure<thread_cpu_util>(); break;
         case TRIP_COUNT: _Bundle::template configure<trip_count>(); break;
+        case TSC_CLOCK: _Bundle::template configure<tsc_clock>(); break;
         case USER_CLOCK: _Bundle::template configure<user_clock>(); break;
         case USER_LIST_BUNDLE: _Bundle::template configure<user_list_bundle>(); break;
         case USER_TUPLE_BUNDLE: _Bundle::template configure<user_tuple_bundle>(); break;
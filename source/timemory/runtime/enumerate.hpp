@@ -143,6 +143,10 @@ enumerate_component(std::string itr)
         _instance["papi_array"]               = PAPI_ARRAY;
         _instance["papi_array_t"]             = PAPI_ARRAY;
         _instance["peak_rss"]                 = PEAK_RSS;
+        _instance["perf"]                     = PERF_EVENT_ARRAY;
+        _instance["perf_event"]               = PERF_EVENT_ARRAY;
+        _instance["perf_event_array"]         = PERF_EVENT_ARRAY;
+        _instance["perf_event_array_t"]       = PERF_EVENT_ARRAY;
         _instance["priority_context_switch"]  = PRIORITY_CONTEXT_SWITCH;
         _instance["process_cpu_clock"]        = PROCESS_CPU_CLOCK;
         _instance["process_cpu_util"]         = PROCESS_CPU_UTIL;
@@ -155,6 +159,7 @@ enumerate_component(std::string itr)
         _instance["thread_cpu_clock"]         = THREAD_CPU_CLOCK;
         _instance["thread_cpu_util"]          = THREAD_CPU_UTIL;
         _instance["trip_count"]               = TRIP_COUNT;
+        _instance["tsc_clock"]                = TSC_CLOCK;
         _instance["user_clock"]               = USER_CLOCK;
         _instance["user_list_bundle"]         = USER_LIST_BUNDLE;
         _instance["user_tuple_bundle"]        = USER_TUPLE_BUNDLE;
@@ -187,13 +192,15 @@ enumerate_component(std::string itr)
             "'monotonic_clock', 'monotonic_raw_clock', 'num_io_in', 'num_io_out', "
             "'num_major_page_faults', 'num_minor_page_faults', 'num_msg_recv', "
             "'num_msg_sent', 'num_signals', 'num_swap', 'nvtx', 'nvtx_marker', "
-            "'page_rss', 'papi', 'papi_array', 'papi_array_t', 'peak_rss', "
+            "'page_rss', 'papi', 'papi_array', 'papi_array_t', 'peak_rss', 'perf', "
+            "'perf_event', 'perf_event_array', 'perf_event_array_t', "
             "'priority_context_switch', 'process_cpu_clock', 'process_cpu_util', "
             "'read_bytes', 'real_clock', 'stack_rss', 'sys_clock', 'system_clock', "
             "'tau', 'tau_marker', 'thread_cpu_clock', 'thread_cpu_util', 'trip_count', "
-            "'user_clock', 'user_list_bundle', 'user_tuple_bundle', 'virtual_clock', "
-            "'virtual_memory', 'voluntary_context_switch', 'vtune_event', 'vtune_frame', "
-            "'wall_clock', 'write_bytes', 'written_bytes']\n",
+            "'tsc_clock', 'user_clock', 'user_list_bundle', 'user_tuple_bundle', "
+            "'virtual_clock', 'virtual_memory', 'voluntary_context_switch', "
+            "'vtune_event', 'vtune_frame', 'wall_clock', 'write_bytes', "
+            "'written_bytes']\n",
             itr.c_str());
     };
 
@@ -204,7 +211,10 @@ enumerate_component(std::string itr)
 
     auto _eitr = _hashmap.find(itr);
     if(_eitr == _hashmap.end())
+    {
         errmsg(itr);
+        return TIMEMORY_COMPONENTS_END;
+    }
 
     return _eitr->second;
 }
@@ -33,9 +33,13 @@
 
 #include "timemory/components/types.hpp"
 #include "timemory/enum.h"
+#include "timemory/mpl/stl_overload.hpp"
+#include "timemory/mpl/type_traits.hpp"
 #include "timemory/runtime/enumerate.hpp"
 #include "timemory/runtime/types.hpp"
 
+#include <array>
+#include <bitset>
 #include <unordered_map>
 
 namespace tim
@@ -127,6 +131,7 @@ initialize(const TIMEMORY_COMPONENT& comp, _CompList<_CompTypes...>& obj)
         case PAGE_RSS: obj.template init<page_rss>(); break;
         case PAPI_ARRAY: obj.template init<papi_array_t>(); break;
         case PEAK_RSS: obj.template init<peak_rss>(); break;
+        case PERF_EVENT_ARRAY: obj.template init<perf_event_array_t>(); break;
         case PRIORITY_CONTEXT_SWITCH: obj.template init<priority_context_switch>(); break;
         case PROCESS_CPU_CLOCK: obj.template init<process_cpu_clock>(); break;
         case PROCESS_CPU_UTIL: obj.template init<process_cpu_util>(); break;
@@ -137,6 +142,7 @@ initialize(const TIMEMORY_COMPONENT& comp, _CompList<_CompTypes...>& obj)
         case THREAD_CPU_CLOCK: obj.template init<thread_cpu_clock>(); break;
         case THREAD_CPU_UTIL: obj.template init<thread_cpu_util>(); break;
         case TRIP_COUNT: obj.template init<trip_count>(); break;
+        case TSC_CLOCK: obj.template init<tsc_clock>(); break;
         case USER_CLOCK: obj.template init<user_clock>(); break;
         case USER_LIST_BUNDLE: obj.template init<user_list_bundle>(); break;
         case USER_TUPLE_BUNDLE: obj.template init<user_tuple_bundle>(); break;
@@ -153,6 +159,144 @@ initialize(const TIMEMORY_COMPONENT& comp, _CompList<_CompTypes...>& obj)
     }
 }
 
+//--------------------------------------------------------------------------------------//
+//
+//                  table of init functions indexed by enumeration
+//
+//--------------------------------------------------------------------------------------//
+
+namespace impl
+{
+//--------------------------------------------------------------------------------------//
+//  each entry initializes the type of the enumeration directly
+//
+template <size_t _Idx, typename _CompList,
+          typename _Tp = typename component::enumerator<
+              static_cast<TIMEMORY_COMPONENT>(_Idx)>::type,
+          typename std::enable_if<(trait::is_available<_Tp>::value), int>::type = 0>
+void
+initialize_enum(_CompList& obj)
+{
+    obj.template init<_Tp>();
+}
+
+//--------------------------------------------------------------------------------------//
+//  unavailable types and placeholders are not initialized
+//
+template <size_t _Idx, typename _CompList,
+          typename _Tp = typename component::enumerator<
+              static_cast<TIMEMORY_COMPONENT>(_Idx)>::type,
+          typename std::enable_if<!(trait::is_available<_Tp>::value), long>::type = 0>
+void
+initialize_enum(_CompList&)
+{}
+
+//--------------------------------------------------------------------------------------//
+
+template <typename _CompList, size_t... _Idx>
+const std::array<void (*)(_CompList&), sizeof...(_Idx)>&
+get_initialize_table(index_sequence<_Idx...>)
+{
+    static const std::array<void (*)(_CompList&), sizeof...(_Idx)> _instance = {
+        { &initialize_enum<_Idx, _CompList>... }
+    };
+    return _instance;
+}
+
+}  // namespace impl
+
+//--------------------------------------------------------------------------------------//
+
+template <typename _CompList>
+const std::array<void (*)(_CompList&), TIMEMORY_COMPONENTS_END>&
+get_initialize_table()
+{
+    return impl::get_initialize_table<_CompList>(
+        make_index_sequence<TIMEMORY_COMPONENTS_END>{});
+}
+
+//--------------------------------------------------------------------------------------//
+//
+//                  precompiled set of components for initialization
+//
+//--------------------------------------------------------------------------------------//
+
+template <typename _CompList>
+class component_set
+{
+public:
+    using size_type    = std::size_t;
+    using init_func_t  = void (*)(_CompList&);
+    using mask_type    = std::bitset<TIMEMORY_COMPONENTS_END>;
+    using init_array_t = std::array<init_func_t, TIMEMORY_COMPONENTS_END>;
+
+    component_set() = default;
+
+    explicit component_set(const std::string& components)
+    {
+        for(const auto& itr : enumerate_components(tim::delimit(components)))
+            insert(itr);
+    }
+
+    template <template <typename, typename...> class _Container, typename _Intp,
+              typename... _ExtraArgs,
+              typename std::enable_if<
+                  (std::is_integral<_Intp>::value && !std::is_same<_Intp, char>::value) ||
+                      std::is_same<_Intp, TIMEMORY_COMPONENT>::value,
+                  int>::type = 0>
+    explicit component_set(const _Container<_Intp, _ExtraArgs...>& components)
+    {
+        for(const auto& itr : components)
+            insert(static_cast<TIMEMORY_COMPONENT>(itr));
+    }
+
+    component_set(const int ncomponents, const int* components)
+    {
+        for(int i = 0; i < ncomponents; ++i)
+            insert(static_cast<TIMEMORY_COMPONENT>(components[i]));
+    }
+
+    /// add a component, duplicates and invalid enumerations are ignored
+    void insert(TIMEMORY_COMPONENT comp)
+    {
+        auto _idx = static_cast<int>(comp);
+        if(_idx < 0 || _idx >= TIMEMORY_COMPONENTS_END || m_mask.test(_idx))
+            return;
+        m_mask.set(_idx);
+        m_funcs[m_size++] = get_initialize_table<_CompList>()[_idx];
+    }
+
+    /// initialize the components in obj in the order they were inserted
+    void operator()(_CompList& obj) const
+    {
+        for(size_type i = 0; i < m_size; ++i)
+            (*m_funcs[i])(obj);
+    }
+
+    bool             empty() const { return m_size == 0; }
+    size_type        size() const { return m_size; }
+    const mask_type& mask() const { return m_mask; }
+    bool             count(TIMEMORY_COMPONENT comp) const
+    {
+        return comp >= 0 && comp < TIMEMORY_COMPONENTS_END && m_mask.test(comp);
+    }
+
+private:
+    size_type    m_size = 0;
+    mask_type    m_mask;
+    init_array_t m_funcs;
+};
+
+//--------------------------------------------------------------------------------------//
+
+template <template <typename...> class _CompList, typename... _CompTypes>
+inline void
+initialize(_CompList<_CompTypes...>&                         obj,
+           const component_set<_CompList<_CompTypes...>>& components)
+{
+    components(obj);
+}
+
 //--------------------------------------------------------------------------------------//
 
 template <template <typename...> class _CompList, typename... _CompTypes,
@@ -165,8 +309,14 @@ void
 initialize(_CompList<_CompTypes...>&               obj,
            const _Container<_Intp, _ExtraArgs...>& components)
 {
+    using comp_list_t = _CompList<_CompTypes...>;
+    auto& _table      = get_initialize_table<comp_list_t>();
     for(auto itr : components)
-        initialize(static_cast<TIMEMORY_COMPONENT>(itr), obj);
+    {
+        auto _idx = static_cast<int>(itr);
+        if(_idx >= 0 && _idx < TIMEMORY_COMPONENTS_END)
+            (*_table[_idx])(obj);
+    }
 }
 
 //--------------------------------------------------------------------------------------//
@@ -190,8 +340,13 @@ template <template <typename...> class _CompList, typename... _CompTypes>
 void
 initialize(_CompList<_CompTypes...>& obj, const int ncomponents, const int* components)
 {
+    using comp_list_t = _CompList<_CompTypes...>;
+    auto& _table      = get_initialize_table<comp_list_t>();
     for(int i = 0; i < ncomponents; ++i)
-        initialize(static_cast<TIMEMORY_COMPONENT>(components[i]), obj);
+    {
+        if(components[i] >= 0 && components[i] < TIMEMORY_COMPONENTS_END)
+            (*_table[components[i]])(obj);
+    }
 }
 
 //======================================================================================//
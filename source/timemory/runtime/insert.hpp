@@ -125,6 +125,7 @@ insert(const TIMEMORY_COMPONENT& comp, _Bundle<_Idx, _Type>& obj)
         case PAGE_RSS: obj.template insert<page_rss>(); break;
         case PAPI_ARRAY: obj.template insert<papi_array_t>(); break;
         case PEAK_RSS: obj.template insert<peak_rss>(); break;
+        case PERF_EVENT_ARRAY: obj.template insert<perf_event_array_t>(); break;
         case PRIORITY_CONTEXT_SWITCH:
             obj.template insert<priority_context_switch>();
             break;
@@ -137,6 +138,7 @@ insert(const TIMEMORY_COMPONENT& comp, _Bundle<_Idx, _Type>& obj)
         case THREAD_CPU_CLOCK: obj.template insert<thread_cpu_clock>(); break;
         case THREAD_CPU_UTIL: obj.template insert<thread_cpu_util>(); break;
         case TRIP_COUNT: obj.template insert<trip_count>(); break;
+        case TSC_CLOCK: obj.template insert<tsc_clock>(); break;
         case USER_CLOCK: obj.template insert<user_clock>(); break;
         case USER_LIST_BUNDLE: obj.template insert<user_list_bundle>(); break;
         case USER_TUPLE_BUNDLE: obj.template insert<user_tuple_bundle>(); break;
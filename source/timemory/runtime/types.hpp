@@ -82,6 +82,23 @@ void
 initialize(_CompList<_CompTypes...>&               obj,
            const _Container<_Intp, _ExtraArgs...>& components);
 
+//--------------------------------------------------------------------------------------//
+//
+///  description:
+///      a set of components parsed once from a string or a list of enumerations
+///      which initializes an auto_list or component_list through a table of
+///      function pointers instead of the switch on the enumeration
+//
+///  usage:
+///      using namespace tim::component;
+///      using optional_t = tim::component_list<wall_clock, cpu_clock, cpu_util>;
+//
+///      static auto comp_set = tim::component_set<optional_t>("cpu_clock,cpu_util");
+///      auto obj = new optional_t(__FUNCTION__, false, false, comp_set);
+//
+template <typename _CompList>
+class component_set;
+
 //--------------------------------------------------------------------------------------//
 //
 ///  description:
@@ -131,6 +131,7 @@ tim_api struct settings
     TIMEMORY_ENV_STATIC_ACCESSOR(bool, text_output, "TIMEMORY_TEXT_OUTPUT", true)
     TIMEMORY_ENV_STATIC_ACCESSOR(bool, json_output, "TIMEMORY_JSON_OUTPUT", false)
     TIMEMORY_ENV_STATIC_ACCESSOR(bool, dart_output, "TIMEMORY_DART_OUTPUT", false)
+    TIMEMORY_ENV_STATIC_ACCESSOR(bool, binary_output, "TIMEMORY_BINARY_OUTPUT", false)
     TIMEMORY_ENV_STATIC_ACCESSOR(bool, time_output, "TIMEMORY_TIME_OUTPUT", false)
 
     // general settings
@@ -140,6 +141,8 @@ tim_api struct settings
     TIMEMORY_ENV_STATIC_ACCESSOR(bool, flat_profile, "TIMEMORY_FLAT_PROFILE", false)
     TIMEMORY_ENV_STATIC_ACCESSOR(bool, collapse_threads, "TIMEMORY_COLLAPSE_THREADS",
                                  true)
+    TIMEMORY_ENV_STATIC_ACCESSOR(bool, tree_merge, "TIMEMORY_TREE_MERGE", false)
+    TIMEMORY_ENV_STATIC_ACCESSOR(int, merge_threads, "TIMEMORY_MERGE_THREADS", 0)
     TIMEMORY_ENV_STATIC_ACCESSOR(uint16_t, max_depth, "TIMEMORY_MAX_DEPTH",
                                  std::numeric_limits<uint16_t>::max())
     TIMEMORY_ENV_STATIC_ACCESSOR(string_t, time_format, "TIMEMORY_TIME_FORMAT",
@@ -215,6 +218,9 @@ tim_api struct settings
     TIMEMORY_ENV_STATIC_ACCESSOR(bool, mpi_output_per_node,
                                  "TIMEMORY_MPI_OUTPUT_PER_NODE", false)
 
+    /// reduce MPI data to the min/max/mean across ranks instead of gathering every rank
+    TIMEMORY_ENV_STATIC_ACCESSOR(bool, mpi_reduce, "TIMEMORY_MPI_REDUCE", false)
+
     //----------------------------------------------------------------------------------//
     //      UPC++
     //----------------------------------------------------------------------------------//
@@ -243,6 +249,17 @@ tim_api struct settings
     /// PAPI hardware counters
     TIMEMORY_ENV_STATIC_ACCESSOR(string_t, papi_events, "TIMEMORY_PAPI_EVENTS", "")
 
+    //----------------------------------------------------------------------------------//
+    //      perf_event
+    //----------------------------------------------------------------------------------//
+
+    /// counters opened with perf_event_open, e.g. "cycles,instructions"
+    TIMEMORY_ENV_STATIC_ACCESSOR(string_t, perf_events, "TIMEMORY_PERF_EVENTS", "")
+
+    /// read the hardware counters in user-space (rdpmc) when the kernel allows it
+    TIMEMORY_ENV_STATIC_ACCESSOR(bool, perf_event_rdpmc, "TIMEMORY_PERF_EVENT_RDPMC",
+                                 true)
+
     //----------------------------------------------------------------------------------//
     //      CUDA / CUPTI
     //----------------------------------------------------------------------------------//
@@ -521,12 +538,15 @@ tim_api struct settings
         _TRY_CATCH_NVP("TIMEMORY_TEXT_OUTPUT", text_output)
         _TRY_CATCH_NVP("TIMEMORY_JSON_OUTPUT", json_output)
         _TRY_CATCH_NVP("TIMEMORY_DART_OUTPUT", dart_output)
+        _TRY_CATCH_NVP("TIMEMORY_BINARY_OUTPUT", binary_output)
         _TRY_CATCH_NVP("TIMEMORY_TIME_OUTPUT", time_output)
         _TRY_CATCH_NVP("TIMEMORY_VERBOSE", verbose)
         _TRY_CATCH_NVP("TIMEMORY_DEBUG", debug)
         _TRY_CATCH_NVP("TIMEMORY_BANNER", banner)
         _TRY_CATCH_NVP("TIMEMORY_FLAT_PROFILE", flat_profile)
         _TRY_CATCH_NVP("TIMEMORY_COLLAPSE_THREADS", collapse_threads)
+        _TRY_CATCH_NVP("TIMEMORY_TREE_MERGE", tree_merge)
+        _TRY_CATCH_NVP("TIMEMORY_MERGE_THREADS", merge_threads)
         _TRY_CATCH_NVP("TIMEMORY_MAX_DEPTH", max_depth)
         _TRY_CATCH_NVP("TIMEMORY_TIME_FORMAT", time_format)
         _TRY_CATCH_NVP("TIMEMORY_PRECISION", precision)
@@ -546,6 +566,7 @@ tim_api struct settings
         _TRY_CATCH_NVP("TIMEMORY_MPI_THREAD_TYPE", mpi_thread_type)
         _TRY_CATCH_NVP("TIMEMORY_MPI_OUTPUT_PER_RANK", mpi_output_per_rank)
         _TRY_CATCH_NVP("TIMEMORY_MPI_OUTPUT_PER_NODE", mpi_output_per_node)
+        _TRY_CATCH_NVP("TIMEMORY_MPI_REDUCE", mpi_reduce)
         _TRY_CATCH_NVP("TIMEMORY_OUTPUT_PATH", output_path)
         _TRY_CATCH_NVP("TIMEMORY_OUTPUT_PREFIX", output_prefix)
         _TRY_CATCH_NVP("TIMEMORY_DART_TYPE", dart_type)
@@ -556,6 +577,8 @@ tim_api struct settings
         _TRY_CATCH_NVP("TIMEMORY_PAPI_FAIL_ON_ERROR", papi_fail_on_error)
         _TRY_CATCH_NVP("TIMEMORY_PAPI_QUIET", papi_quiet)
         _TRY_CATCH_NVP("TIMEMORY_PAPI_EVENTS", papi_events)
+        _TRY_CATCH_NVP("TIMEMORY_PERF_EVENTS", perf_events)
+        _TRY_CATCH_NVP("TIMEMORY_PERF_EVENT_RDPMC", perf_event_rdpmc)
         _TRY_CATCH_NVP("TIMEMORY_CUDA_EVENT_BATCH_SIZE", cuda_event_batch_size)
         _TRY_CATCH_NVP("TIMEMORY_NVTX_MARKER_DEVICE_SYNC", nvtx_marker_device_sync)
         _TRY_CATCH_NVP("TIMEMORY_CUPTI_ACTIVITY_LEVEL", cupti_activity_level)
@@ -53,13 +53,14 @@ using complete_tuple_t = std::tuple<
     component::num_minor_page_faults, component::num_msg_recv, component::num_msg_sent,
     component::num_signals, component::num_swap, component::nvtx_marker,
     component::page_rss, component::papi_array_t, component::peak_rss,
-    component::priority_context_switch, component::process_cpu_clock,
-    component::process_cpu_util, component::read_bytes, component::stack_rss,
-    component::system_clock, component::tau_marker, component::thread_cpu_clock,
-    component::thread_cpu_util, component::trip_count, component::user_tuple_bundle,
-    component::user_list_bundle, component::user_clock, component::virtual_memory,
-    component::voluntary_context_switch, component::vtune_event, component::vtune_frame,
-    component::wall_clock, component::written_bytes>;
+    component::perf_event_array_t, component::priority_context_switch,
+    component::process_cpu_clock, component::process_cpu_util, component::read_bytes,
+    component::stack_rss, component::system_clock, component::tau_marker,
+    component::thread_cpu_clock, component::thread_cpu_util, component::trip_count,
+    component::tsc_clock, component::user_tuple_bundle, component::user_list_bundle,
+    component::user_clock, component::virtual_memory, component::voluntary_context_switch,
+    component::vtune_event, component::vtune_frame, component::wall_clock,
+    component::written_bytes>;
 
 using complete_auto_list_t = auto_list<
     component::caliper, component::cpu_clock, component::cpu_roofline_dp_flops,
@@ -74,13 +75,14 @@ using complete_auto_list_t = auto_list<
     component::num_minor_page_faults, component::num_msg_recv, component::num_msg_sent,
     component::num_signals, component::num_swap, component::nvtx_marker,
     component::page_rss, component::papi_array_t, component::peak_rss,
-    component::priority_context_switch, component::process_cpu_clock,
-    component::process_cpu_util, component::read_bytes, component::stack_rss,
-    component::system_clock, component::tau_marker, component::thread_cpu_clock,
-    component::thread_cpu_util, component::trip_count, component::user_tuple_bundle,
-    component::user_list_bundle, component::user_clock, component::virtual_memory,
-    component::voluntary_context_switch, component::vtune_event, component::vtune_frame,
-    component::wall_clock, component::written_bytes>;
+    component::perf_event_array_t, component::priority_context_switch,
+    component::process_cpu_clock, component::process_cpu_util, component::read_bytes,
+    component::stack_rss, component::system_clock, component::tau_marker,
+    component::thread_cpu_clock, component::thread_cpu_util, component::trip_count,
+    component::tsc_clock, component::user_tuple_bundle, component::user_list_bundle,
+    component::user_clock, component::virtual_memory, component::voluntary_context_switch,
+    component::vtune_event, component::vtune_frame, component::wall_clock,
+    component::written_bytes>;
 
 using complete_list_t = component_list<
     component::caliper, component::cpu_clock, component::cpu_roofline_dp_flops,
@@ -95,13 +97,14 @@ using complete_list_t = component_list<
     component::num_minor_page_faults, component::num_msg_recv, component::num_msg_sent,
     component::num_signals, component::num_swap, component::nvtx_marker,
     component::page_rss, component::papi_array_t, component::peak_rss,
-    component::priority_context_switch, component::process_cpu_clock,
-    component::process_cpu_util, component::read_bytes, component::stack_rss,
-    component::system_clock, component::tau_marker, component::thread_cpu_clock,
-    component::thread_cpu_util, component::trip_count, component::user_tuple_bundle,
-    component::user_list_bundle, component::user_clock, component::virtual_memory,
-    component::voluntary_context_switch, component::vtune_event, component::vtune_frame,
-    component::wall_clock, component::written_bytes>;
+    component::perf_event_array_t, component::priority_context_switch,
+    component::process_cpu_clock, component::process_cpu_util, component::read_bytes,
+    component::stack_rss, component::system_clock, component::tau_marker,
+    component::thread_cpu_clock, component::thread_cpu_util, component::trip_count,
+    component::tsc_clock, component::user_tuple_bundle, component::user_list_bundle,
+    component::user_clock, component::virtual_memory, component::voluntary_context_switch,
+    component::vtune_event, component::vtune_frame, component::wall_clock,
+    component::written_bytes>;
 
 //--------------------------------------------------------------------------------------//
 //  category configurations
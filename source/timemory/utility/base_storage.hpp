@@ -165,6 +165,7 @@ public:
 protected:
     void add_text_output(const string_t& _label, const string_t& _file);
     void add_json_output(const string_t& _label, const string_t& _file);
+    void add_binary_output(const string_t& _label, const string_t& _file);
 
     static std::atomic<int>& storage_once_flag()
     {
@@ -85,6 +85,16 @@ tim::base::storage::add_json_output(const string_t& _label, const string_t& _fil
 
 //--------------------------------------------------------------------------------------//
 
+inline void
+tim::base::storage::add_binary_output(const string_t& _label, const string_t& _file)
+{
+    m_manager = ::tim::manager::instance();
+    if(m_manager)
+        m_manager->add_binary_output(_label, _file);
+}
+
+//--------------------------------------------------------------------------------------//
+
 template <typename Type>
 void
 tim::impl::storage<Type, true>::get_shared_manager()
@@ -0,0 +1,580 @@
+//  MIT License
+//
+//  Copyright (c) 2020, The Regents of the University of California,
+//  through Lawrence Berkeley National Laboratory (subject to receipt of any
+//  required approvals from the U.S. Dept. of Energy).  All rights reserved.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to
+//  deal in the Software without restriction, including without limitation the
+//  rights to use, copy, modify, merge, publish, distribute, sublicense, and
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+//  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+//  IN THE SOFTWARE.
+
+/** \file utility/columnar.hpp
+ * \headerfile utility/columnar.hpp "timemory/utility/columnar.hpp"
+ * Versioned, columnar binary output format and a memory-mapped reader.
+ *
+ * Layout (native byte-order, every section is aligned to 8 bytes):
+ *
+ *   header      : magic "TIMEMORY", version, byte-order mark, the number of nodes,
+ *                 strings, and columns, the concurrency, and the section offsets
+ *   strings     : uint64_t offsets[nstrings + 1] followed by the characters.
+ *                 Strings 0, 1, and 2 are the label, description, and unit
+ *   nodes       : one array per field, in order: uint64_t hash, int64_t parent,
+ *                 int64_t first_child, int64_t next_sibling, int64_t depth,
+ *                 int64_t laps, uint32_t prefix (string index), uint32_t rank,
+ *                 uint32_t flags. Missing relatives are -1
+ *   columns     : ncolumns descriptors of { name, unit, kind, index } followed by
+ *                 ncolumns arrays of nnodes doubles
+ */
+
+#pragma once
+
+#include "timemory/utility/macros.hpp"
+
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <deque>
+#include <limits>
+#include <ostream>
+#include <stdexcept>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#if defined(_UNIX)
+#    include <fcntl.h>
+#    include <sys/mman.h>
+#    include <sys/stat.h>
+#    include <unistd.h>
+#else
+#    include <fstream>
+#endif
+
+namespace tim
+{
+namespace columnar
+{
+//--------------------------------------------------------------------------------------//
+
+static constexpr uint32_t version         = 1;
+static constexpr uint32_t byte_order_mark = 0x01020304;
+
+/// the kind of data in a column
+enum kind : uint32_t
+{
+    repr  = 0,  ///< the value reported by get(), in display units
+    value = 1,  ///< the last measurement
+    accum = 2   ///< the accumulated measurement
+};
+
+/// bits of the per-node flags
+enum flag : uint32_t
+{
+    transient = 0x1
+};
+
+struct header
+{
+    char     magic[8];
+    uint32_t version;
+    uint32_t byte_order;
+    uint64_t nnodes;
+    uint64_t nstrings;
+    uint64_t ncolumns;
+    uint64_t concurrency;
+    uint64_t string_offset;
+    uint64_t node_offset;
+    uint64_t column_offset;
+};
+
+struct column
+{
+    uint32_t name;
+    uint32_t unit;
+    uint32_t kind;
+    uint32_t index;
+};
+
+//--------------------------------------------------------------------------------------//
+//
+//  converts the data of a component into a flat list of doubles. Types which are not
+//  arithmetic or a container of arithmetic types do not produce any values
+//
+template <typename _Tp, bool _Arith = std::is_arithmetic<_Tp>::value>
+struct flatten
+{
+    static void apply(const _Tp&, std::vector<double>&) {}
+};
+
+template <typename _Tp>
+struct flatten<_Tp, true>
+{
+    static void apply(const _Tp& _val, std::vector<double>& _ret)
+    {
+        _ret.push_back(static_cast<double>(_val));
+    }
+};
+
+template <typename _Tp, size_t _N>
+struct flatten<std::array<_Tp, _N>, false>
+{
+    static void apply(const std::array<_Tp, _N>& _val, std::vector<double>& _ret)
+    {
+        for(const auto& itr : _val)
+            flatten<_Tp>::apply(itr, _ret);
+    }
+};
+
+template <typename _Tp, typename... _Extra>
+struct flatten<std::vector<_Tp, _Extra...>, false>
+{
+    static void apply(const std::vector<_Tp, _Extra...>& _val, std::vector<double>& _ret)
+    {
+        for(const auto& itr : _val)
+            flatten<_Tp>::apply(itr, _ret);
+    }
+};
+
+template <typename _Tp, typename... _Extra>
+struct flatten<std::deque<_Tp, _Extra...>, false>
+{
+    static void apply(const std::deque<_Tp, _Extra...>& _val, std::vector<double>& _ret)
+    {
+        for(const auto& itr : _val)
+            flatten<_Tp>::apply(itr, _ret);
+    }
+};
+
+template <typename _Lhs, typename _Rhs>
+struct flatten<std::pair<_Lhs, _Rhs>, false>
+{
+    static void apply(const std::pair<_Lhs, _Rhs>& _val, std::vector<double>& _ret)
+    {
+        flatten<_Lhs>::apply(_val.first, _ret);
+        flatten<_Rhs>::apply(_val.second, _ret);
+    }
+};
+
+//--------------------------------------------------------------------------------------//
+//
+//  accumulates the nodes in memory as flat arrays and writes the file in one pass.
+//  Parents are indices of previously added nodes (-1 for none)
+//
+class writer
+{
+public:
+    writer(const std::string& _label, const std::string& _desc, const std::string& _unit,
+           uint64_t _concurrency = 1)
+    : m_concurrency(_concurrency)
+    {
+        add_string(_label);
+        add_string(_desc);
+        add_string(_unit);
+    }
+
+    uint32_t add_string(const std::string& _str)
+    {
+        auto itr = m_string_index.find(_str);
+        if(itr != m_string_index.end())
+            return itr->second;
+        auto _idx = static_cast<uint32_t>(m_strings.size());
+        m_strings.push_back(_str);
+        m_string_index.insert({ _str, _idx });
+        return _idx;
+    }
+
+    void add_column(const std::string& _name, const std::string& _unit, uint32_t _kind,
+                    uint32_t _index)
+    {
+        m_columns.push_back({ add_string(_name), add_string(_unit), _kind, _index });
+    }
+
+    /// values beyond the number of columns are ignored and missing values are NaN
+    int64_t add_node(uint64_t _hash, int64_t _parent, int64_t _depth, int64_t _laps,
+                     uint32_t _rank, uint32_t _flags, const std::string& _prefix,
+                     const std::vector<double>& _values)
+    {
+        auto _idx = static_cast<int64_t>(m_hash.size());
+        m_hash.push_back(_hash);
+        m_parent.push_back(_parent);
+        m_first_child.push_back(-1);
+        m_next_sibling.push_back(-1);
+        m_last_child.push_back(-1);
+        m_depth.push_back(_depth);
+        m_laps.push_back(_laps);
+        m_prefix.push_back(add_string(_prefix));
+        m_rank.push_back(_rank);
+        m_flags.push_back(_flags);
+
+        if(_parent >= 0 && _parent < _idx)
+        {
+            if(m_last_child[_parent] < 0)
+                m_first_child[_parent] = _idx;
+            else
+                m_next_sibling[m_last_child[_parent]] = _idx;
+            m_last_child[_parent] = _idx;
+        }
+
+        for(size_t i = 0; i < m_columns.size(); ++i)
+            m_values.push_back((i < _values.size())
+                                   ? _values[i]
+                                   : std::numeric_limits<double>::quiet_NaN());
+        return _idx;
+    }
+
+    uint64_t size() const { return m_hash.size(); }
+    uint64_t ncolumns() const { return m_columns.size(); }
+
+    void write(std::ostream& _os) const
+    {
+        uint64_t _nnodes   = m_hash.size();
+        uint64_t _nstrings = m_strings.size();
+        uint64_t _ncols    = m_columns.size();
+
+        std::vector<uint64_t> _offsets(_nstrings + 1, 0);
+        for(uint64_t i = 0; i < _nstrings; ++i)
+            _offsets[i + 1] = _offsets[i] + m_strings[i].length();
+
+        header _header;
+        std::memset(&_header, 0, sizeof(header));
+        std::memcpy(_header.magic, "TIMEMORY", 8);
+        _header.version       = version;
+        _header.byte_order    = byte_order_mark;
+        _header.nnodes        = _nnodes;
+        _header.nstrings      = _nstrings;
+        _header.ncolumns      = _ncols;
+        _header.concurrency   = m_concurrency;
+        _header.string_offset = padded(sizeof(header));
+        _header.node_offset   = _header.string_offset +
+                              padded((_nstrings + 1) * sizeof(uint64_t) + _offsets.back());
+        _header.column_offset =
+            _header.node_offset + 6 * padded(_nnodes * sizeof(int64_t)) +
+            3 * padded(_nnodes * sizeof(uint32_t));
+
+        uint64_t _pos = 0;
+        write_array(_os, _pos, &_header, 1);
+        write_array(_os, _pos, _offsets.data(), _offsets.size(), false);
+        for(const auto& itr : m_strings)
+            write_array(_os, _pos, itr.data(), itr.length(), false);
+        pad(_os, _pos);
+
+        write_array(_os, _pos, m_hash.data(), _nnodes);
+        write_array(_os, _pos, m_parent.data(), _nnodes);
+        write_array(_os, _pos, m_first_child.data(), _nnodes);
+        write_array(_os, _pos, m_next_sibling.data(), _nnodes);
+        write_array(_os, _pos, m_depth.data(), _nnodes);
+        write_array(_os, _pos, m_laps.data(), _nnodes);
+        write_array(_os, _pos, m_prefix.data(), _nnodes);
+        write_array(_os, _pos, m_rank.data(), _nnodes);
+        write_array(_os, _pos, m_flags.data(), _nnodes);
+
+        write_array(_os, _pos, m_columns.data(), _ncols);
+        // the values are stored by node so transpose them
+        std::vector<double> _column(_nnodes);
+        for(uint64_t c = 0; c < _ncols; ++c)
+        {
+            for(uint64_t i = 0; i < _nnodes; ++i)
+                _column[i] = m_values[i * _ncols + c];
+            write_array(_os, _pos, _column.data(), _nnodes);
+        }
+    }
+
+private:
+    static uint64_t padded(uint64_t _n) { return (_n + 7) & ~static_cast<uint64_t>(7); }
+
+    static void pad(std::ostream& _os, uint64_t& _pos)
+    {
+        static const char _zeros[8] = { 0, 0, 0, 0, 0, 0, 0, 0 };
+        auto              _n        = padded(_pos) - _pos;
+        _os.write(_zeros, _n);
+        _pos += _n;
+    }
+
+    template <typename _Tp>
+    static void write_array(std::ostream& _os, uint64_t& _pos, const _Tp* _data,
+                            uint64_t _n, bool _pad = true)
+    {
+        _os.write(reinterpret_cast<const char*>(_data), _n * sizeof(_Tp));
+        _pos += _n * sizeof(_Tp);
+        if(_pad)
+            pad(_os, _pos);
+    }
+
+private:
+    uint64_t                                  m_concurrency;
+    std::vector<std::string>                  m_strings;
+    std::unordered_map<std::string, uint32_t> m_string_index;
+    std::vector<column>                       m_columns;
+    std::vector<uint64_t>                     m_hash;
+    std::vector<int64_t>                      m_parent;
+    std::vector<int64_t>                      m_first_child;
+    std::vector<int64_t>                      m_next_sibling;
+    std::vector<int64_t>                      m_last_child;
+    std::vector<int64_t>                      m_depth;
+    std::vector<int64_t>                      m_laps;
+    std::vector<uint32_t>                     m_prefix;
+    std::vector<uint32_t>                     m_rank;
+    std::vector<uint32_t>                     m_flags;
+    std::vector<double>                       m_values;
+};
+
+//--------------------------------------------------------------------------------------//
+//
+//  memory-maps the file and provides random access to the nodes and columns. Nothing
+//  is decoded until it is requested. Throws std::runtime_error if the file is not a
+//  valid columnar file of a supported version and byte-order
+//
+class reader
+{
+public:
+    explicit reader(const std::string& _fname)
+    {
+#if defined(_UNIX)
+        m_fd = ::open(_fname.c_str(), O_RDONLY);
+        if(m_fd < 0)
+            throw std::runtime_error("Error opening '" + _fname + "'");
+        struct stat _stat;
+        if(::fstat(m_fd, &_stat) == 0 && _stat.st_size > 0)
+        {
+            m_size = static_cast<uint64_t>(_stat.st_size);
+            auto _addr = ::mmap(nullptr, m_size, PROT_READ, MAP_PRIVATE, m_fd, 0);
+            if(_addr != MAP_FAILED)
+                m_data = static_cast<const char*>(_addr);
+        }
+#else
+        std::ifstream _ifs(_fname.c_str(), std::ios::binary);
+        if(!_ifs)
+            throw std::runtime_error("Error opening '" + _fname + "'");
+        m_buffer.assign(std::istreambuf_iterator<char>(_ifs),
+                        std::istreambuf_iterator<char>());
+        m_size = m_buffer.size();
+        m_data = (m_size > 0) ? m_buffer.data() : nullptr;
+#endif
+        if(!m_data || m_size < sizeof(header))
+        {
+            close();
+            throw std::runtime_error("'" + _fname + "' is not a columnar file");
+        }
+
+        std::memcpy(&m_header, m_data, sizeof(header));
+        if(std::memcmp(m_header.magic, "TIMEMORY", 8) != 0 ||
+           m_header.byte_order != byte_order_mark || m_header.version > version ||
+           !is_aligned(m_header.string_offset) || !is_aligned(m_header.node_offset) ||
+           !is_aligned(m_header.column_offset) ||
+           !fits(m_header.column_offset, m_header.ncolumns, sizeof(column)))
+        {
+            close();
+            throw std::runtime_error("'" + _fname +
+                                     "' is not a supported columnar file");
+        }
+
+        auto _n   = m_header.nnodes;
+        auto _pos = m_header.node_offset;
+        if(!array(m_hash, _pos, _n) || !array(m_parent, _pos, _n) ||
+           !array(m_first_child, _pos, _n) || !array(m_next_sibling, _pos, _n) ||
+           !array(m_depth, _pos, _n) || !array(m_laps, _pos, _n) ||
+           !array(m_prefix, _pos, _n) || !array(m_rank, _pos, _n) ||
+           !array(m_flags, _pos, _n))
+        {
+            close();
+            throw std::runtime_error("'" + _fname + "' is truncated");
+        }
+
+        _pos = m_header.column_offset;
+        if(!array(m_columns, _pos, m_header.ncolumns) ||
+           (m_header.ncolumns > 0 &&
+            _n > std::numeric_limits<uint64_t>::max() / m_header.ncolumns) ||
+           !array(m_values, _pos, m_header.ncolumns * _n))
+        {
+            close();
+            throw std::runtime_error("'" + _fname + "' is truncated");
+        }
+
+        // the offsets of the strings must be increasing and the characters must be
+        // within the file
+        _pos = m_header.string_offset;
+        if(m_header.nstrings == std::numeric_limits<uint64_t>::max() ||
+           !fits(_pos, m_header.nstrings + 1, sizeof(uint64_t)))
+        {
+            close();
+            throw std::runtime_error("'" + _fname + "' has an invalid string table");
+        }
+        m_offsets   = reinterpret_cast<const uint64_t*>(m_data + _pos);
+        m_chars     = reinterpret_cast<const char*>(m_offsets + m_header.nstrings + 1);
+        auto _nchar = m_size - (_pos + (m_header.nstrings + 1) * sizeof(uint64_t));
+        for(uint64_t i = 0; i <= m_header.nstrings; ++i)
+        {
+            if(m_offsets[i] > _nchar || (i > 0 && m_offsets[i] < m_offsets[i - 1]))
+            {
+                close();
+                throw std::runtime_error("'" + _fname +
+                                         "' has an invalid string table");
+            }
+        }
+
+        if(!valid_nodes())
+        {
+            close();
+            throw std::runtime_error("'" + _fname + "' has an invalid node table");
+        }
+    }
+
+    ~reader() { close(); }
+
+    reader(const reader&) = delete;
+    reader(reader&&)      = delete;
+    reader& operator=(const reader&) = delete;
+    reader& operator=(reader&&) = delete;
+
+    const header& get_header() const { return m_header; }
+
+    uint64_t size() const { return m_header.nnodes; }
+    uint64_t ncolumns() const { return m_header.ncolumns; }
+    uint64_t nstrings() const { return m_header.nstrings; }
+    uint64_t concurrency() const { return m_header.concurrency; }
+
+    std::string get_string(uint64_t _idx) const
+    {
+        if(_idx >= m_header.nstrings)
+            return "";
+        return std::string(m_chars + m_offsets[_idx],
+                           m_offsets[_idx + 1] - m_offsets[_idx]);
+    }
+
+    std::string label() const { return get_string(0); }
+    std::string description() const { return get_string(1); }
+    std::string unit() const { return get_string(2); }
+
+    // node table
+    uint64_t    hash(uint64_t i) const { return m_hash[i]; }
+    int64_t     parent(uint64_t i) const { return m_parent[i]; }
+    int64_t     first_child(uint64_t i) const { return m_first_child[i]; }
+    int64_t     next_sibling(uint64_t i) const { return m_next_sibling[i]; }
+    int64_t     depth(uint64_t i) const { return m_depth[i]; }
+    int64_t     laps(uint64_t i) const { return m_laps[i]; }
+    uint32_t    rank(uint64_t i) const { return m_rank[i]; }
+    uint32_t    flags(uint64_t i) const { return m_flags[i]; }
+    bool        is_transient(uint64_t i) const { return (m_flags[i] & transient) != 0; }
+    std::string prefix(uint64_t i) const { return get_string(m_prefix[i]); }
+
+    std::vector<int64_t> children(uint64_t i) const
+    {
+        std::vector<int64_t> _children;
+        for(auto itr = m_first_child[i]; itr >= 0; itr = m_next_sibling[itr])
+            _children.push_back(itr);
+        return _children;
+    }
+
+    // column table
+    const column& get_column(uint64_t c) const { return m_columns[c]; }
+    std::string   column_name(uint64_t c) const { return get_string(m_columns[c].name); }
+    std::string   column_unit(uint64_t c) const { return get_string(m_columns[c].unit); }
+    uint32_t      column_kind(uint64_t c) const { return m_columns[c].kind; }
+    const double* column_data(uint64_t c) const { return m_values + c * size(); }
+    double        value(uint64_t c, uint64_t i) const { return column_data(c)[i]; }
+
+private:
+    static bool is_aligned(uint64_t _pos) { return (_pos % 8) == 0; }
+
+    /// the links of each node must be within the table and the children and siblings
+    /// of a node always have a larger index (as written by the writer), which also
+    /// rules out cycles. The string indices must be within the string table
+    bool valid_nodes() const
+    {
+        auto _n    = static_cast<int64_t>(m_header.nnodes);
+        auto _link = [_n](int64_t _idx, int64_t _min) {
+            return (_idx == -1 || (_idx > _min && _idx < _n));
+        };
+        if(_n < 0)
+            return false;
+        for(int64_t i = 0; i < _n; ++i)
+        {
+            if(!_link(m_parent[i], -1) || !_link(m_first_child[i], i) ||
+               !_link(m_next_sibling[i], i) || m_prefix[i] >= m_header.nstrings)
+                return false;
+        }
+        for(uint64_t c = 0; c < m_header.ncolumns; ++c)
+        {
+            if(m_columns[c].name >= m_header.nstrings ||
+               m_columns[c].unit >= m_header.nstrings)
+                return false;
+        }
+        return true;
+    }
+
+    /// whether '_n' elements of '_size' bytes at the position are within the file
+    bool fits(uint64_t _pos, uint64_t _n, uint64_t _size) const
+    {
+        return (_pos <= m_size && _n <= (m_size - _pos) / _size);
+    }
+
+    /// assigns the array at the position and advances it. Returns false if the file
+    /// is too small
+    template <typename _Tp>
+    bool array(const _Tp*& _ret, uint64_t& _pos, uint64_t _n)
+    {
+        if(!fits(_pos, _n, sizeof(_Tp)))
+            return false;
+        _ret = reinterpret_cast<const _Tp*>(m_data + _pos);
+        _pos += (_n * sizeof(_Tp) + 7) & ~static_cast<uint64_t>(7);
+        return true;
+    }
+
+    void close()
+    {
+#if defined(_UNIX)
+        if(m_data)
+            ::munmap(const_cast<char*>(m_data), m_size);
+        if(m_fd >= 0)
+            ::close(m_fd);
+        m_fd = -1;
+#else
+        m_buffer.clear();
+#endif
+        m_data = nullptr;
+    }
+
+private:
+#if defined(_UNIX)
+    int m_fd = -1;
+#else
+    std::vector<char> m_buffer;
+#endif
+    uint64_t        m_size         = 0;
+    const char*     m_data         = nullptr;
+    header          m_header;
+    const uint64_t* m_hash         = nullptr;
+    const int64_t*  m_parent       = nullptr;
+    const int64_t*  m_first_child  = nullptr;
+    const int64_t*  m_next_sibling = nullptr;
+    const int64_t*  m_depth        = nullptr;
+    const int64_t*  m_laps         = nullptr;
+    const uint32_t* m_prefix       = nullptr;
+    const uint32_t* m_rank         = nullptr;
+    const uint32_t* m_flags        = nullptr;
+    const column*   m_columns      = nullptr;
+    const double*   m_values       = nullptr;
+    const uint64_t* m_offsets      = nullptr;
+    const char*     m_chars        = nullptr;
+};
+
+//--------------------------------------------------------------------------------------//
+
+}  // namespace columnar
+}  // namespace tim
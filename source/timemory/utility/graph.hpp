@@ -37,9 +37,11 @@
 #include <iomanip>
 #include <iostream>
 #include <iterator>
+#include <map>
 #include <memory>
 #include <queue>
 #include <set>
+#include <sstream>
 #include <stdexcept>
 #include <vector>
 
@@ -109,11 +111,246 @@ tgraph_node<T>::tgraph_node(T&& val)
 {}
 
 //======================================================================================//
-//  graph allocator that counts the size of the allocation
+//  the number of pages in each slab of the graph allocator
 //
+#if !defined(TIMEMORY_GRAPH_ALLOCATOR_PAGES)
+#    define TIMEMORY_GRAPH_ALLOCATOR_PAGES 4
+#endif
+
+//======================================================================================//
+//  statistics reported by the graph allocator
+//
+struct graph_allocator_stats
+{
+    using this_type = graph_allocator_stats;
+
+    size_t node_size      = 0;  // size of one node
+    size_t slab_count     = 0;  // number of slabs currently held
+    size_t slab_allocs    = 0;  // number of slab allocations (i.e. calls to malloc)
+    size_t reserved_bytes = 0;  // bytes currently held in slabs
+    size_t live_nodes     = 0;  // nodes currently allocated
+    size_t peak_nodes     = 0;  // max number of nodes allocated at once
+    size_t total_nodes    = 0;  // total number of node allocations
+    size_t recycled_nodes = 0;  // node allocations served from the free-list
+    size_t releases       = 0;  // number of bulk releases
+
+    size_t live_bytes() const { return live_nodes * node_size; }
+
+    /// number of calls to malloc that were avoided vs. one allocation per node
+    size_t saved_allocs() const
+    {
+        return (total_nodes > slab_allocs) ? (total_nodes - slab_allocs) : 0;
+    }
+
+    this_type& operator+=(const this_type& rhs)
+    {
+        node_size = std::max(node_size, rhs.node_size);
+        slab_count += rhs.slab_count;
+        slab_allocs += rhs.slab_allocs;
+        reserved_bytes += rhs.reserved_bytes;
+        live_nodes += rhs.live_nodes;
+        peak_nodes += rhs.peak_nodes;
+        total_nodes += rhs.total_nodes;
+        recycled_nodes += rhs.recycled_nodes;
+        releases += rhs.releases;
+        return *this;
+    }
+
+    friend std::ostream& operator<<(std::ostream& os, const this_type& obj)
+    {
+        std::stringstream ss;
+        ss << "nodes: " << obj.live_nodes << " live, " << obj.peak_nodes << " peak, "
+           << obj.total_nodes << " total, " << obj.recycled_nodes << " recycled"
+           << " | slabs: " << obj.slab_count << " (" << obj.reserved_bytes
+           << " bytes), " << obj.slab_allocs << " allocations, " << obj.releases
+           << " releases | malloc calls saved: " << obj.saved_allocs();
+        os << ss.str();
+        return os;
+    }
+};
+
+//======================================================================================//
+//  slab-based arena for graph nodes. Memory is requested from the system in slabs
+//  of TIMEMORY_GRAPH_ALLOCATOR_PAGES pages and handed out one node at a time.
+//  Deallocated nodes are kept in an intrusive free-list and all of the slabs are
+//  returned to the system at once in release(). This is not thread-safe: each
+//  graph owns an arena and the graphs in storage are thread-local. The statistics
+//  describe the slabs of the arena: a node spliced into another graph is still
+//  counted by the arena that allocated it and is returned to that arena.
+//
+template <typename _Tp>
+class graph_arena
+{
+public:
+    using this_type  = graph_arena<_Tp>;
+    using stats_type = graph_allocator_stats;
+    using pointer_t  = std::shared_ptr<this_type>;
+
+    struct free_node
+    {
+        free_node* next;
+    };
+
+    static_assert(sizeof(_Tp) >= sizeof(free_node),
+                  "graph_arena requires the node to be at least the size of a pointer");
+
+public:
+    graph_arena() { m_stats.node_size = sizeof(_Tp); }
+    ~graph_arena() { release(); }
+
+    graph_arena(const this_type&) = delete;
+    graph_arena(this_type&&)      = delete;
+    this_type& operator=(const this_type&) = delete;
+    this_type& operator=(this_type&&) = delete;
+
+public:
+    static size_t nodes_per_slab()
+    {
+        static size_t _value = std::max<size_t>(
+            32, (TIMEMORY_GRAPH_ALLOCATOR_PAGES * units::get_page_size()) / sizeof(_Tp));
+        return _value;
+    }
+
+    _Tp* allocate()
+    {
+        ++m_stats.total_nodes;
+        m_stats.peak_nodes = std::max(m_stats.peak_nodes, ++m_stats.live_nodes);
+
+        if(m_free)
+        {
+            auto _ptr = m_free;
+            m_free    = m_free->next;
+            ++m_stats.recycled_nodes;
+            return reinterpret_cast<_Tp*>(_ptr);
+        }
+
+        if(m_next == m_last)
+            add_slab(nodes_per_slab());
+
+        return m_next++;
+    }
+
+    void deallocate(_Tp* ptr)
+    {
+        if(!ptr)
+            return;
+        if(m_adopted.empty() || !try_deallocate(ptr))
+            push_free(ptr);
+    }
+
+    /// ensure there is space for "n" more nodes without another slab allocation
+    void reserve(size_t n)
+    {
+        size_t _avail = m_last - m_next;
+        if(n > _avail)
+            add_slab(std::max(n - _avail, nodes_per_slab()));
+    }
+
+    /// return all the slabs to the system. Any node still in use is invalidated.
+    void release()
+    {
+        for(auto& itr : m_slabs)
+            ::operator delete(itr);
+        m_slabs.clear();
+        m_bounds.clear();
+        m_adopted.clear();
+        m_free                 = nullptr;
+        m_next                 = nullptr;
+        m_last                 = nullptr;
+        m_stats.slab_count     = 0;
+        m_stats.reserved_bytes = 0;
+        m_stats.live_nodes     = 0;
+        ++m_stats.releases;
+    }
+
+    /// keep another arena alive because nodes allocated by it were spliced into
+    /// the graph that owns this arena
+    void adopt(const pointer_t& rhs)
+    {
+        if(rhs && rhs.get() != this &&
+           std::find(m_adopted.begin(), m_adopted.end(), rhs) == m_adopted.end())
+            m_adopted.push_back(rhs);
+    }
+
+    const stats_type& get_stats() const { return m_stats; }
+
+private:
+    void push_free(_Tp* ptr)
+    {
+        auto _node  = reinterpret_cast<free_node*>(ptr);
+        _node->next = m_free;
+        m_free      = _node;
+        --m_stats.live_nodes;
+    }
+
+    /// whether "ptr" is in one of the slabs of this arena
+    bool owns(_Tp* ptr) const
+    {
+        auto itr = m_bounds.upper_bound(ptr);
+        if(itr == m_bounds.begin())
+            return false;
+        --itr;
+        return ptr < itr->second;
+    }
+
+    /// return the node to the arena that allocated it
+    bool try_deallocate(_Tp* ptr)
+    {
+        if(owns(ptr))
+        {
+            push_free(ptr);
+            return true;
+        }
+        // guard against arenas which adopted each other
+        if(m_visiting)
+            return false;
+        m_visiting  = true;
+        bool _found = false;
+        for(auto& itr : m_adopted)
+        {
+            if((_found = itr->try_deallocate(ptr)))
+                break;
+        }
+        m_visiting = false;
+        return _found;
+    }
+
+    void add_slab(size_t n)
+    {
+        auto  _bytes = n * sizeof(_Tp) + alignof(_Tp);
+        void* _space = ::operator new(_bytes);
+        m_slabs.push_back(_space);
+
+        // make sure the first node is aligned
+        void* _aligned = _space;
+        std::align(alignof(_Tp), n * sizeof(_Tp), _aligned, _bytes);
+
+        m_next = static_cast<_Tp*>(_aligned);
+        m_last = m_next + n;
+        m_bounds.insert({ m_next, m_last });
+
+        ++m_stats.slab_count;
+        ++m_stats.slab_allocs;
+        m_stats.reserved_bytes += _bytes;
+    }
+
+private:
+    bool                   m_visiting = false;
+    free_node*             m_free     = nullptr;
+    _Tp*                   m_next     = nullptr;
+    _Tp*                   m_last     = nullptr;
+    stats_type             m_stats    = {};
+    std::vector<void*>     m_slabs;
+    std::map<_Tp*, _Tp*>   m_bounds;
+    std::vector<pointer_t> m_adopted;
+};
+
+//======================================================================================//
+//  graph allocator that places the nodes in a slab-based arena. Copies of the
+//  allocator share the same arena.
 //
 template <typename _Tp>
-class graph_allocator : public std::allocator<_Tp>
+class graph_allocator
 {
 public:
     // The following will be the same for virtually all allocators.
@@ -124,28 +361,37 @@ public:
     using const_reference = const _Tp&;
     using size_type       = size_t;
     using difference_type = ptrdiff_t;
-    using boolvec_t       = std::deque<bool>;
-    using voidvec_t       = std::vector<void*>;
-    using sizevec_t       = std::vector<uint16_t>;
-    using base_type       = std::allocator<_Tp>;
+    using arena_type      = graph_arena<_Tp>;
+    using arena_pointer_t = std::shared_ptr<arena_type>;
+    using stats_type      = graph_allocator_stats;
+
+    template <typename _Up>
+    friend class graph_allocator;
 
 public:
     // constructors and destructors
-    graph_allocator()                       = default;
-    graph_allocator(const graph_allocator&) = delete;
+    graph_allocator()
+    : m_arena(std::make_shared<arena_type>())
+    {}
+
+    template <typename _Up>
+    graph_allocator(const graph_allocator<_Up>&)
+    : m_arena(std::make_shared<arena_type>())
+    {}
+
+    ~graph_allocator()                      = default;
+    graph_allocator(const graph_allocator&) = default;
     graph_allocator(graph_allocator&&)      = default;
-    ~graph_allocator()
-    {
-        for(auto& itr : m_allocations)
-            free(itr);
-    }
 
 public:
     // operators
-    graph_allocator& operator=(const graph_allocator&) = delete;
-    graph_allocator& operator==(graph_allocator&&)     = delete;
+    graph_allocator& operator=(const graph_allocator&) = default;
+    graph_allocator& operator=(graph_allocator&&) = default;
     bool operator!=(const graph_allocator& other) const { return !(*this == other); }
-    bool operator==(const graph_allocator&) const { return true; }
+    bool operator==(const graph_allocator& other) const
+    {
+        return m_arena == other.m_arena;
+    }
 
 public:
     _Tp*       address(_Tp& r) const { return &r; }
@@ -164,11 +410,6 @@ public:
         typedef graph_allocator<U> other;
     };
 
-    using base_type::construct;
-    using base_type::destroy;
-    /*
-    void construct(_Tp* const p, const _Tp& val) const { new((void*) p) _Tp(val); }
-
     template <typename... _Args>
     void construct(_Tp* const p, _Args&&... args) const
     {
@@ -176,13 +417,16 @@ public:
     }
 
     void destroy(_Tp* const p) const { p->~_Tp(); }
-    */
 
-    _Tp* allocate(const size_t n) const
+    _Tp* allocate(const size_t n, const void* /* const hint */ = nullptr) const
     {
         if(n == 0)
             return nullptr;
 
+        // the graph only allocates one node at a time
+        if(n == 1)
+            return m_arena->allocate();
+
         // integer overflow check that throws std::length_error in case of overflow
         if(n > max_size())
         {
@@ -190,152 +434,48 @@ public:
                 "graph_allocator<_Tp>::allocate() - Integer overflow.");
         }
 
-        auto _check_page_entry = [&](size_t i, size_t& j) -> _Tp* {
-            if(m_offset_avail[i][j])
-            {
-                bool _block = true;
-                for(size_t k = 1; k < n; ++k)
-                    if(!m_offset_avail[i][j + k])
-                    {
-                        _block = false;
-                        j += k + 1;
-                        break;
-                    }
-                if(_block)
-                {
-                    _Tp* ptr = ((_Tp*) m_pages[i]) + j;
-                    for(size_t k = 0; k < n; ++k)
-                        m_offset_avail[i][j + k] = false;
-                    m_offset_empty[i] -= n;
-                    return ptr;
-                }
-            }
-            return nullptr;
-        };
-
-        if(!m_next_addr)
-            add_pages(1);
-
-        if(m_next_offset < m_alloc_per_page && m_offset_empty[m_next_page] >= n)
-        {
-            for(size_t j = m_next_offset; j < m_offset_avail[m_next_page].size(); ++j)
-            {
-                auto _ptr = _check_page_entry(m_next_page, j);
-                if(_ptr)
-                {
-                    m_next_offset += n;
-                    return _ptr;
-                }
-            }
-        }
-
-        // Mallocator wraps malloc().
-        for(size_t i = 0; i < m_pages.size(); ++i)
-        {
-            if(m_offset_empty[i] >= n)
-            {
-                for(size_t j = 0; j < m_offset_avail[i].size(); ++j)
-                {
-                    auto _ptr = _check_page_entry(i, j);
-                    if(_ptr)
-                        return _ptr;
-                }
-            }
-        }
-
-        add_pages(1);
-        for(size_t k = 0; k < n; ++k)
-            m_offset_avail[m_next_page][m_next_offset + k] = false;
-        m_offset_empty[m_next_page] -= n;
-        m_next_offset += n;
-        return static_cast<_Tp*>(m_next_addr);
+        return static_cast<_Tp*>(::operator new(n * sizeof(_Tp)));
     }
 
     void deallocate(_Tp* const ptr, const size_t n) const
     {
-        for(size_t j = 0; j < n; ++j)
-        {
-            char* _ptr = (char*) ptr + j;
-            for(size_t i = 0; i < m_pages.size(); ++i)
-            {
-                auto itr  = m_pages[i];
-                auto dist = std::distance((char*) itr, _ptr);
-                if(dist >= 0 && dist < units::get_page_size())
-                {
-                    m_offset_avail[i][dist] = true;
-                    m_offset_empty[i] += 1;
-                }
-            }
-        }
-    }
-
-    // same for all allocators that ignore hints.
-    // template <typename U = _Tp>
-    _Tp* allocate(const size_t n, const void* /* const hint */) const
-    {
-        return allocate(n);
-    }
-
-    size_t alloc_bytes() const { return units::get_page_size() * m_pages.size(); }
-
-    void reserve(const size_t n)
-    {
-        auto npages = n / m_alloc_per_page + 1;
-        add_pages(npages);
+        if(ptr == nullptr)
+            return;
+        if(n == 1)
+            m_arena->deallocate(ptr);
+        else
+            ::operator delete(ptr);
     }
 
-private:
-    template <typename... _Args>
-    void _consume(_Args&&...)
-    {}
-
-    void add_pages(int npages = 1) const
+    /// bulk release of the arena. When another allocator shares the arena or an
+    /// arena which adopted it still holds its nodes, this allocator continues with a
+    /// new arena and the shared one is released by its last owner
+    bool release()
     {
-        auto  nbytes = npages * units::get_page_size();
-        void* _space = malloc(nbytes);
-        m_allocations.push_back(_space);
-
-        // throw std::bad_alloc in the case of memory allocation failure.
-        if(_space == nullptr)
+        if(m_arena.use_count() > 1)
         {
-            std::cerr << "Allocation of type " << typeid(_Tp).name() << " of size "
-                      << nbytes << " failed" << std::endl;
-            throw std::bad_alloc();
+            m_arena = std::make_shared<arena_type>();
+            return false;
         }
+        m_arena->release();
+        return true;
+    }
 
-        auto _num_pages = m_pages.size();
-        m_next_page     = m_pages.size();
-        m_next_addr     = _space;
-        m_next_offset   = 0;
+    /// keep the arena of another allocator alive (nodes were spliced between graphs)
+    void adopt(const graph_allocator& rhs) const { m_arena->adopt(rhs.m_arena); }
 
-        boolvec_t avail(m_alloc_per_page, true);
-        m_pages.resize(m_pages.size() + npages, nullptr);
-        m_offset_empty.resize(m_offset_empty.size() + npages, m_alloc_per_page);
-        m_offset_avail.resize(m_offset_avail.size() + npages, avail);
+    void reserve(const size_t n) { m_arena->reserve(n); }
 
-        for(int i = 0; i < npages; ++i)
-        {
-            char* _ptr = (char*) _space;
-            _ptr += (i * units::get_page_size());
-            m_pages[_num_pages + i] = (void*) _ptr;
-        }
-    }
+    size_t            alloc_bytes() const { return m_arena->get_stats().reserved_bytes; }
+    const stats_type& get_stats() const { return m_arena->get_stats(); }
 
-    const uint16_t    m_alloc_per_page            = units::get_page_size() / sizeof(_Tp);
-    mutable uint16_t  m_next_offset               = 0;
-    mutable size_t    m_next_page                 = 0;
-    mutable void*     m_next_addr                 = nullptr;
-    mutable voidvec_t m_pages                     = {};
-    mutable sizevec_t m_offset_empty              = {};
-    mutable std::vector<boolvec_t> m_offset_avail = {};
-    mutable voidvec_t              m_allocations  = {};
+private:
+    arena_pointer_t m_arena;
 };
 
 //======================================================================================//
 
-template <typename T,
-          typename AllocatorT =
-              std::allocator<tgraph_node<T>>>  // graph_allocator<tgraph_node<T>>>
+template <typename T, typename AllocatorT = graph_allocator<tgraph_node<T>>>
 class graph
 {
 protected:
@@ -631,6 +771,11 @@ public:
     template <typename iter>
     inline iter move_in_as_nth_child(iter, size_t, graph&);
 
+    /// Move 'source' node (plus its children) out of the other graph to become the
+    /// last child of 'position'. The nodes remain in the arena of the other graph.
+    template <typename iter>
+    inline iter move_in_below(iter position, graph& other, iter source);
+
     /// Merge with other graph, creating new branches and leaves only if they
     /// are not already present.
     inline void merge(const sibling_iterator&, const sibling_iterator&, sibling_iterator,
@@ -765,11 +910,16 @@ public:
             ar(cereal::make_nvp("node", *itr));
     }
 
-    size_t data_size()
-    {
-        return 0;
-        // return m_alloc.alloc_bytes();
-    }
+    size_t data_size() const { return m_alloc.alloc_bytes(); }
+
+    /// Statistics of the node allocator
+    inline graph_allocator_stats allocator_stats() const { return m_alloc.get_stats(); }
+
+    /// Return the memory held by the node allocator to the system in one step.
+    /// Only valid when the graph is empty. When the allocator is shared with another
+    /// graph, the graph continues with a new arena instead and this returns false.
+    /// Returns true if the memory was released.
+    inline bool release();
 
 private:
     AllocatorT  m_alloc;
@@ -822,6 +972,7 @@ graph<T, AllocatorT>::graph(graph<T, AllocatorT>&& x)
     m_head_initialize();
     if(x.head->next_sibling != x.feet)
     {  // move graph if non-empty only
+        m_alloc.adopt(x.m_alloc);
         head->next_sibling                 = x.head->next_sibling;
         feet->prev_sibling                 = x.head->prev_sibling;
         x.head->next_sibling->prev_sibling = head;
@@ -894,8 +1045,13 @@ template <typename T, typename AllocatorT>
 graph<T, AllocatorT>&
 graph<T, AllocatorT>::operator=(graph<T, AllocatorT>&& x)
 {
-    if(this != &x)
+    if(this == &x)
+        return *this;
+
+    clear();
+    if(x.head->next_sibling != x.feet)
     {
+        m_alloc.adopt(x.m_alloc);
         head->next_sibling                 = x.head->next_sibling;
         feet->prev_sibling                 = x.head->prev_sibling;
         x.head->next_sibling->prev_sibling = head;
@@ -955,6 +1111,24 @@ graph<T, AllocatorT>::clear()
 
 //--------------------------------------------------------------------------------------//
 
+template <typename T, typename AllocatorT>
+bool
+graph<T, AllocatorT>::release()
+{
+    if(head->next_sibling != feet)
+        return false;
+
+    m_alloc.destroy(head);
+    m_alloc.destroy(feet);
+    m_alloc.deallocate(head, 1);
+    m_alloc.deallocate(feet, 1);
+    bool _released = m_alloc.release();
+    m_head_initialize();
+    return _released;
+}
+
+//--------------------------------------------------------------------------------------//
+
 template <typename T, typename AllocatorT>
 void
 graph<T, AllocatorT>::erase_children(const iterator_base& it)
@@ -967,10 +1141,10 @@ graph<T, AllocatorT>::erase_children(const iterator_base& it)
 
     while(cur != 0)
     {
-        graph_node* prev = 0;
+        graph_node* prev = cur;
         cur              = cur->next_sibling;
         erase_children(pre_order_iterator(prev));
-        // m_alloc.destroy(prev);
+        m_alloc.destroy(prev);
         m_alloc.deallocate(prev, 1);
     }
     it.node->first_child = 0;
@@ -2011,6 +2185,8 @@ graph<T, AllocatorT>
 graph<T, AllocatorT>::move_out(iterator source)
 {
     graph ret;
+    // the nodes remain in the arena of this graph
+    ret.m_alloc.adopt(m_alloc);
 
     // Move source node into the 'ret' graph.
     ret.head->next_sibling = source.node;
@@ -2041,6 +2217,9 @@ graph<T, AllocatorT>::move_in(iter loc, graph& other)
     if(other.head->next_sibling == other.feet)
         return loc;  // other graph is empty
 
+    // the nodes remain in the arena of the other graph
+    m_alloc.adopt(other.m_alloc);
+
     graph_node* other_first_head = other.head->next_sibling;
     graph_node* other_last_head  = other.feet->prev_sibling;
 
@@ -2071,6 +2250,44 @@ graph<T, AllocatorT>::move_in(iter loc, graph& other)
 
 //--------------------------------------------------------------------------------------//
 
+template <typename T, typename AllocatorT>
+template <typename iter>
+iter
+graph<T, AllocatorT>::move_in_below(iter position, graph& other, iter source)
+{
+    graph_node* _node = source.node;
+    if(_node == 0 || position.node == 0)
+        return source;
+
+    // the nodes remain in the arena of the other graph
+    m_alloc.adopt(other.m_alloc);
+
+    // Close the links in the other graph.
+    if(_node->prev_sibling == 0)
+        _node->parent->first_child = _node->next_sibling;
+    else
+        _node->prev_sibling->next_sibling = _node->next_sibling;
+
+    if(_node->next_sibling == 0)
+        _node->parent->last_child = _node->prev_sibling;
+    else
+        _node->next_sibling->prev_sibling = _node->prev_sibling;
+
+    // Append as the last child of position.
+    _node->parent       = position.node;
+    _node->next_sibling = 0;
+    _node->prev_sibling = position.node->last_child;
+    if(position.node->last_child == 0)
+        position.node->first_child = _node;
+    else
+        position.node->last_child->next_sibling = _node;
+    position.node->last_child = _node;
+
+    return source;
+}
+
+//--------------------------------------------------------------------------------------//
+
 template <typename T, typename AllocatorT>
 template <typename iter>
 iter
@@ -2079,6 +2296,9 @@ graph<T, AllocatorT>::move_in_as_nth_child(iter loc, size_t n, graph& other)
     if(other.head->next_sibling == other.feet)
         return loc;  // other graph is empty
 
+    // the nodes remain in the arena of the other graph
+    m_alloc.adopt(other.m_alloc);
+
     graph_node* other_first_head = other.head->next_sibling;
     graph_node* other_last_head  = other.feet->prev_sibling;
 
@@ -29,6 +29,7 @@
 #include "timemory/settings.hpp"
 #include "timemory/utility/graph.hpp"
 
+#include <array>
 #include <cstdint>
 #include <memory>
 #include <sstream>
@@ -94,18 +95,27 @@ public:
     inline void clear()
     {
         m_graph.clear();
+        m_graph.release();
         m_has_head = false;
         m_depth    = 0;
         m_current  = nullptr;
+        m_head     = nullptr;
+        clear_child_cache();
     }
 
+    /// erases everything below the head. The head and the slabs are kept so the
+    /// iterators to the head remain valid and the erased nodes are recycled by
+    /// the arena. Any other iterator into the graph is invalidated
     inline void reset()
     {
         m_graph.erase_children(m_head);
         m_depth   = 0;
         m_current = m_head;
+        clear_child_cache();
     }
 
+    graph_allocator_stats allocator_stats() const { return m_graph.allocator_stats(); }
+
     inline iterator pop_graph()
     {
         if(m_depth > 0 && !m_graph.is_head(m_current))
@@ -136,11 +146,58 @@ public:
         return m_graph.append_child(_itr, node);
     }
 
+    /// returns the cached child of the parent with the id or nullptr. The cache is
+    /// direct-mapped so repeated insertion of the same call-site below the same
+    /// parent (e.g. a wrapped function) does not search the hash maps or siblings
+    inline iterator find_child(const iterator& _parent, uint64_t _id) const
+    {
+        const auto& _entry = m_child_cache[child_cache_index(_parent, _id)];
+        if(_entry.parent == _parent.node && _entry.id == _id && _entry.child)
+            return _entry.child;
+        return nullptr;
+    }
+
+    /// the child is only cached if it is a direct descendant of the parent
+    inline void cache_child(const iterator& _parent, uint64_t _id, const iterator& _child)
+    {
+        if(!_parent.node || !_child.node || _child.node->parent != _parent.node)
+            return;
+        auto& _entry  = m_child_cache[child_cache_index(_parent, _id)];
+        _entry.parent = _parent.node;
+        _entry.id     = _id;
+        _entry.child  = _child;
+    }
+
+    inline void clear_child_cache()
+    {
+        for(auto& itr : m_child_cache)
+            itr = child_cache_entry{};
+    }
+
+private:
+    static constexpr size_t child_cache_size = 64;
+
+    struct child_cache_entry
+    {
+        const void* parent = nullptr;
+        uint64_t    id     = 0;
+        iterator    child  = nullptr;
+    };
+
+    static size_t child_cache_index(const iterator& _parent, uint64_t _id)
+    {
+        auto _val = _id ^ (reinterpret_cast<uintptr_t>(_parent.node) >> 4);
+        _val ^= _val >> 29;
+        return static_cast<size_t>(_val & (child_cache_size - 1));
+    }
+
 private:
     bool     m_has_head = false;
     int64_t  m_depth    = 0;
     graph_t  m_graph;
     iterator m_current = nullptr;
     iterator m_head    = nullptr;
+
+    std::array<child_cache_entry, child_cache_size> m_child_cache;
 };
 }  // namespace tim
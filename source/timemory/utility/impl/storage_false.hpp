@@ -258,13 +258,6 @@ protected:
         // lock if not already owned
         if(!l.owns_lock())
             l.lock();
-
-        for(const auto& _itr : (*itr->get_hash_ids()))
-            if(m_hash_ids->find(_itr.first) == m_hash_ids->end())
-                (*m_hash_ids)[_itr.first] = _itr.second;
-        for(const auto& _itr : (*itr->get_hash_aliases()))
-            if(m_hash_aliases->find(_itr.first) == m_hash_aliases->end())
-                (*m_hash_aliases)[_itr.first] = _itr.second;
     }
 
 private:
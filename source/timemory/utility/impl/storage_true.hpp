@@ -39,6 +39,7 @@
 #include "timemory/mpl/type_traits.hpp"
 #include "timemory/settings.hpp"
 #include "timemory/utility/base_storage.hpp"
+#include "timemory/utility/columnar.hpp"
 #include "timemory/utility/graph.hpp"
 #include "timemory/utility/graph_data.hpp"
 #include "timemory/utility/macros.hpp"
@@ -49,12 +50,18 @@
 
 //--------------------------------------------------------------------------------------//
 
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
 #include <cstdint>
+#include <deque>
 #include <fstream>
+#include <limits>
 #include <mutex>
 #include <sstream>
 #include <string>
 #include <thread>
+#include <tuple>
 #include <unordered_map>
 #include <unordered_set>
 #include <vector>
@@ -71,6 +78,34 @@ insert_heirarchy(uint64_t hash_id, const Type& obj, uint64_t hash_depth,
                  _HashMap& m_node_ids, _GraphData*& m_data, bool _has_head,
                  bool _is_master);
 
+inline uint64_t
+result_key(uint64_t _hash, int64_t _depth, uint64_t _rolling);
+
+template <typename _List, typename _Func>
+_List
+collapse_results(const _List& _list, _Func&& _combine);
+
+template <typename _List>
+std::vector<typename _List::size_type>
+reduce_index(_List& _dst, const _List& _src);
+
+template <typename _Tp>
+struct is_divisible : std::is_arithmetic<typename _Tp::value_type>
+{};
+
+template <typename _Tp, enable_if_t<(is_divisible<_Tp>::value), int> = 0>
+void
+divide_result(_Tp& _obj, int64_t _count)
+{
+    if(_count > 1)
+        _obj /= static_cast<typename _Tp::value_type>(_count);
+}
+
+template <typename _Tp, enable_if_t<!(is_divisible<_Tp>::value), int> = 0>
+void
+divide_result(_Tp&, int64_t)
+{}
+
 //======================================================================================//
 //
 //              Storage class for types that implement it
@@ -277,6 +312,28 @@ public:
     using uomap_t             = std::unordered_map<_Key_t, _Mapped_t>;
     using iterator_hash_map_t = uomap_t<int64_t, uomap_t<int64_t, iterator>>;
 
+protected:
+    //----------------------------------------------------------------------------------//
+    //
+    //      Entry written by the output pipeline. It references either a node in the
+    //      call-graph or a gathered result so the output never copies the call-graph
+    //
+    //----------------------------------------------------------------------------------//
+    struct output_entry
+    {
+        static constexpr size_t npos = std::numeric_limits<size_t>::max();
+
+        Type*              obj     = nullptr;  // combined object
+        int64_t            depth   = 0;
+        uint64_t           hash    = 0;
+        uint64_t           rolling = 0;
+        size_t             parent  = npos;  // index of the entry one level up
+        iterator           itr     = iterator{};
+        const result_node* result  = nullptr;
+    };
+
+    using output_entries_t = std::vector<output_entry>;
+
 public:
     //----------------------------------------------------------------------------------//
     //
@@ -288,25 +345,6 @@ public:
 
         component::state<Type>::has_storage() = true;
 
-        static std::atomic<int32_t> _skip_once(0);
-        if(_skip_once++ > 0)
-        {
-            // make sure all worker instances have a copy of the hash id and aliases
-            auto               _master       = singleton_t::master_instance();
-            graph_hash_map_t   _hash_ids     = *_master->get_hash_ids();
-            graph_hash_alias_t _hash_aliases = *_master->get_hash_aliases();
-            for(const auto& itr : _hash_ids)
-            {
-                if(m_hash_ids->find(itr.first) == m_hash_ids->end())
-                    m_hash_ids->insert({ itr.first, itr.second });
-            }
-            for(const auto& itr : _hash_aliases)
-            {
-                if(m_hash_aliases->find(itr.first) == m_hash_aliases->end())
-                    m_hash_aliases->insert({ itr.first, itr.second });
-            }
-        }
-
         get_shared_manager();
     }
 
@@ -457,6 +495,19 @@ public:
     iterator&     current() { return _data().current(); }
     graph_t&      graph() { return _data().graph(); }
 
+    //----------------------------------------------------------------------------------//
+    //
+    //----------------------------------------------------------------------------------//
+    //  erase everything below the head. The node ids refer to the erased nodes so
+    //  they are re-seeded with the head
+    //
+    void reset()
+    {
+        _data().reset();
+        m_node_ids.clear();
+        m_node_ids[0][0] = _data().head();
+    }
+
     //----------------------------------------------------------------------------------//
     //
     inline bool     empty() const { return (_data().graph().size() <= 1); }
@@ -485,6 +536,12 @@ public:
 
     const iterator_hash_map_t get_node_ids() const { return m_node_ids; }
 
+    graph_allocator_stats allocator_stats() const
+    {
+        return (m_graph_data_instance) ? m_graph_data_instance->allocator_stats()
+                                       : graph_allocator_stats{};
+    }
+
     void stack_push(Type* obj) { m_stack.insert(obj); }
     void stack_pop(Type* obj)
     {
@@ -575,8 +632,19 @@ public:
         consume_parameters(_global_init, _thread_init, _data_init);
 
         auto hash_depth = ((_data().depth() >= 0) ? (_data().depth() + 1) : 1);
-        auto itr        = insert<_Scope>(hash_id * hash_depth, obj, hash_depth);
+        auto _current   = _data().current();
+
+        // the alias was added when the cached child was inserted
+        auto _cached = _data().find_child(_current, hash_id * hash_depth);
+        if(_cached)
+        {
+            _data().depth() = _cached->depth();
+            return (_data().current() = _cached);
+        }
+
+        auto itr = insert<_Scope>(hash_id * hash_depth, obj, hash_depth);
         add_hash_id(hash_id, hash_id * hash_depth);
+        _data().cache_child(_current, hash_id * hash_depth, itr);
         return itr;
     }
 
@@ -643,10 +711,18 @@ public:
     }
 
 protected:
-    void     merge();
-    void     merge(this_type* itr);
-    string_t get_prefix(const graph_node&);
-    string_t get_prefix(iterator _node) { return get_prefix(*_node); }
+    void        merge();
+    void        merge(this_type* itr);
+    void        tree_merge(const std::vector<this_type*>& _workers);
+    static void merge_children(graph_t&, iterator, graph_t&, iterator);
+    string_t    get_prefix(const graph_node&);
+    string_t    get_prefix(iterator _node) { return get_prefix(*_node); }
+    string_t    get_node_prefix();
+    string_t    get_output_prefix(const graph_node&);
+    string_t    get_output_prefix(const output_entry&);
+    strvector_t get_output_hierarchy(const output_entry&);
+    void        get_output_entries(output_entries_t&, std::deque<Type>&);
+    void        get_output_entries(output_entries_t&, result_array_t&);
 
 protected:
     //----------------------------------------------------------------------------------//
@@ -678,6 +754,35 @@ protected:
         static void serialize(storage_t&, _Archive&, const unsigned int,
                               const result_array_t&)
         {}
+
+        template <typename _Archive, typename _Type = Type,
+                  typename std::enable_if<(is_enabled<_Type>::value), char>::type = 0>
+        static void serialize(storage_t& _obj, _Archive& ar, const unsigned int version,
+                              const output_entries_t& entries)
+        {
+            _obj.serialize_entries(ar, version, entries);
+        }
+
+        template <typename _Archive, typename _Type = Type,
+                  typename std::enable_if<!(is_enabled<_Type>::value), char>::type = 0>
+        static void serialize(storage_t&, _Archive&, const unsigned int,
+                              const output_entries_t&)
+        {}
+
+        template <typename _Type = Type,
+                  typename std::enable_if<(is_enabled<_Type>::value), char>::type = 0>
+        static void columnar(storage_t& _obj, std::ostream& os,
+                             const std::vector<output_entries_t>& entries)
+        {
+            typename tim::trait::array_serialization<Type>::type type;
+            _obj.write_columnar(type, os, entries);
+        }
+
+        template <typename _Type = Type,
+                  typename std::enable_if<!(is_enabled<_Type>::value), char>::type = 0>
+        static void columnar(storage_t&, std::ostream&,
+                             const std::vector<output_entries_t>&)
+        {}
     };
 
 public:
@@ -713,6 +818,21 @@ private:
         ar(cereal::make_nvp(_label, *this));
     }
 
+private:
+    // the roofline components write JSON-specific nodes so they cannot use the
+    // portable binary archive when transferring results between processes
+    using dmp_output_archive_t =
+        typename std::conditional<trait::requires_json<Type>::value,
+                                  cereal::JSONOutputArchive,
+                                  cereal::PortableBinaryOutputArchive>::type;
+    using dmp_input_archive_t =
+        typename std::conditional<trait::requires_json<Type>::value,
+                                  cereal::JSONInputArchive,
+                                  cereal::PortableBinaryInputArchive>::type;
+
+    // reduces the results of every rank to the min/max/mean of each call-path
+    dmp_result_t mpi_reduce(const result_array_t&, int, int, mpi::comm_t);
+
 private:
     // tim::trait::array_serialization<Type>::type == TRUE
     template <typename Archive>
@@ -724,6 +844,29 @@ private:
     void serialize_me(std::false_type, Archive&, const unsigned int,
                       const result_array_t&);
 
+    // tim::trait::array_serialization<Type>::type == TRUE
+    template <typename Archive>
+    void serialize_header(std::true_type, Archive&, const unsigned int, const Type&);
+
+    // tim::trait::array_serialization<Type>::type == FALSE
+    template <typename Archive>
+    void serialize_header(std::false_type, Archive&, const unsigned int, const Type&);
+
+    // writes the entries of the output pipeline in the same layout as serialize_me
+    template <typename Archive>
+    void serialize_entries(Archive&, const unsigned int, const output_entries_t&);
+
+    // tim::trait::array_serialization<Type>::type == TRUE
+    void columnar_labels(std::true_type, const Type&, strvector_t&, strvector_t&);
+
+    // tim::trait::array_serialization<Type>::type == FALSE
+    void columnar_labels(std::false_type, const Type&, strvector_t&, strvector_t&);
+
+    // writes the entries of every rank in the columnar binary format
+    template <typename _ArraySerialization>
+    void write_columnar(_ArraySerialization, std::ostream&,
+                        const std::vector<output_entries_t>&);
+
     void internal_print();
 
     graph_data_t&       _data();
@@ -745,20 +888,205 @@ template <typename Type>
 std::string
 storage<Type, true>::get_prefix(const graph_node& node)
 {
-    auto _ret = get_hash_identifier(m_hash_ids, m_hash_aliases, node.id());
-    if(_ret.find("unknown-hash=") == 0)
+    // the hash tables are shared by all threads so no fallback to master is needed
+    return get_hash_identifier(m_hash_ids, m_hash_aliases, node.id());
+}
+
+//======================================================================================//
+//
+//  the rank tag of the output prefix
+//
+template <typename Type>
+std::string
+storage<Type, true>::get_node_prefix()
+{
+    if(!m_node_init)
+        return std::string(">>> ");
+
+    // prefix spacing
+    static uint16_t width = 1;
+    if(m_node_size > 9)
+        width = std::max(width, (uint16_t)(log10(m_node_size) + 1));
+    std::stringstream ss;
+    ss.fill('0');
+    ss << "|" << std::setw(width) << m_node_rank << ">>> ";
+    return ss.str();
+}
+
+//======================================================================================//
+//
+//  the rank tag, the indentation for the depth, and the prefix of the node
+//
+template <typename Type>
+std::string
+storage<Type, true>::get_output_prefix(const graph_node& itr)
+{
+    std::string _prefix      = get_prefix(itr);
+    std::string _indent      = "";
+    std::string _node_prefix = get_node_prefix();
+
+    int64_t _depth = itr.depth() - 1;
+    if(_depth > 0)
     {
-        if(!m_is_master)
+        for(int64_t ii = 0; ii < _depth - 1; ++ii)
+            _indent += "  ";
+        _indent += "|_";
+    }
+
+    return _node_prefix + _indent + _prefix;
+}
+
+//======================================================================================//
+
+template <typename Type>
+std::string
+storage<Type, true>::get_output_prefix(const output_entry& _entry)
+{
+    return (_entry.result) ? _entry.result->prefix() : get_output_prefix(*_entry.itr);
+}
+
+//======================================================================================//
+
+template <typename Type>
+typename storage<Type, true>::strvector_t
+storage<Type, true>::get_output_hierarchy(const output_entry& _entry)
+{
+    if(_entry.result)
+        return _entry.result->hierarchy();
+
+    // the depth of the entry is the number of ancestors below the head
+    strvector_t _hierarchy(_entry.depth + 1);
+    auto        _itr = _entry.itr;
+    for(int64_t i = _entry.depth; i >= 0 && _itr; --i)
+    {
+        _hierarchy[i] = get_prefix(*_itr);
+        _itr          = graph_t::parent(_itr);
+    }
+    return _hierarchy;
+}
+
+//======================================================================================//
+//
+//  walks the call-graph once in pre-order and references each node in the output.
+//  When threads are collapsed, the nodes with the same hash, depth, and rolling hash
+//  as an earlier node are combined into a copy of the earlier node and the entry of
+//  the earlier node references the copy. Only these copies are allocated
+//
+template <typename Type>
+void
+storage<Type, true>::get_output_entries(output_entries_t&  _entries,
+                                        std::deque<Type>& _combined)
+{
+    static constexpr size_t npos = output_entry::npos;
+
+    // the head node should always be ignored
+    int64_t _min = std::numeric_limits<int64_t>::max();
+    for(const auto& itr : graph())
+        _min = std::min<int64_t>(_min, itr.depth());
+
+    bool _collapse =
+        settings::collapse_threads() && !trait::thread_scope_only<Type>::value;
+
+    // open-addressing table of entry indices when collapsing
+    size_t _nslots = 16;
+    while(_collapse && _nslots < 2 * graph().size())
+        _nslots <<= 1;
+    const size_t        _mask = _nslots - 1;
+    std::vector<size_t> _slots((_collapse) ? _nslots : 0, npos);
+
+    // the most recent entry at each depth
+    std::vector<size_t> _last;
+
+    _entries.reserve(_entries.size() + graph().size());
+    for(auto itr = graph().begin(); itr != graph().end(); ++itr)
+    {
+        if(!(itr->depth() > _min))
+            continue;
+
+        int64_t  _depth   = itr->depth() - (_min + 1);
+        uint64_t _rolling = itr->id();
+        for(auto _parent = graph_t::parent(itr); _parent && _parent->depth() > _min;
+            _parent      = graph_t::parent(_parent))
+            _rolling += _parent->id();
+
+        if(_last.size() <= static_cast<size_t>(_depth))
+            _last.resize(_depth + 1, npos);
+
+        size_t _idx  = _entries.size();
+        size_t _slot = npos;
+        if(_collapse)
+        {
+            _slot = impl::result_key(itr->id(), _depth, _rolling) & _mask;
+            while(_slots[_slot] != npos)
+            {
+                const auto& _entry = _entries[_slots[_slot]];
+                if(_entry.hash == itr->id() && _entry.depth == _depth &&
+                   _entry.rolling == _rolling)
+                    break;
+                _slot = (_slot + 1) & _mask;
+            }
+        }
+
+        if(_collapse && _slots[_slot] != npos)
         {
-            auto _master = singleton_t::master_instance();
-            return _master->get_prefix(node);
+            _idx        = _slots[_slot];
+            auto& _dest = _entries[_idx];
+            if(_dest.obj == &_dest.itr->obj())
+            {
+                _combined.push_back(*_dest.obj);
+                _dest.obj = &_combined.back();
+            }
+            *_dest.obj += itr->obj();
+            _dest.obj->plus(itr->obj());
         }
         else
         {
-            return get_hash_identifier(node.id());
+            output_entry _entry;
+            _entry.obj     = &itr->obj();
+            _entry.depth   = _depth;
+            _entry.hash    = itr->id();
+            _entry.rolling = _rolling;
+            _entry.parent  = (_depth > 0) ? _last[_depth - 1] : npos;
+            _entry.itr     = itr;
+            _entries.push_back(_entry);
+            if(_collapse)
+                _slots[_slot] = _idx;
         }
+        _last[_depth] = _idx;
+    }
+}
+
+//======================================================================================//
+//
+//  references the gathered results in the output
+//
+template <typename Type>
+void
+storage<Type, true>::get_output_entries(output_entries_t& _entries,
+                                        result_array_t&   _results)
+{
+    static constexpr size_t npos = output_entry::npos;
+
+    // the most recent entry at each depth
+    std::vector<size_t> _last;
+
+    _entries.reserve(_entries.size() + _results.size());
+    for(auto& itr : _results)
+    {
+        auto _depth = std::max<int64_t>(itr.depth(), 0);
+        if(_last.size() <= static_cast<size_t>(_depth))
+            _last.resize(_depth + 1, npos);
+
+        output_entry _entry;
+        _entry.obj     = &itr.data();
+        _entry.depth   = itr.depth();
+        _entry.hash    = itr.hash();
+        _entry.rolling = itr.rolling_hash();
+        _entry.parent  = (_depth > 0) ? _last[_depth - 1] : npos;
+        _entry.result  = &itr;
+        _last[_depth]  = _entries.size();
+        _entries.push_back(_entry);
     }
-    return _ret;
 }
 
 //======================================================================================//
@@ -813,8 +1141,15 @@ storage<Type, true>::merge()
     if(m_children.size() == 0)
         return;
 
-    for(auto& itr : m_children)
-        merge(itr);
+    if(settings::tree_merge() && m_children.size() > 2)
+    {
+        tree_merge(std::vector<this_type*>(m_children.begin(), m_children.end()));
+    }
+    else
+    {
+        for(auto& itr : m_children)
+            merge(itr);
+    }
 
     // create lock but don't immediately lock
     auto_lock_t l(singleton_t::get_mutex(), std::defer_lock);
@@ -825,11 +1160,220 @@ storage<Type, true>::merge()
 
     for(auto& itr : m_children)
         if(itr != this)
+        {
             itr->data().clear();
+            itr->m_node_ids.clear();
+        }
 
     stack_clear();
 }
 
+//======================================================================================//
+//
+//  Workers whose call-graph is rooted at the same node are combined pairwise in a
+//  reduction tree by one pool of threads. When the thread data is collapsed, the
+//  matching call-paths are combined during the reduction so the master lock is
+//  only held to splice the already-reduced graph of each group into the master.
+//  The nodes are moved between the graphs, never copied. Children are kept in the
+//  order of the workers, i.e. new call-paths are appended after the existing ones
+//  in the same order as merging the workers one at a time
+//
+template <typename Type>
+void
+storage<Type, true>::tree_merge(const std::vector<this_type*>& _workers)
+{
+    using sibling_iterator = typename graph_t::sibling_iterator;
+    using worker_group_t   = std::vector<this_type*>;
+    using task_t           = std::pair<this_type*, this_type*>;
+
+    //----------------------------------------------------------------------------------//
+    //  workers without any records below the head are handled by merge(this_type*)
+    //
+    auto _is_reducible = [&](this_type* itr) {
+        if(!itr || itr == this || !itr->is_initialized())
+            return false;
+        itr->stack_clear();
+        if(itr->size() == 0 || !itr->data().has_head())
+            return false;
+        return (graph_t::number_of_children(itr->data().head()) > 0);
+    };
+
+    std::vector<worker_group_t> _groups;
+    // indices of the groups which can be reduced
+    std::vector<size_t> _reducible;
+    for(auto& itr : _workers)
+    {
+        if(!_is_reducible(itr))
+        {
+            _groups.push_back(worker_group_t{ itr });
+            continue;
+        }
+
+        bool _found = false;
+        for(auto& gidx : _reducible)
+        {
+            auto& _group = _groups.at(gidx);
+            if(*_group.front()->data().head() == *itr->data().head())
+            {
+                _group.push_back(itr);
+                _found = true;
+                break;
+            }
+        }
+
+        if(!_found)
+        {
+            _reducible.push_back(_groups.size());
+            _groups.push_back(worker_group_t{ itr });
+        }
+    }
+
+    //----------------------------------------------------------------------------------//
+    //  move the children of the head of the source below the head of the target.
+    //  Without collapsing, the records of each thread must stay distinct
+    //
+    bool _match =
+        settings::collapse_threads() && !trait::thread_scope_only<Type>::value;
+
+    auto _combine = [_match](const task_t& _task) {
+        auto  _dst   = _task.first;
+        auto  _src   = _task.second;
+        auto& _dstg  = _dst->data().graph();
+        auto& _srcg  = _src->data().graph();
+        auto  _dpos  = _dst->data().head();
+        auto  _spos  = _src->data().head();
+        if(_match)
+        {
+            merge_children(_dstg, _dpos, _srcg, _spos);
+        }
+        else
+        {
+            sibling_iterator _other(_spos);
+            for(auto sitr = _other.begin(); sitr != _other.end();)
+            {
+                sibling_iterator _next = sitr;
+                ++_next;
+                _dstg.move_in_below(_dpos, _srcg, iterator(sitr));
+                sitr = _next;
+            }
+        }
+        _src->data().clear();
+        _src->m_node_ids.clear();
+    };
+
+    //----------------------------------------------------------------------------------//
+    //  tasks of every level. A level only depends on the results of the previous one
+    //
+    std::vector<std::vector<task_t>> _levels;
+    for(size_t _stride = 1;; _stride *= 2)
+    {
+        std::vector<task_t> _tasks;
+        for(auto& gitr : _groups)
+        {
+            for(size_t i = 0; i + _stride < gitr.size(); i += 2 * _stride)
+                _tasks.push_back(task_t(gitr.at(i), gitr.at(i + _stride)));
+        }
+        if(_tasks.empty())
+            break;
+        _levels.push_back(std::move(_tasks));
+    }
+
+    if(!_levels.empty())
+    {
+        if(settings::debug() || settings::verbose() > 2)
+            PRINT_HERE("[%s]> tree merge of %i pairs in %i levels",
+                       Type::label().c_str(), (int) _levels.front().size(),
+                       (int) _levels.size());
+
+        int64_t _nthreads = settings::merge_threads();
+        if(_nthreads < 1)
+            _nthreads = std::max<int64_t>(std::thread::hardware_concurrency(), 1);
+
+        std::mutex                       _mutex;
+        std::condition_variable          _cv;
+        std::vector<std::atomic<size_t>> _next(_levels.size());
+        std::vector<std::atomic<size_t>> _done(_levels.size());
+        for(size_t i = 0; i < _levels.size(); ++i)
+        {
+            _next.at(i).store(0);
+            _done.at(i).store(0);
+        }
+
+        // every thread of the pool works through all the levels with a barrier
+        // between each level
+        auto _worker = [&]() {
+            for(size_t l = 0; l < _levels.size(); ++l)
+            {
+                const auto& _tasks = _levels.at(l);
+                size_t      _idx   = 0;
+                while((_idx = _next.at(l)++) < _tasks.size())
+                {
+                    _combine(_tasks.at(_idx));
+                    if(++_done.at(l) == _tasks.size())
+                    {
+                        std::unique_lock<std::mutex> _lk(_mutex);
+                        _cv.notify_all();
+                    }
+                }
+                std::unique_lock<std::mutex> _lk(_mutex);
+                _cv.wait(_lk, [&]() { return _done.at(l).load() == _tasks.size(); });
+            }
+        };
+
+        auto _npool = std::min<int64_t>(_nthreads, _levels.front().size());
+        std::vector<std::thread> _pool;
+        for(int64_t i = 1; i < _npool; ++i)
+            _pool.push_back(std::thread(_worker));
+        _worker();
+        for(auto& itr : _pool)
+            itr.join();
+    }
+
+    //----------------------------------------------------------------------------------//
+    //  merge the result of each group into the master in order of first occurrence
+    //
+    for(auto& itr : _groups)
+        merge(itr.front());
+}
+
+//======================================================================================//
+//
+//  combine the children of the source node with the matching children of the target
+//  node (same id and depth) and move the remaining children of the source to the
+//  end of the children of the target
+//
+template <typename Type>
+void
+storage<Type, true>::merge_children(graph_t& _dst, iterator _dpos, graph_t& _src,
+                                    iterator _spos)
+{
+    using sibling_iterator = typename graph_t::sibling_iterator;
+
+    // index the existing children of the target by id
+    std::unordered_map<uint64_t, iterator> _index;
+    sibling_iterator                        _target(_dpos);
+    for(auto ditr = _target.begin(); ditr != _target.end(); ++ditr)
+        _index.insert({ ditr->id(), ditr });
+
+    sibling_iterator _source(_spos);
+    for(auto sitr = _source.begin(); sitr != _source.end();)
+    {
+        sibling_iterator _next = sitr;
+        ++_next;
+        auto _found = _index.find(sitr->id());
+        if(_found != _index.end() && *_found->second == *sitr)
+        {
+            *_found->second += *sitr;
+            merge_children(_dst, _found->second, _src, sitr);
+        }
+        else
+        {
+            _dst.move_in_below(_dpos, _src, iterator(sitr));
+        }
+        sitr = _next;
+    }
+}
+
 //======================================================================================//
 
 template <typename Type>
@@ -857,15 +1401,6 @@ storage<Type, true>::merge(this_type* itr)
     if(!l.owns_lock())
         l.lock();
 
-    auto _copy_hash_ids = [&]() {
-        for(const auto& _itr : (*itr->get_hash_ids()))
-            if(m_hash_ids->find(_itr.first) == m_hash_ids->end())
-                (*m_hash_ids)[_itr.first] = _itr.second;
-        for(const auto& _itr : (*itr->get_hash_aliases()))
-            if(m_hash_aliases->find(_itr.first) == m_hash_aliases->end())
-                (*m_hash_aliases)[_itr.first] = _itr.second;
-    };
-
     // if self is not initialized but itr is, copy data
     if(itr && itr->is_initialized() && !this->is_initialized())
     {
@@ -874,13 +1409,8 @@ storage<Type, true>::merge(this_type* itr)
         graph().insert_subgraph_after(_data().head(), itr->data().head());
         m_initialized = itr->m_initialized;
         m_finalized   = itr->m_finalized;
-        _copy_hash_ids();
         return;
     }
-    else
-    {
-        _copy_hash_ids();
-    }
 
     if(itr->size() == 0 || !itr->data().has_head())
         return;
@@ -899,10 +1429,13 @@ storage<Type, true>::merge(this_type* itr)
                                (int) this->size());
                 pre_order_iterator _pos   = _titr;
                 sibling_iterator   _other = _nitr;
-                for(auto sitr = _other.begin(); sitr != _other.end(); ++sitr)
+                for(auto sitr = _other.begin(); sitr != _other.end();)
                 {
-                    pre_order_iterator pitr = sitr;
-                    graph().append_child(_pos, pitr);
+                    sibling_iterator _next = sitr;
+                    ++_next;
+                    graph().move_in_below(_pos, itr->data().graph(),
+                                          pre_order_iterator(sitr));
+                    sitr = _next;
                 }
                 _merged = true;
                 if(settings::debug() || settings::verbose() > 2)
@@ -938,6 +1471,7 @@ storage<Type, true>::merge(this_type* itr)
     }
 
     itr->data().clear();
+    itr->m_node_ids.clear();
 }
 
 //======================================================================================//
@@ -946,50 +1480,9 @@ template <typename Type>
 typename storage<Type, true>::result_array_t
 storage<Type, true>::get()
 {
-    //------------------------------------------------------------------------------//
-    //
-    //  Compute the node prefix
-    //
-    //------------------------------------------------------------------------------//
-    auto _get_node_prefix = [&]() {
-        if(!m_node_init)
-            return std::string(">>> ");
-
-        // prefix spacing
-        static uint16_t width = 1;
-        if(m_node_size > 9)
-            width = std::max(width, (uint16_t)(log10(m_node_size) + 1));
-        std::stringstream ss;
-        ss.fill('0');
-        ss << "|" << std::setw(width) << m_node_rank << ">>> ";
-        return ss.str();
-    };
-
-    //------------------------------------------------------------------------------//
-    //
-    //  Compute the indentation
-    //
-    //------------------------------------------------------------------------------//
-    // fix up the prefix based on the actual depth
-    auto _compute_modified_prefix = [&](const graph_node& itr) {
-        std::string _prefix      = get_prefix(itr);
-        std::string _indent      = "";
-        std::string _node_prefix = _get_node_prefix();
-
-        int64_t _depth = itr.depth() - 1;
-        if(_depth > 0)
-        {
-            for(int64_t ii = 0; ii < _depth - 1; ++ii)
-                _indent += "  ";
-            _indent += "|_";
-        }
-
-        return _node_prefix + _indent + _prefix;
-    };
-
-    // convert graph to a vector
-    auto convert_graph = [&]() {
-        result_array_t _list;
+    // convert graph to a vector
+    auto convert_graph = [&]() {
+        result_array_t _list;
         {
             // the head node should always be ignored
             int64_t _min = std::numeric_limits<int64_t>::max();
@@ -1001,7 +1494,7 @@ storage<Type, true>::get()
                 if(itr->depth() > _min)
                 {
                     auto        _depth   = itr->depth() - (_min + 1);
-                    auto        _prefix  = _compute_modified_prefix(*itr);
+                    auto        _prefix  = get_output_prefix(*itr);
                     auto        _rolling = itr->id();
                     auto        _parent  = graph_t::parent(itr);
                     strvector_t _hierarchy;
@@ -1030,45 +1523,15 @@ storage<Type, true>::get()
         if(!settings::collapse_threads() || _thread_scope_only)
             return _list;
 
-        result_array_t _combined;
-
-        //--------------------------------------------------------------------------//
-        //
-        auto _equiv = [&](const result_node& _lhs, const result_node& _rhs) {
-            return (std::get<0>(_lhs) == std::get<0>(_rhs) &&
-                    std::get<2>(_lhs) == std::get<2>(_rhs) &&
-                    std::get<3>(_lhs) == std::get<3>(_rhs) &&
-                    std::get<4>(_lhs) == std::get<4>(_rhs));
-        };
-
         //--------------------------------------------------------------------------//
+        //  collapse duplicates
         //
-        auto _exists = [&](const result_node& _lhs) {
-            for(auto itr = _combined.begin(); itr != _combined.end(); ++itr)
-            {
-                if(_equiv(_lhs, *itr))
-                    return itr;
-            }
-            return _combined.end();
+        auto _combine = [](result_node& _lhs, const result_node& _rhs) {
+            std::get<1>(_lhs) += std::get<1>(_rhs);
+            std::get<1>(_lhs).plus(std::get<1>(_rhs));
         };
 
-        //--------------------------------------------------------------------------//
-        //  collapse duplicates
-        //
-        for(const auto& itr : _list)
-        {
-            auto citr = _exists(itr);
-            if(citr == _combined.end())
-            {
-                _combined.push_back(itr);
-            }
-            else
-            {
-                std::get<1>(*citr) += std::get<1>(itr);
-                std::get<1>(*citr).plus(std::get<1>(itr));
-            }
-        }
-        return _combined;
+        return impl::collapse_results(_list, _combine);
     };
 
     return convert_graph();
@@ -1106,9 +1569,7 @@ storage<Type, true>::mpi_get()
     auto send_serialize = [&](const result_array_t& src) {
         std::stringstream ss;
         {
-            auto space = cereal::JSONOutputArchive::Options::IndentChar::space;
-            cereal::JSONOutputArchive::Options opt(16, space, 0);
-            cereal::JSONOutputArchive oa(ss);
+            dmp_output_archive_t oa(ss);
             oa(cereal::make_nvp("data", src));
         }
         return ss.str();
@@ -1122,7 +1583,7 @@ storage<Type, true>::mpi_get()
         std::stringstream ss;
         ss << src;
         {
-            cereal::JSONInputArchive ia(ss);
+            dmp_input_archive_t ia(ss);
             ia(cereal::make_nvp("data", ret));
             if(settings::debug())
                 printf("[RECV: %i]> data size: %lli\n", mpi_rank,
@@ -1131,35 +1592,145 @@ storage<Type, true>::mpi_get()
         return ret;
     };
 
+    auto ret = get();
+
+    if(settings::mpi_reduce())
+        return mpi_reduce(ret, mpi_rank, mpi_size, comm);
+
+    //------------------------------------------------------------------------------//
+    //  Collect every rank's serialization on rank 0 with a single gather
+    //
+    std::vector<std::string> _strs;
+    if(settings::debug())
+        printf("[GATHER: %i]> starting\n", mpi_rank);
+    mpi::gather(send_serialize(ret), _strs, 0, comm);
+    if(settings::debug())
+        printf("[GATHER: %i]> completed\n", mpi_rank);
+
+    if(mpi_rank != 0)
+        return dmp_result_t(1, ret);
+
     dmp_result_t results(mpi_size);
+    for(int i = 0; i < mpi_size; ++i)
+    {
+        if(i == mpi_rank)
+            results[i] = ret;
+        else
+            results[i] = recv_serialize(_strs[i]);
+        // release the serialization as soon as it is converted
+        std::string().swap(_strs[i]);
+    }
 
-    auto ret = get();
-    auto str_ret = send_serialize(ret);
+    return results;
+#endif
+}
 
-    if(mpi_rank == 0)
+//======================================================================================//
+//
+//  binomial tree reduction: at each step, the ranks which are an odd multiple of the
+//  step send their partial reduction to the rank one step below and drop out. Identical
+//  call-paths are merged on the way up so no rank ever holds more than one copy of
+//  each call-path (times three for the min, max, and sum). Rank 0 returns the min, max,
+//  and mean as three separate result arrays. The lap counts of the mean are the totals
+//
+template <typename Type>
+typename storage<Type, true>::dmp_result_t
+storage<Type, true>::mpi_reduce(const result_array_t& _ret, int mpi_rank, int mpi_size,
+                                mpi::comm_t comm)
+{
+#if !defined(TIMEMORY_USE_MPI)
+    consume_parameters(mpi_rank, mpi_size, comm);
+    return dmp_result_t(1, _ret);
+#else
+    using count_array_t = std::vector<int64_t>;
+
+    // remove the rank tag from the prefix so that the call-paths match across ranks
+    result_array_t _min = _ret;
+    for(auto& itr : _min)
     {
-        for(int i = 1; i < mpi_size; ++i)
+        auto _pos = itr.prefix().find(">>> ");
+        if(_pos != std::string::npos)
+            itr.prefix() = itr.prefix().substr(_pos + 4);
+    }
+    result_array_t _max = _min;
+    result_array_t _sum = _min;
+    count_array_t  _count(_sum.size(), 1);
+
+    for(int _step = 1; _step < mpi_size; _step *= 2)
+    {
+        if(mpi_rank % (2 * _step) != 0)
         {
-            std::string str;
+            std::stringstream ss;
+            {
+                dmp_output_archive_t oa(ss);
+                oa(cereal::make_nvp("min", _min), cereal::make_nvp("max", _max),
+                   cereal::make_nvp("sum", _sum), cereal::make_nvp("count", _count));
+            }
             if(settings::debug())
-                printf("[RECV: %i]> starting %i\n", mpi_rank, i);
-            mpi::recv(str, i, 0, comm);
+                printf("[REDUCE: %i]> sending to %i\n", mpi_rank, mpi_rank - _step);
+            mpi::send(ss.str(), mpi_rank - _step, 0, comm);
+            break;
+        }
+
+        if(mpi_rank + _step >= mpi_size)
+            continue;
+
+        result_array_t _rmin;
+        result_array_t _rmax;
+        result_array_t _rsum;
+        count_array_t  _rcount;
+        {
+            std::string _str;
             if(settings::debug())
-                printf("[RECV: %i]> completed %i\n", mpi_rank, i);
-            results[i] = recv_serialize(str);
+                printf("[REDUCE: %i]> receiving from %i\n", mpi_rank, mpi_rank + _step);
+            mpi::recv(_str, mpi_rank + _step, 0, comm);
+            std::stringstream ss;
+            ss << _str;
+            dmp_input_archive_t ia(ss);
+            ia(cereal::make_nvp("min", _rmin), cereal::make_nvp("max", _rmax),
+               cereal::make_nvp("sum", _rsum), cereal::make_nvp("count", _rcount));
+        }
+
+        auto _index = impl::reduce_index(_sum, _rsum);
+        for(size_t i = 0; i < _index.size(); ++i)
+        {
+            auto j = _index[i];
+            if(j == _min.size())
+            {
+                // call-path was not on this rank
+                _min.push_back(_rmin[i]);
+                _max.push_back(_rmax[i]);
+                _count.push_back(_rcount[i]);
+                continue;
+            }
+            if(_rmin[i].data() < _min[j].data())
+                _min[j].data() = _rmin[i].data();
+            if(_max[j].data() < _rmax[i].data())
+                _max[j].data() = _rmax[i].data();
+            _sum[j].data() += _rsum[i].data();
+            _sum[j].data().plus(_rsum[i].data());
+            _count[j] += _rcount[i];
         }
-        results[mpi_rank] = ret;
     }
-    else
+
+    if(mpi_rank != 0)
+        return dmp_result_t(1, _ret);
+
+    // the mean is only available when the value type is divisible, otherwise the sum
+    // is reported
+    auto _mean_tag = (impl::is_divisible<Type>::value) ? "|mean>>> " : "|sum>>> ";
+    for(size_t i = 0; i < _sum.size(); ++i)
     {
-        if(settings::debug())
-            printf("[SEND: %i]> starting\n", mpi_rank);
-        mpi::send(str_ret, 0, 0, comm);
-        if(settings::debug())
-            printf("[SEND: %i]> completed\n", mpi_rank);
-        return dmp_result_t(1, ret);
+        impl::divide_result(_sum[i].data(), _count[i]);
+        _min[i].prefix() = "|min>>> " + _min[i].prefix();
+        _max[i].prefix() = "|max>>> " + _max[i].prefix();
+        _sum[i].prefix() = _mean_tag + _sum[i].prefix();
     }
 
+    dmp_result_t results;
+    results.emplace_back(std::move(_min));
+    results.emplace_back(std::move(_max));
+    results.emplace_back(std::move(_sum));
     return results;
 #endif
 }
@@ -1297,9 +1868,32 @@ storage<Type, true>::internal_print()
             return;
         }
 
+        if(settings::debug() || settings::verbose() > 1)
+        {
+            std::stringstream _ss;
+            _ss << allocator_stats();
+            printf("[%s]|%i> graph allocator :: %s\n", label.c_str(), m_node_rank,
+                   _ss.str().c_str());
+        }
+
+        // a single process writes the output directly from the call-graph. Otherwise,
+        // the results of every rank are gathered and the root rank writes them
+        bool _stream = (mpi::size() <= 1 && upc::size() <= 1);
+
+        std::vector<output_entries_t> _entries;
+        std::deque<Type>              _combined;
+        dmp_result_t                  _dmp_results;
+
         dmp::barrier();
-        auto _results     = this->get();
-        auto _dmp_results = this->dmp_get();
+        if(_stream)
+        {
+            _entries.resize(1);
+            get_output_entries(_entries.front(), _combined);
+        }
+        else
+        {
+            _dmp_results = this->dmp_get();
+        }
         dmp::barrier();
 
         if(settings::debug())
@@ -1316,12 +1910,9 @@ storage<Type, true>::internal_print()
                 return;
             else
             {
-                _results.clear();
-                for(const auto& sitr : _dmp_results)
-                {
-                    for(const auto& ritr : sitr)
-                        _results.push_back(ritr);
-                }
+                _entries.resize(_dmp_results.size());
+                for(size_t i = 0; i < _dmp_results.size(); ++i)
+                    get_output_entries(_entries.at(i), _dmp_results.at(i));
             }
         }
 
@@ -1330,22 +1921,26 @@ storage<Type, true>::internal_print()
         {
             printf("\n");
             size_t w = 0;
-            for(const auto& itr : _results)
-                w = std::max<size_t>(w, itr.prefix().length());
-            for(const auto& itr : _results)
+            for(const auto& eitr : _entries)
+                for(const auto& itr : eitr)
+                    w = std::max<size_t>(w, get_output_prefix(itr).length());
+            for(const auto& eitr : _entries)
             {
-                std::cout << std::setw(w) << std::left << itr.prefix() << " : "
-                          << itr.data();
-                auto _hierarchy = itr.hierarchy();
-                for(size_t i = 0; i < _hierarchy.size(); ++i)
+                for(const auto& itr : eitr)
                 {
-                    if(i == 0)
-                        std::cout << " :: ";
-                    std::cout << _hierarchy[i];
-                    if(i + 1 < _hierarchy.size())
-                        std::cout << "/";
+                    std::cout << std::setw(w) << std::left << get_output_prefix(itr)
+                              << " : " << *itr.obj;
+                    auto _hierarchy = get_output_hierarchy(itr);
+                    for(size_t i = 0; i < _hierarchy.size(); ++i)
+                    {
+                        if(i == 0)
+                            std::cout << " :: ";
+                        std::cout << _hierarchy[i];
+                        if(i + 1 < _hierarchy.size())
+                            std::cout << "/";
+                    }
+                    std::cout << std::endl;
                 }
-                std::cout << std::endl;
             }
             printf("\n");
         }
@@ -1355,16 +1950,15 @@ storage<Type, true>::internal_print()
         int64_t _max_depth = 0;
         int64_t _max_laps  = 0;
         // find the max width
-        for(const auto mitr : _dmp_results)
+        for(const auto& eitr : _entries)
         {
-            for(const auto& itr : mitr)
+            for(const auto& itr : eitr)
             {
-                const auto& itr_obj    = itr.data();
-                const auto& itr_prefix = itr.prefix();
-                const auto& itr_depth  = itr.depth();
+                const auto& itr_obj   = *itr.obj;
+                const auto& itr_depth = itr.depth;
                 if(itr_depth < 0 || itr_depth > settings::max_depth())
                     continue;
-                int64_t _len = itr_prefix.length();
+                int64_t _len = get_output_prefix(itr).length();
                 _width       = std::max(_len, _width);
                 _max_depth   = std::max<int64_t>(_max_depth, itr_depth);
                 _max_laps    = std::max<int64_t>(_max_laps, itr_obj.nlaps());
@@ -1418,12 +2012,12 @@ storage<Type, true>::internal_print()
                         oa.setNextName("ranks");
                         oa.startNode();
                         oa.makeArray();
-                        for(uint64_t i = 0; i < _dmp_results.size(); ++i)
+                        for(uint64_t i = 0; i < _entries.size(); ++i)
                         {
                             oa.startNode();
                             oa(cereal::make_nvp("rank", i));
                             oa(cereal::make_nvp("concurrency", num_instances));
-                            serial_write_t::serialize(*this, oa, 1, _dmp_results.at(i));
+                            serial_write_t::serialize(*this, oa, 1, _entries.at(i));
                             oa.finishNode();
                         }
                         oa.finishNode();
@@ -1440,6 +2034,32 @@ storage<Type, true>::internal_print()
             printf("\n");
         }
 
+        //--------------------------------------------------------------------------//
+        // output to columnar binary file
+        //
+        if(_file_output && settings::binary_output())
+        {
+            auto bname = settings::compose_output_filename(label, ".tmb");
+            if(bname.length() > 0)
+            {
+                using serial_write_t = write_serialization<this_type>;
+                std::ofstream ofs(bname.c_str(), std::ios::out | std::ios::binary);
+                if(ofs)
+                {
+                    printf("[%s]|%i> Outputting '%s'...\n", label.c_str(), m_node_rank,
+                           bname.c_str());
+                    add_binary_output(label, bname);
+                    serial_write_t::columnar(*this, ofs, _entries);
+                }
+                else
+                {
+                    fprintf(stderr, "[storage<%s>::%s @ %i]|%i> Error opening '%s'...\n",
+                            label.c_str(), __FUNCTION__, __LINE__, m_node_rank,
+                            bname.c_str());
+                }
+            }
+        }
+
         //--------------------------------------------------------------------------//
         // output to text file
         //
@@ -1475,76 +2095,55 @@ storage<Type, true>::internal_print()
             printf("\n");
         }
 
-        for(auto itr = _results.begin(); itr != _results.end(); ++itr)
+        for(const auto& eitr : _entries)
         {
-            auto& itr_obj    = std::get<1>(*itr);
-            auto& itr_prefix = std::get<2>(*itr);
-            auto& itr_depth  = std::get<3>(*itr);
+            if(cout == nullptr && fout == nullptr)
+                break;
 
-            if(itr_depth < 0 || itr_depth > settings::max_depth())
-                continue;
-            std::stringstream _pss;
-            // if we are not at the bottom of the call stack (i.e. completely
-            // inclusive)
-            if(itr_depth < _max_depth)
+            // the sum of the exclusive values, i.e. the entries one level down
+            std::vector<int64_t>         nexclusive(eitr.size(), 0);
+            std::vector<get_return_type> exclusive_values(eitr.size());
+            for(const auto& itr : eitr)
             {
-                // get the next iteration
-                auto eitr = itr;
-                std::advance(eitr, 1);
-                // counts the number of non-exclusive values
-                int64_t nexclusive = 0;
-                // the sum of the exclusive values
-                get_return_type exclusive_values;
-                // continue while not at end of graph until first sibling is
-                // encountered
-                if(eitr != _results.end())
-                {
-                    auto eitr_depth = std::get<3>(*eitr);
-                    while(eitr_depth != itr_depth)
-                    {
-                        auto& eitr_obj = std::get<1>(*eitr);
+                if(itr.parent == output_entry::npos)
+                    continue;
+                // if first exclusive value encountered: assign; else: combine
+                if(nexclusive.at(itr.parent)++ == 0)
+                    exclusive_values.at(itr.parent) = itr.obj->get();
+                else
+                    math::combine(exclusive_values.at(itr.parent), itr.obj->get());
+            }
 
-                        // if one level down, this is an exclusive value
-                        if(eitr_depth == itr_depth + 1)
-                        {
-                            // if first exclusive value encountered: assign; else:
-                            // combine
-                            if(nexclusive == 0)
-                                exclusive_values = eitr_obj.get();
-                            else
-                                math::combine(exclusive_values, eitr_obj.get());
-                            // increment. beyond 0 vs. 1, this value plays no role
-                            ++nexclusive;
-                        }
-                        // increment iterator for next while check
-                        ++eitr;
-                        if(eitr == _results.end())
-                            break;
-                        eitr_depth = std::get<3>(*eitr);
-                    }
-                    // if there were exclusive values encountered
-                    if(nexclusive > 0 && trait::is_available<Type>::value)
-                    {
-                        math::print_percentage(
-                            _pss,
-                            math::compute_percentage(exclusive_values, itr_obj.get()));
-                    }
+            for(size_t i = 0; i < eitr.size(); ++i)
+            {
+                const auto& itr_obj   = *eitr.at(i).obj;
+                const auto& itr_depth = eitr.at(i).depth;
+
+                if(itr_depth < 0 || itr_depth > settings::max_depth())
+                    continue;
+                std::stringstream _pss;
+                // if we are not at the bottom of the call stack (i.e. completely
+                // inclusive) and there were exclusive values encountered
+                if(itr_depth < _max_depth && nexclusive.at(i) > 0 &&
+                   trait::is_available<Type>::value)
+                {
+                    math::print_percentage(
+                        _pss,
+                        math::compute_percentage(exclusive_values.at(i), itr_obj.get()));
                 }
-            }
 
-            auto _laps = itr_obj.nlaps();
+                auto _laps   = itr_obj.nlaps();
+                auto _prefix = get_output_prefix(eitr.at(i));
 
-            std::stringstream _oss;
-            operation::print<Type>(itr_obj, _oss, itr_prefix, _laps, itr_depth, _widths,
-                                   true, _pss.str());
-            // for(const auto& itr : itr->hierarchy())
-            //    _oss << itr << "//";
-            // _oss << "\n";
+                std::stringstream _oss;
+                operation::print<Type>(itr_obj, _oss, _prefix, _laps, itr_depth, _widths,
+                                       true, _pss.str());
 
-            if(cout != nullptr)
-                *cout << _oss.str() << std::flush;
-            if(fout != nullptr)
-                *fout << _oss.str() << std::flush;
+                if(cout != nullptr)
+                    *cout << _oss.str() << std::flush;
+                if(fout != nullptr)
+                    *fout << _oss.str() << std::flush;
+            }
         }
 
         if(fout)
@@ -1569,21 +2168,21 @@ storage<Type, true>::internal_print()
         {
             printf("\n");
             uint64_t _nitr = 0;
-            for(auto& itr : _results)
+            for(const auto& eitr : _entries)
             {
-                auto& itr_depth = itr.depth();
-
-                if(itr_depth < 0 || itr_depth > settings::max_depth())
-                    continue;
+                for(const auto& itr : eitr)
+                {
+                    if(itr.depth < 0 || itr.depth > settings::max_depth())
+                        continue;
 
-                // if only a specific number of measurements should be echoed
-                if(settings::dart_count() > 0 && _nitr >= settings::dart_count())
-                    continue;
+                    // if only a specific number of measurements should be echoed
+                    if(settings::dart_count() > 0 && _nitr >= settings::dart_count())
+                        continue;
 
-                auto& itr_obj       = itr.data();
-                auto& itr_hierarchy = itr.hierarchy();
-                operation::echo_measurement<Type>(itr_obj, itr_hierarchy);
-                ++_nitr;
+                    operation::echo_measurement<Type>(*itr.obj,
+                                                      get_output_hierarchy(itr));
+                    ++_nitr;
+                }
             }
         }
         instance_count().store(0);
@@ -1609,11 +2208,7 @@ storage<Type, true>::serialize_me(std::false_type, Archive& ar,
     if(graph_list.size() == 0)
         return;
 
-    ar(cereal::make_nvp("type", Type::label()),
-       cereal::make_nvp("description", Type::description()),
-       cereal::make_nvp("unit_value", Type::unit()),
-       cereal::make_nvp("unit_repr", Type::display_unit()));
-    Type::extra_serialization(ar, version);
+    serialize_header(std::false_type{}, ar, version, graph_list.front().data());
     ar.setNextName("graph");
     ar.startNode();
     ar.makeArray();
@@ -1638,10 +2233,45 @@ storage<Type, true>::serialize_me(std::true_type, Archive& ar, const unsigned in
     if(graph_list.size() == 0)
         return;
 
-    // remove those const in case not marked const
-    auto& _graph_list = const_cast<result_array_t&>(graph_list);
+    serialize_header(std::true_type{}, ar, version, graph_list.front().data());
+    ar.setNextName("graph");
+    ar.startNode();
+    ar.makeArray();
+    for(auto& itr : graph_list)
+    {
+        ar.startNode();
+        ar(cereal::make_nvp("hash", itr.hash()), cereal::make_nvp("prefix", itr.prefix()),
+           cereal::make_nvp("depth", itr.depth()), cereal::make_nvp("entry", itr.data()));
+        ar.finishNode();
+    }
+    ar.finishNode();
+}
+
+//======================================================================================//
 
-    Type& obj           = _graph_list.front().data();
+template <typename Type>
+template <typename Archive>
+void
+storage<Type, true>::serialize_header(std::false_type, Archive& ar,
+                                      const unsigned int version, const Type&)
+{
+    ar(cereal::make_nvp("type", Type::label()),
+       cereal::make_nvp("description", Type::description()),
+       cereal::make_nvp("unit_value", Type::unit()),
+       cereal::make_nvp("unit_repr", Type::display_unit()));
+    Type::extra_serialization(ar, version);
+}
+
+//======================================================================================//
+
+template <typename Type>
+template <typename Archive>
+void
+storage<Type, true>::serialize_header(std::true_type, Archive& ar,
+                                      const unsigned int version, const Type& _obj)
+{
+    // remove those const in case not marked const
+    Type& obj           = const_cast<Type&>(_obj);
     auto  labels        = obj.label_array();
     auto  descripts     = obj.descript_array();
     auto  units         = obj.unit_array();
@@ -1650,14 +2280,30 @@ storage<Type, true>::serialize_me(std::true_type, Archive& ar, const unsigned in
        cereal::make_nvp("unit_value", units),
        cereal::make_nvp("unit_repr", display_units));
     Type::extra_serialization(ar, version);
+}
+
+//======================================================================================//
+
+template <typename Type>
+template <typename Archive>
+void
+storage<Type, true>::serialize_entries(Archive& ar, const unsigned int version,
+                                       const output_entries_t& _entries)
+{
+    if(_entries.size() == 0)
+        return;
+
+    typename tim::trait::array_serialization<Type>::type type;
+    serialize_header(type, ar, version, *_entries.front().obj);
     ar.setNextName("graph");
     ar.startNode();
     ar.makeArray();
-    for(auto& itr : graph_list)
+    for(const auto& itr : _entries)
     {
+        auto _prefix = get_output_prefix(itr);
         ar.startNode();
-        ar(cereal::make_nvp("hash", itr.hash()), cereal::make_nvp("prefix", itr.prefix()),
-           cereal::make_nvp("depth", itr.depth()), cereal::make_nvp("entry", itr.data()));
+        ar(cereal::make_nvp("hash", itr.hash), cereal::make_nvp("prefix", _prefix),
+           cereal::make_nvp("depth", itr.depth), cereal::make_nvp("entry", *itr.obj));
         ar.finishNode();
     }
     ar.finishNode();
@@ -1665,6 +2311,120 @@ storage<Type, true>::serialize_me(std::true_type, Archive& ar, const unsigned in
 
 //======================================================================================//
 
+template <typename Type>
+void
+storage<Type, true>::columnar_labels(std::false_type, const Type&, strvector_t& labels,
+                                     strvector_t& units)
+{
+    labels = { Type::label() };
+    units  = { Type::display_unit() };
+}
+
+//======================================================================================//
+
+template <typename Type>
+void
+storage<Type, true>::columnar_labels(std::true_type, const Type& _obj,
+                                     strvector_t& labels, strvector_t& units)
+{
+    // remove those const in case not marked const
+    Type& obj     = const_cast<Type&>(_obj);
+    auto  _labels = obj.label_array();
+    auto  _units  = obj.display_unit_array();
+    labels.assign(_labels.begin(), _labels.end());
+    units.assign(_units.begin(), _units.end());
+}
+
+//======================================================================================//
+//
+//  the columns are the flattened values of get(), get_value(), and get_accum() of the
+//  first entry. The prefix of each node is the bare label without the rank tag or the
+//  indentation since the reader has the depth and the parent
+//
+template <typename Type>
+template <typename _ArraySerialization>
+void
+storage<Type, true>::write_columnar(_ArraySerialization type, std::ostream& os,
+                                    const std::vector<output_entries_t>& _entries)
+{
+    using get_return_type = decay_t<decltype(std::declval<const Type>().get())>;
+    using value_type      = typename Type::value_type;
+
+    const Type* _first = nullptr;
+    for(const auto& eitr : _entries)
+    {
+        if(eitr.size() > 0)
+        {
+            _first = eitr.front().obj;
+            break;
+        }
+    }
+    if(!_first)
+        return;
+
+    strvector_t _labels;
+    strvector_t _units;
+    columnar_labels(type, *_first, _labels, _units);
+
+    auto _name = [&](size_t i, size_t n) {
+        if(_labels.size() == n)
+            return _labels.at(i);
+        return (n == 1) ? Type::label() : Type::label() + "[" + std::to_string(i) + "]";
+    };
+    auto _unit = [&](size_t i, size_t n) {
+        if(_units.size() == n)
+            return _units.at(i);
+        return (_units.size() == 1) ? _units.front() : std::string("");
+    };
+
+    std::vector<double> _values;
+    columnar::flatten<get_return_type>::apply(_first->get(), _values);
+    auto _nrepr = _values.size();
+    _values.clear();
+    columnar::flatten<value_type>::apply(_first->get_value(), _values);
+    auto _nvalue = _values.size();
+
+    columnar::writer _writer(Type::label(), Type::description(), Type::display_unit(),
+                             instance_count().load());
+    for(size_t i = 0; i < _nrepr; ++i)
+        _writer.add_column(_name(i, _nrepr), _unit(i, _nrepr), columnar::repr, i);
+    for(size_t i = 0; i < _nvalue; ++i)
+        _writer.add_column(_name(i, _nvalue), "", columnar::value, i);
+    for(size_t i = 0; i < _nvalue; ++i)
+        _writer.add_column(_name(i, _nvalue), "", columnar::accum, i);
+
+    for(size_t r = 0; r < _entries.size(); ++r)
+    {
+        // parent indices are relative to the entries of the rank
+        auto _offset = static_cast<int64_t>(_writer.size());
+        for(const auto& itr : _entries.at(r))
+        {
+            const auto& _obj = *itr.obj;
+            _values.clear();
+            columnar::flatten<get_return_type>::apply(_obj.get(), _values);
+            _values.resize(_nrepr, std::numeric_limits<double>::quiet_NaN());
+            columnar::flatten<value_type>::apply(_obj.get_value(), _values);
+            _values.resize(_nrepr + _nvalue, std::numeric_limits<double>::quiet_NaN());
+            columnar::flatten<value_type>::apply(_obj.get_accum(), _values);
+
+            auto _parent = (itr.parent == output_entry::npos)
+                               ? int64_t(-1)
+                               : _offset + static_cast<int64_t>(itr.parent);
+            auto _prefix = (!itr.result) ? get_prefix(*itr.itr)
+                                         : (itr.result->hierarchy().empty())
+                                               ? itr.result->prefix()
+                                               : itr.result->hierarchy().back();
+            auto _flags  = (_obj.get_is_transient()) ? columnar::transient : 0;
+            _writer.add_node(itr.hash, _parent, itr.depth, _obj.nlaps(), r, _flags,
+                             _prefix, _values);
+        }
+    }
+
+    _writer.write(os);
+}
+
+//======================================================================================//
+
 template <typename StorageType, typename Type, typename _HashMap, typename _GraphData>
 typename StorageType::iterator
 insert_heirarchy(uint64_t hash_id, const Type& obj, uint64_t hash_depth,
@@ -1743,6 +2503,158 @@ insert_heirarchy(uint64_t hash_id, const Type& obj, uint64_t hash_depth,
     return _insert_child();
 }
 
+//======================================================================================//
+//
+//  mixes the hash, depth, and rolling hash (elements 0, 3, and 4) of a result entry
+//
+inline uint64_t
+result_key(uint64_t _hash, int64_t _depth, uint64_t _rolling)
+{
+    uint64_t _key = _hash;
+    _key ^= static_cast<uint64_t>(_depth) * 0x9e3779b97f4a7c15ULL;
+    _key ^= _rolling + 0x9e3779b97f4a7c15ULL + (_key << 6) + (_key >> 2);
+    _key ^= _key >> 33;
+    _key *= 0xff51afd7ed558ccdULL;
+    _key ^= _key >> 33;
+    return _key;
+}
+
+template <typename _Tp>
+uint64_t
+result_key(const _Tp& _v)
+{
+    return result_key(std::get<0>(_v), std::get<3>(_v), std::get<4>(_v));
+}
+
+//--------------------------------------------------------------------------------------//
+//
+//  result entries are equivalent when the hash, depth, rolling hash, and prefix match
+//
+template <typename _Tp>
+bool
+result_equiv(const _Tp& _lhs, const _Tp& _rhs)
+{
+    return (std::get<0>(_lhs) == std::get<0>(_rhs) &&
+            std::get<3>(_lhs) == std::get<3>(_rhs) &&
+            std::get<4>(_lhs) == std::get<4>(_rhs) &&
+            std::get<2>(_lhs) == std::get<2>(_rhs));
+}
+
+//--------------------------------------------------------------------------------------//
+//
+//  combines the entries of the list with the same hash, depth, and rolling hash
+//  (elements 0, 3, and 4 of the result tuple) in a single pass using an
+//  open-addressing table of indices. The prefix (element 2) is only compared
+//  when these match. The order of the first occurrence of each entry is preserved
+//
+template <typename _List, typename _Func>
+_List
+collapse_results(const _List& _list, _Func&& _combine)
+{
+    using size_type = typename _List::size_type;
+
+    static const size_type npos = std::numeric_limits<size_type>::max();
+
+    // keep the load factor at or below one-half
+    size_type _nslots = 16;
+    while(_nslots < 2 * _list.size())
+        _nslots <<= 1;
+    const size_type _mask = _nslots - 1;
+
+    std::vector<size_type> _slots(_nslots, npos);
+    std::vector<uint64_t>  _keys;
+    _List                  _combined;
+    _keys.reserve(_list.size());
+    _combined.reserve(_list.size());
+
+    for(const auto& itr : _list)
+    {
+        auto _key = result_key(itr);
+        auto _idx = static_cast<size_type>(_key) & _mask;
+        while(_slots[_idx] != npos)
+        {
+            auto _pos = _slots[_idx];
+            if(_keys[_pos] == _key && result_equiv(_combined[_pos], itr))
+                break;
+            _idx = (_idx + 1) & _mask;
+        }
+
+        if(_slots[_idx] == npos)
+        {
+            _slots[_idx] = _combined.size();
+            _keys.push_back(_key);
+            _combined.push_back(itr);
+        }
+        else
+        {
+            _combine(_combined[_slots[_idx]], itr);
+        }
+    }
+    return _combined;
+}
+
+//--------------------------------------------------------------------------------------//
+//
+//  maps each entry of the source list to the index of the equivalent entry in the
+//  destination list. Source entries without an equivalent are appended to the
+//  destination so the returned index of a new entry is the destination size at the
+//  time it was appended
+//
+template <typename _List>
+std::vector<typename _List::size_type>
+reduce_index(_List& _dst, const _List& _src)
+{
+    using size_type = typename _List::size_type;
+
+    static const size_type npos = std::numeric_limits<size_type>::max();
+
+    size_type _nslots = 16;
+    while(_nslots < 2 * (_dst.size() + _src.size()))
+        _nslots <<= 1;
+    const size_type _mask = _nslots - 1;
+
+    std::vector<size_type> _slots(_nslots, npos);
+    std::vector<uint64_t>  _keys;
+    std::vector<size_type> _index;
+    _keys.reserve(_dst.size() + _src.size());
+    _index.reserve(_src.size());
+
+    auto _find = [&](const typename _List::value_type& _v, uint64_t _key) {
+        auto _idx = static_cast<size_type>(_key) & _mask;
+        while(_slots[_idx] != npos)
+        {
+            auto _pos = _slots[_idx];
+            if(_keys[_pos] == _key && result_equiv(_dst[_pos], _v))
+                break;
+            _idx = (_idx + 1) & _mask;
+        }
+        return _idx;
+    };
+
+    for(size_type i = 0; i < _dst.size(); ++i)
+    {
+        auto _key = result_key(_dst[i]);
+        auto _idx = _find(_dst[i], _key);
+        _keys.push_back(_key);
+        if(_slots[_idx] == npos)
+            _slots[_idx] = i;
+    }
+
+    for(const auto& itr : _src)
+    {
+        auto _key = result_key(itr);
+        auto _idx = _find(itr, _key);
+        if(_slots[_idx] == npos)
+        {
+            _slots[_idx] = _dst.size();
+            _keys.push_back(_key);
+            _dst.push_back(itr);
+        }
+        _index.push_back(_slots[_idx]);
+    }
+    return _index;
+}
+
 //======================================================================================//
 
 }  // namespace impl
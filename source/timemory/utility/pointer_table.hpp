@@ -0,0 +1,323 @@
+//  MIT License
+//
+//  Copyright (c) 2020, The Regents of the University of California,
+//  through Lawrence Berkeley National Laboratory (subject to receipt of any
+//  required approvals from the U.S. Dept. of Energy).  All rights reserved.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to
+//  deal in the Software without restriction, including without limitation the
+//  rights to use, copy, modify, merge, publish, distribute, sublicense, and
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+//  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+//  IN THE SOFTWARE.
+
+/** \file utility/pointer_table.hpp
+ * \headerfile utility/pointer_table.hpp "timemory/utility/pointer_table.hpp"
+ * Sharded, open-addressing table mapping an address to a value. The table is
+ * intended for bookkeeping inside of allocation wrappers: the slots are obtained
+ * directly from the operating system (mmap) so that using the table never calls
+ * the (possibly wrapped) malloc, and each shard is guarded by its own spin-lock so
+ * that threads allocating different pointers rarely contend.
+ */
+
+#pragma once
+
+#include "timemory/utility/macros.hpp"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <thread>
+
+#if defined(_UNIX)
+#    include <sys/mman.h>
+#endif
+
+namespace tim
+{
+//--------------------------------------------------------------------------------------//
+//
+//  _Tp must be trivially copyable. _ShardBits is the log2 of the number of shards
+//
+template <typename _Tp, size_t _ShardBits = 6>
+class pointer_table
+{
+public:
+    using this_type  = pointer_table<_Tp, _ShardBits>;
+    using value_type = _Tp;
+    using size_type  = size_t;
+
+    static constexpr size_type num_shards       = (1 << _ShardBits);
+    static constexpr size_type initial_capacity = 1024;
+
+public:
+    pointer_table() = default;
+    ~pointer_table()
+    {
+        for(auto& itr : m_shards)
+            release(itr.slots, itr.capacity);
+    }
+
+    pointer_table(const this_type&) = delete;
+    pointer_table(this_type&&)      = delete;
+    this_type& operator=(const this_type&) = delete;
+    this_type& operator=(this_type&&) = delete;
+
+public:
+    //----------------------------------------------------------------------------------//
+    /// insert or overwrite the value for the address. Returns false if the storage
+    /// for the slots could not be obtained
+    bool insert(const void* _ptr, const value_type& _value)
+    {
+        if(!_ptr)
+            return false;
+        auto  _hash  = hash(_ptr);
+        auto& _shard = m_shards[_hash >> (64 - _ShardBits)];
+        auto  _key   = reinterpret_cast<uintptr_t>(_ptr);
+
+        scoped_lock _lk(_shard.lock);
+        if(4 * (_shard.size + _shard.tombstones + 1) > 3 * _shard.capacity &&
+           !rehash(_shard))
+            return false;
+
+        auto    _mask = _shard.capacity - 1;
+        slot_t* _tomb = nullptr;
+        for(size_type i = fold(_hash) & _mask;; i = (i + 1) & _mask)
+        {
+            auto& _slot = _shard.slots[i];
+            if(_slot.key == _key)
+            {
+                _slot.value = _value;
+                return true;
+            }
+            if(_slot.key == tombstone_key)
+            {
+                if(!_tomb)
+                    _tomb = &_slot;
+            }
+            else if(_slot.key == empty_key)
+            {
+                if(_tomb)
+                {
+                    --_shard.tombstones;
+                    _tomb->key   = _key;
+                    _tomb->value = _value;
+                }
+                else
+                {
+                    _slot.key   = _key;
+                    _slot.value = _value;
+                }
+                ++_shard.size;
+                return true;
+            }
+        }
+    }
+
+    //----------------------------------------------------------------------------------//
+    /// remove the address from the table and assign its value to _value. Returns
+    /// false if the address was not in the table
+    bool erase(const void* _ptr, value_type& _value)
+    {
+        if(!_ptr)
+            return false;
+        auto  _hash  = hash(_ptr);
+        auto& _shard = m_shards[_hash >> (64 - _ShardBits)];
+        auto  _key   = reinterpret_cast<uintptr_t>(_ptr);
+
+        scoped_lock _lk(_shard.lock);
+        if(_shard.size == 0)
+            return false;
+
+        auto _mask = _shard.capacity - 1;
+        for(size_type i = fold(_hash) & _mask;; i = (i + 1) & _mask)
+        {
+            auto& _slot = _shard.slots[i];
+            if(_slot.key == _key)
+            {
+                _value    = _slot.value;
+                _slot.key = tombstone_key;
+                --_shard.size;
+                ++_shard.tombstones;
+                return true;
+            }
+            if(_slot.key == empty_key)
+                return false;
+        }
+    }
+
+    //----------------------------------------------------------------------------------//
+    /// the number of addresses in the table
+    size_type size() const
+    {
+        size_type _n = 0;
+        for(auto& itr : m_shards)
+        {
+            scoped_lock _lk(itr.lock);
+            _n += itr.size;
+        }
+        return _n;
+    }
+
+    bool empty() const { return size() == 0; }
+
+    //----------------------------------------------------------------------------------//
+    /// invoke _func(const void*, const value_type&) on every entry. The shard being
+    /// visited is locked so _func must not access the table
+    template <typename _Func>
+    void for_each(_Func&& _func) const
+    {
+        for(auto& itr : m_shards)
+        {
+            scoped_lock _lk(itr.lock);
+            for(size_type i = 0; i < itr.capacity; ++i)
+            {
+                auto& _slot = itr.slots[i];
+                if(_slot.key != empty_key && _slot.key != tombstone_key)
+                    _func(reinterpret_cast<const void*>(_slot.key), _slot.value);
+            }
+        }
+    }
+
+    //----------------------------------------------------------------------------------//
+    /// remove all the entries, the storage for the slots is retained
+    void clear()
+    {
+        for(auto& itr : m_shards)
+        {
+            scoped_lock _lk(itr.lock);
+            for(size_type i = 0; i < itr.capacity; ++i)
+                itr.slots[i].key = empty_key;
+            itr.size       = 0;
+            itr.tombstones = 0;
+        }
+    }
+
+private:
+    static constexpr uintptr_t empty_key     = 0;
+    static constexpr uintptr_t tombstone_key = 1;
+
+    struct slot_t
+    {
+        uintptr_t  key;
+        value_type value;
+    };
+
+    struct shard_t
+    {
+        mutable std::atomic_flag lock       = ATOMIC_FLAG_INIT;
+        slot_t*                  slots      = nullptr;
+        size_type                capacity   = 0;
+        size_type                size       = 0;
+        size_type                tombstones = 0;
+    };
+
+    struct scoped_lock
+    {
+        explicit scoped_lock(std::atomic_flag& _lock)
+        : m_lock(_lock)
+        {
+            // yield after a short spin so a pre-empted holder can make progress
+            for(int i = 0; m_lock.test_and_set(std::memory_order_acquire); ++i)
+            {
+                if(i >= 64)
+                    std::this_thread::yield();
+            }
+        }
+        ~scoped_lock() { m_lock.clear(std::memory_order_release); }
+
+        scoped_lock(const scoped_lock&) = delete;
+        scoped_lock& operator=(const scoped_lock&) = delete;
+
+    private:
+        std::atomic_flag& m_lock;
+    };
+
+    //  fibonacci hashing of the address, the low bits are dropped because they are
+    //  always zero for aligned allocations. The high bits select the shard and the
+    //  low bits select the slot
+    static uint64_t hash(const void* _ptr)
+    {
+        return (static_cast<uint64_t>(reinterpret_cast<uintptr_t>(_ptr)) >> 4) *
+               static_cast<uint64_t>(0x9E3779B97F4A7C15ULL);
+    }
+
+    //  the low bits of the product only depend on the low bits of the address so the
+    //  well-mixed high bits are folded in before selecting the slot
+    static uint64_t fold(uint64_t _hash) { return _hash ^ (_hash >> 29); }
+
+    static slot_t* acquire(size_type _n)
+    {
+#if defined(_UNIX)
+        void* _addr = ::mmap(nullptr, _n * sizeof(slot_t), PROT_READ | PROT_WRITE,
+                             MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        // anonymous mappings are zero-filled, i.e. every key is empty_key
+        return (_addr == MAP_FAILED) ? nullptr : static_cast<slot_t*>(_addr);
+#else
+        return static_cast<slot_t*>(std::calloc(_n, sizeof(slot_t)));
+#endif
+    }
+
+    static void release(slot_t* _slots, size_type _n)
+    {
+        if(!_slots)
+            return;
+#if defined(_UNIX)
+        ::munmap(_slots, _n * sizeof(slot_t));
+#else
+        consume_parameters(_n);
+        std::free(_slots);
+#endif
+    }
+
+    //  grow the shard when it is mostly live entries, otherwise rebuild it at the same
+    //  capacity to flush the tombstones
+    static bool rehash(shard_t& _shard)
+    {
+        auto _capacity = (_shard.capacity == 0) ? initial_capacity : _shard.capacity;
+        if(2 * _shard.size >= _capacity)
+            _capacity *= 2;
+
+        auto _slots = acquire(_capacity);
+        if(!_slots)
+            return false;
+
+        auto _mask = _capacity - 1;
+        for(size_type i = 0; i < _shard.capacity; ++i)
+        {
+            auto& _slot = _shard.slots[i];
+            if(_slot.key == empty_key || _slot.key == tombstone_key)
+                continue;
+            auto _hash = hash(reinterpret_cast<const void*>(_slot.key));
+            auto j     = fold(_hash) & _mask;
+            while(_slots[j].key != empty_key)
+                j = (j + 1) & _mask;
+            _slots[j] = _slot;
+        }
+
+        release(_shard.slots, _shard.capacity);
+        _shard.slots      = _slots;
+        _shard.capacity   = _capacity;
+        _shard.tombstones = 0;
+        return true;
+    }
+
+private:
+    shard_t m_shards[num_shards];
+};
+
+//--------------------------------------------------------------------------------------//
+
+}  // namespace tim
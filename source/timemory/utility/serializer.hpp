@@ -56,6 +56,7 @@
 
 // archives
 #include <cereal/archives/json.hpp>
+#include <cereal/archives/portable_binary.hpp>
 #if defined(TIMEMORY_INCLUDE_XML_ARCHIVE)
 #    include <cereal/archives/xml.hpp>
 #endif
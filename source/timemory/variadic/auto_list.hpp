@@ -90,9 +90,9 @@ public:
     static init_func_t& get_initializer()
     {
         static init_func_t _instance = [](this_type& al) {
-            static auto env_ret  = tim::get_env<string_t>("TIMEMORY_AUTO_LIST_INIT", "");
-            static auto env_enum = enumerate_components(tim::delimit(env_ret));
-            ::tim::initialize(al, env_enum);
+            static auto env_ret = tim::get_env<string_t>("TIMEMORY_AUTO_LIST_INIT", "");
+            static auto env_set = component_set<this_type>(env_ret);
+            env_set(al);
         };
         return _instance;
     }
@@ -110,11 +110,29 @@ public:
                        bool report_at_exit = false);
     ~auto_list();
 
-    // copy and move
+    // copy and move, the moved-from object does not stop the components
     inline auto_list(const this_type&) = default;
-    inline auto_list(this_type&&)      = default;
+    inline auto_list(this_type&& rhs)
+    : m_enabled(rhs.m_enabled)
+    , m_report_at_exit(rhs.m_report_at_exit)
+    , m_temporary_object(std::move(rhs.m_temporary_object))
+    , m_reference_object(rhs.m_reference_object)
+    {
+        rhs.m_enabled = false;
+    }
     inline this_type& operator=(const this_type&) = default;
-    inline this_type& operator=(this_type&&) = default;
+    inline this_type& operator=(this_type&& rhs)
+    {
+        if(this != &rhs)
+        {
+            m_enabled          = rhs.m_enabled;
+            m_report_at_exit   = rhs.m_report_at_exit;
+            m_temporary_object = std::move(rhs.m_temporary_object);
+            m_reference_object = rhs.m_reference_object;
+            rhs.m_enabled      = false;
+        }
+        return *this;
+    }
 
     static constexpr std::size_t size() { return component_type::size(); }
 
@@ -108,11 +108,29 @@ public:
                         bool report_at_exit = false);
     inline ~auto_tuple();
 
-    // copy and move
+    // copy and move, the moved-from object does not stop the components
     inline auto_tuple(const this_type&) = default;
-    inline auto_tuple(this_type&&)      = default;
+    inline auto_tuple(this_type&& rhs)
+    : m_enabled(rhs.m_enabled)
+    , m_report_at_exit(rhs.m_report_at_exit)
+    , m_temporary_object(std::move(rhs.m_temporary_object))
+    , m_reference_object(rhs.m_reference_object)
+    {
+        rhs.m_enabled = false;
+    }
     inline this_type& operator=(const this_type&) = default;
-    inline this_type& operator=(this_type&&) = default;
+    inline this_type& operator=(this_type&& rhs)
+    {
+        if(this != &rhs)
+        {
+            m_enabled          = rhs.m_enabled;
+            m_report_at_exit   = rhs.m_report_at_exit;
+            m_temporary_object = std::move(rhs.m_temporary_object);
+            m_reference_object = rhs.m_reference_object;
+            rhs.m_enabled      = false;
+        }
+        return *this;
+    }
 
     static constexpr std::size_t size() { return component_type::size(); }
 
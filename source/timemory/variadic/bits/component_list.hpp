@@ -101,7 +101,7 @@ template <typename... Types>
 component_list<Types...>::~component_list()
 {
     pop();
-    apply_v::access<deleter_t>(m_data);
+    destroy();
 }
 
 //--------------------------------------------------------------------------------------//
@@ -115,7 +115,47 @@ component_list<Types...>::component_list(const this_type& rhs)
 , m_hash(rhs.m_hash)
 {
     apply_v::set_value(m_data, nullptr);
-    apply_v::access2<copy_t>(m_data, rhs.m_data);
+    copy_from(rhs.m_data);
+}
+
+//--------------------------------------------------------------------------------------//
+//  the components are owned by the storage of rhs so the pointers are transferred
+//  along with it
+//
+template <typename... Types>
+component_list<Types...>::component_list(this_type&& rhs)
+: m_store(rhs.m_store)
+, m_flat(rhs.m_flat)
+, m_is_pushed(rhs.m_is_pushed)
+, m_laps(rhs.m_laps)
+, m_hash(rhs.m_hash)
+, m_data(rhs.m_data)
+, m_arena(std::move(rhs.m_arena))
+{
+    apply_v::set_value(rhs.m_data, nullptr);
+    rhs.m_is_pushed = false;
+}
+
+//--------------------------------------------------------------------------------------//
+//
+template <typename... Types>
+component_list<Types...>&
+component_list<Types...>::operator=(this_type&& rhs)
+{
+    if(this != &rhs)
+    {
+        destroy();
+        m_store     = rhs.m_store;
+        m_flat      = rhs.m_flat;
+        m_is_pushed = rhs.m_is_pushed;
+        m_laps      = rhs.m_laps;
+        m_hash      = rhs.m_hash;
+        m_data      = rhs.m_data;
+        m_arena     = std::move(rhs.m_arena);
+        apply_v::set_value(rhs.m_data, nullptr);
+        rhs.m_is_pushed = false;
+    }
+    return *this;
 }
 
 //--------------------------------------------------------------------------------------//
@@ -131,8 +171,8 @@ component_list<Types...>::operator=(const this_type& rhs)
         m_is_pushed = rhs.m_is_pushed;
         m_laps      = rhs.m_laps;
         m_hash      = rhs.m_hash;
-        apply_v::access<deleter_t>(m_data);
-        apply_v::access2<copy_t>(m_data, rhs.m_data);
+        destroy();
+        copy_from(rhs.m_data);
     }
     return *this;
 }
@@ -210,6 +250,8 @@ component_list<Types...>::start()
     using standard_start_t = operation_t<operation::standard_start>;
     using delayed_start_t  = operation_t<operation::delayed_start>;
     push();
+    rusage_snapshot_t _snapshot;
+    clock_snapshot_t  _clocks;
     ++m_laps;
     // start components
     apply_v::access<priority_start_t>(m_data);
@@ -227,9 +269,13 @@ component_list<Types...>::stop()
     using standard_stop_t = operation_t<operation::standard_stop>;
     using delayed_stop_t  = operation_t<operation::delayed_stop>;
     // stop components
-    apply_v::access<priority_stop_t>(m_data);
-    apply_v::access<standard_stop_t>(m_data);
-    apply_v::access<delayed_stop_t>(m_data);
+    {
+        rusage_snapshot_t _snapshot;
+        clock_snapshot_t  _clocks;
+        apply_v::access<priority_stop_t>(m_data);
+        apply_v::access<standard_stop_t>(m_data);
+        apply_v::access<delayed_stop_t>(m_data);
+    }
     // pop them off the running stack
     pop();
 }
@@ -377,7 +423,8 @@ template <typename... Types>
 inline std::string
 component_list<Types...>::key() const
 {
-    return get_hash_ids()->find(m_hash)->second;
+    auto _entry = get_hash_ids()->find(m_hash);
+    return (_entry) ? _entry->value : std::string("");
 }
 
 //--------------------------------------------------------------------------------------//
@@ -513,9 +560,9 @@ inline typename component_list<Types...>::init_func_t&
 component_list<Types...>::get_initializer()
 {
     static init_func_t _instance = [](this_type& cl) {
-        static auto env_ret  = tim::get_env<string_t>("TIMEMORY_COMPONENT_LIST_INIT", "");
-        static auto env_enum = enumerate_components(tim::delimit(env_ret));
-        ::tim::initialize(cl, env_enum);
+        static auto env_ret = tim::get_env<string_t>("TIMEMORY_COMPONENT_LIST_INIT", "");
+        static auto env_set = component_set<this_type>(env_ret);
+        env_set(cl);
         // env::initialize(cl, "TIMEMORY_COMPONENT_LIST_INIT", "");
     };
     return _instance;
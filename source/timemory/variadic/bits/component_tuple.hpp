@@ -88,6 +88,40 @@ inline component_tuple<Types...>::component_tuple(const captured_location_t& loc
     set_object_prefix(loc.get_id());
 }
 
+//--------------------------------------------------------------------------------------//
+// the moved-from object is no longer pushed so it does not pop the node again
+//
+template <typename... Types>
+inline component_tuple<Types...>::component_tuple(this_type&& rhs)
+: m_store(rhs.m_store)
+, m_flat(rhs.m_flat)
+, m_is_pushed(rhs.m_is_pushed)
+, m_laps(rhs.m_laps)
+, m_hash(rhs.m_hash)
+, m_data(std::move(rhs.m_data))
+{
+    rhs.m_is_pushed = false;
+}
+
+//--------------------------------------------------------------------------------------//
+//
+template <typename... Types>
+inline component_tuple<Types...>&
+component_tuple<Types...>::operator=(this_type&& rhs)
+{
+    if(this != &rhs)
+    {
+        m_store         = rhs.m_store;
+        m_flat          = rhs.m_flat;
+        m_is_pushed     = rhs.m_is_pushed;
+        m_laps          = rhs.m_laps;
+        m_hash          = rhs.m_hash;
+        m_data          = std::move(rhs.m_data);
+        rhs.m_is_pushed = false;
+    }
+    return *this;
+}
+
 //--------------------------------------------------------------------------------------//
 //
 template <typename... Types>
@@ -166,6 +200,8 @@ component_tuple<Types...>::start()
     using standard_start_t = operation_t<operation::standard_start>;
     using delayed_start_t  = operation_t<operation::delayed_start>;
     push();
+    rusage_snapshot_t _snapshot;
+    clock_snapshot_t  _clocks;
     // increment laps
     ++m_laps;
     // start components
@@ -184,9 +220,13 @@ component_tuple<Types...>::stop()
     using standard_stop_t = operation_t<operation::standard_stop>;
     using delayed_stop_t  = operation_t<operation::delayed_stop>;
     // stop components
-    apply_v::access<priority_stop_t>(m_data);
-    apply_v::access<standard_stop_t>(m_data);
-    apply_v::access<delayed_stop_t>(m_data);
+    {
+        rusage_snapshot_t _snapshot;
+        clock_snapshot_t  _clocks;
+        apply_v::access<priority_stop_t>(m_data);
+        apply_v::access<standard_stop_t>(m_data);
+        apply_v::access<delayed_stop_t>(m_data);
+    }
     // pop them off the running stack
     pop();
 }
@@ -327,7 +367,8 @@ template <typename... Types>
 inline std::string
 component_tuple<Types...>::key() const
 {
-    return get_hash_ids()->find(m_hash)->second;
+    auto _entry = get_hash_ids()->find(m_hash);
+    return (_entry) ? _entry->value : std::string("");
 }
 
 //--------------------------------------------------------------------------------------//
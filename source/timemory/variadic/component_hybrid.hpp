@@ -108,6 +108,15 @@ public:
     static constexpr bool contains_gotcha =
         (tuple_type::contains_gotcha || list_type::contains_gotcha);
 
+    // the tuple and the list share one getrusage and /proc read per start/stop
+    static constexpr bool contains_rusage =
+        (tuple_type::contains_rusage || list_type::contains_rusage);
+    using rusage_snapshot_t = conditional_rusage_snapshot<contains_rusage>;
+
+    // the tuple and the list share one read of each clock per start/stop
+    static constexpr size_t num_clocks = tuple_type::num_clocks + list_type::num_clocks;
+    using clock_snapshot_t             = conditional_clock_snapshot<(num_clocks > 1)>;
+
     using size_type           = int64_t;
     using captured_location_t = source_location::captured;
     using init_func_t         = std::function<void(this_type&)>;
@@ -237,12 +246,16 @@ public:
     // start/stop functions
     void start()
     {
+        rusage_snapshot_t _snapshot;
+        clock_snapshot_t  _clocks;
         m_tuple.start();
         m_list.start();
     }
 
     void stop()
     {
+        rusage_snapshot_t _snapshot;
+        clock_snapshot_t  _clocks;
         m_tuple.stop();
         m_list.stop();
     }
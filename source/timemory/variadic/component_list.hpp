@@ -39,6 +39,8 @@
 #include <iomanip>
 #include <ios>
 #include <iostream>
+#include <memory>
+#include <new>
 #include <stdio.h>
 #include <string>
 
@@ -88,6 +90,8 @@ public:
         using data_type      = std::tuple<_Types*...>;
         using type_tuple     = std::tuple<_Types...>;
         using reference_type = std::tuple<_Types...>;
+        using arena_type     = std::tuple<
+            typename std::aligned_storage<sizeof(_Types), alignof(_Types)>::type...>;
 
         template <typename _Archive>
         using serialize_t = _TypeL<operation::pointer_operator<
@@ -155,6 +159,17 @@ public:
     static constexpr bool contains_gotcha =
         (std::tuple_size<filter_gotchas<Types...>>::value != 0);
 
+    // the rusage-derived components share one getrusage and /proc read per start/stop
+    static constexpr bool contains_rusage =
+        (std::tuple_size<filter_rusage_snapshot<Types...>>::value != 0);
+    using rusage_snapshot_t = conditional_rusage_snapshot<contains_rusage>;
+
+    // the clock-derived components share one read of each clock per start/stop, which
+    // is only worthwhile when there is more than one of them
+    static constexpr size_t num_clocks =
+        std::tuple_size<filter_clock_snapshot<Types...>>::value;
+    using clock_snapshot_t = conditional_clock_snapshot<(num_clocks > 1)>;
+
 public:
     // modifier types
     // clang-format off
@@ -190,8 +205,8 @@ public:
     //------------------------------------------------------------------------//
     //      Copy construct and assignment
     //------------------------------------------------------------------------//
-    component_list(component_list&&) = default;
-    component_list& operator=(component_list&&) = default;
+    component_list(component_list&&);
+    component_list& operator=(component_list&&);
 
     component_list(const component_list& rhs);
     component_list& operator=(const component_list& rhs);
@@ -363,7 +378,7 @@ public:
         {
             if(PrintPrefix)
             {
-                auto _key = get_hash_ids()->find(m_hash)->second;
+                auto _key = get_hash_ids()->find(m_hash)->value;
                 update_width();
                 std::stringstream ss_id;
                 ss_id << get_prefix() << " " << std::left << _key;
@@ -391,13 +406,13 @@ public:
     {
         std::string _key   = "";
         auto        keyitr = get_hash_ids()->find(m_hash);
-        if(keyitr != get_hash_ids()->end())
-            _key = keyitr->second;
+        if(keyitr)
+            _key = keyitr->value;
 
         ar(cereal::make_nvp("hash", m_hash), cereal::make_nvp("key", _key),
            cereal::make_nvp("laps", m_laps));
 
-        if(keyitr == get_hash_ids()->end())
+        if(!keyitr)
         {
             auto _hash = add_hash_id(_key);
             if(_hash != m_hash)
@@ -449,7 +464,8 @@ public:
                 printf("[component_list::init]> initializing type '%s'...\n",
                        _id.c_str());
             }
-            _obj = new _Tp(std::forward<_Args>(_args)...);
+            _obj = new(get_arena_slot<index_of<_Tp*, data_type>::value>())
+                _Tp(std::forward<_Args>(_args)...);
             set_object_prefix(_obj);
         }
         else
@@ -551,18 +567,71 @@ protected:
     void set_object_prefix(_Tp* obj) const
     {
         using _PrefixOp = operation::pointer_operator<_Tp, operation::set_prefix<_Tp>>;
-        auto _key       = get_hash_ids()->find(m_hash)->second;
+        auto _key       = get_hash_ids()->find(m_hash)->value;
         _PrefixOp(obj, _key);
     }
 
+protected:
+    //----------------------------------------------------------------------------------//
+    //  the components are constructed in one block of storage with a slot for each
+    //  available type, which is allocated when the first component is initialized,
+    //  instead of one heap allocation per component
+    //
+    using arena_type = typename filtered<impl_unique_concat_type>::arena_type;
+
+    static constexpr std::size_t num_slots = std::tuple_size<data_type>::value;
+
+    template <std::size_t _Idx>
+    void* get_arena_slot()
+    {
+        if(!m_arena)
+            m_arena.reset(new arena_type);
+        return static_cast<void*>(&std::get<_Idx>(*m_arena));
+    }
+
+    template <std::size_t _Idx = 0, enable_if_t<(_Idx == num_slots), int> = 0>
+    void destroy()
+    {}
+
+    template <std::size_t _Idx = 0, enable_if_t<(_Idx < num_slots), int> = 0>
+    void destroy()
+    {
+        using _Tp  = decay_t<decltype(*std::get<_Idx>(m_data))>;
+        auto& _obj = std::get<_Idx>(m_data);
+        if(_obj)
+        {
+            if(m_arena && static_cast<void*>(_obj) == &std::get<_Idx>(*m_arena))
+                _obj->~_Tp();
+            else
+                delete _obj;
+            _obj = nullptr;
+        }
+        destroy<_Idx + 1>();
+    }
+
+    template <std::size_t _Idx = 0, enable_if_t<(_Idx == num_slots), int> = 0>
+    void copy_from(const data_type&)
+    {}
+
+    template <std::size_t _Idx = 0, enable_if_t<(_Idx < num_slots), int> = 0>
+    void copy_from(const data_type& rhs)
+    {
+        using _Tp  = decay_t<decltype(*std::get<_Idx>(m_data))>;
+        auto* _rhs = std::get<_Idx>(rhs);
+        if(_rhs)
+            std::get<_Idx>(m_data) = new(get_arena_slot<_Idx>()) _Tp(*_rhs);
+        copy_from<_Idx + 1>(rhs);
+    }
+
 protected:
     // objects
-    bool              m_store     = false;
-    bool              m_flat      = false;
-    bool              m_is_pushed = false;
-    int32_t           m_laps      = 0;
-    uint64_t          m_hash      = 0;
-    mutable data_type m_data      = data_type();
+    bool                        m_store     = false;
+    bool                        m_flat      = false;
+    bool                        m_is_pushed = false;
+    int32_t                     m_laps      = 0;
+    uint64_t                    m_hash      = 0;
+    mutable data_type           m_data      = data_type();
+    std::unique_ptr<arena_type> m_arena     = std::unique_ptr<arena_type>();
 };
 
 //--------------------------------------------------------------------------------------//
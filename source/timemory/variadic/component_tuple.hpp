@@ -152,6 +152,17 @@ public:
     static constexpr bool contains_gotcha =
         (std::tuple_size<filter_gotchas<Types...>>::value != 0);
 
+    // the rusage-derived components share one getrusage and /proc read per start/stop
+    static constexpr bool contains_rusage =
+        (std::tuple_size<filter_rusage_snapshot<Types...>>::value != 0);
+    using rusage_snapshot_t = conditional_rusage_snapshot<contains_rusage>;
+
+    // the clock-derived components share one read of each clock per start/stop, which
+    // is only worthwhile when there is more than one of them
+    static constexpr size_t num_clocks =
+        std::tuple_size<filter_clock_snapshot<Types...>>::value;
+    using clock_snapshot_t = conditional_clock_snapshot<(num_clocks > 1)>;
+
     //----------------------------------------------------------------------------------//
     //
     static init_func_t& get_initializer()
@@ -202,10 +213,10 @@ public:
     //      Copy construct and assignment
     //------------------------------------------------------------------------//
     component_tuple(const component_tuple&) = default;
-    component_tuple(component_tuple&&)      = default;
+    component_tuple(component_tuple&&);
 
     component_tuple& operator=(const component_tuple& rhs) = default;
-    component_tuple& operator=(component_tuple&&) = default;
+    component_tuple& operator=(component_tuple&&);
 
     component_tuple clone(bool store, bool flat = settings::flat_profile());
 
@@ -391,7 +402,7 @@ public:
         apply_v::access_with_indices<print_t>(m_data, std::ref(ss_data), false);
         if(PrintPrefix)
         {
-            auto _key = get_hash_ids()->find(m_hash)->second;
+            auto _key = get_hash_ids()->find(m_hash)->value;
             update_width();
             std::stringstream ss_id;
             ss_id << get_prefix() << " " << std::left << _key;
@@ -418,13 +429,13 @@ public:
     {
         std::string _key   = "";
         auto        keyitr = get_hash_ids()->find(m_hash);
-        if(keyitr != get_hash_ids()->end())
-            _key = keyitr->second;
+        if(keyitr)
+            _key = keyitr->value;
 
         ar(cereal::make_nvp("hash", m_hash), cereal::make_nvp("key", _key),
            cereal::make_nvp("laps", m_laps));
 
-        if(keyitr == get_hash_ids()->end())
+        if(!keyitr)
         {
             auto _hash = add_hash_id(_key);
             if(_hash != m_hash)
@@ -24,6 +24,8 @@
 
 #include "timemory/timemory.hpp"
 
+#include "timem.hpp"
+
 // C includes
 #include <errno.h>
 #include <stdio.h>
@@ -167,6 +169,51 @@ debug()
     return _instance;
 }
 
+//--------------------------------------------------------------------------------------//
+//  sample the memory, cpu time, and I/O of the child and its descendants at a fixed
+//  interval (in milliseconds) in addition to measuring the totals. Only supported on
+//  Linux
+//
+bool
+sample()
+{
+    static bool _instance = tim::get_env("TIMEM_SAMPLE", false);
+    return _instance;
+}
+
+//--------------------------------------------------------------------------------------//
+
+double
+sample_interval()
+{
+    static double _instance = tim::get_env("TIMEM_SAMPLE_INTERVAL", 100.0);
+    return _instance;
+}
+
+//--------------------------------------------------------------------------------------//
+//  the number of samples which are kept, the oldest samples are overwritten when a
+//  run exceeds this number
+//
+size_t
+sample_buffer_size()
+{
+    static size_t _instance = tim::get_env<size_t>("TIMEM_SAMPLE_BUFFER_SIZE", 65536);
+    return _instance;
+}
+
+//--------------------------------------------------------------------------------------//
+
+#if defined(_LINUX)
+
+timem::sampler*&
+get_sampler()
+{
+    static timem::sampler* _instance = nullptr;
+    return _instance;
+}
+
+#endif
+
 //--------------------------------------------------------------------------------------//
 
 std::string&
@@ -211,6 +258,28 @@ parent_process(pid_t pid)
     int status;
     int ret = 0;
 
+#if defined(_LINUX)
+    if(sample())
+    {
+        auto _interval = std::chrono::duration<double, std::milli>(sample_interval());
+        get_sampler()  = new timem::sampler(
+            pid, std::chrono::duration_cast<timem::sampler::duration_type>(_interval),
+            sample_buffer_size());
+        get_sampler()->start();
+
+        // wait for the child to exit without reaping it so that the final sample
+        // includes the usage of the child
+        siginfo_t _info;
+        while(waitid(P_PID, pid, &_info, WEXITED | WNOWAIT) < 0 && errno == EINTR)
+        {
+        }
+        get_sampler()->stop();
+    }
+#else
+    if(sample())
+        fprintf(stderr, "[timem]> Warning! sampling is only supported on Linux\n");
+#endif
+
     if(waitpid(pid, &status, 0) > 0)
     {
         get_measure()->stop();
@@ -244,6 +313,14 @@ parent_process(pid_t pid)
 
     std::stringstream _oss;
     _oss << "\n" << *get_measure() << std::flush;
+#if defined(_LINUX)
+    if(get_sampler())
+    {
+        _oss << "\n[" << command() << "] sampled every " << sample_interval()
+             << " msec:\n";
+        get_sampler()->write_summary(_oss);
+    }
+#endif
 
     if(tim::settings::file_output())
     {
@@ -277,6 +354,40 @@ parent_process(pid_t pid)
         std::cout << _oss.str() << std::endl;
     }
 
+#if defined(_LINUX)
+    // the time-series is always written to a file in sampling mode
+    if(get_sampler())
+    {
+        std::string label = "timem-samples";
+        if(tim::settings::text_output() || !tim::settings::json_output())
+        {
+            auto          fname = tim::settings::compose_output_filename(label, ".txt");
+            std::ofstream ofs(fname.c_str());
+            if(ofs)
+            {
+                printf("[timem]> Outputting '%s'...\n", fname.c_str());
+                get_sampler()->write_text(ofs);
+                ofs.close();
+            }
+            else
+            {
+                std::cout << "[timem]>  opening output file '" << fname << "'...\n";
+                get_sampler()->write_text(std::cout);
+            }
+        }
+
+        if(tim::settings::json_output())
+        {
+            auto jname = tim::settings::compose_output_filename(label, ".json");
+            printf("[timem]> Outputting '%s'...\n", jname.c_str());
+            tim::generic_serialization(jname, *get_sampler());
+        }
+
+        delete get_sampler();
+        get_sampler() = nullptr;
+    }
+#endif
+
     exit(ret);
 }
 
@@ -0,0 +1,561 @@
+//  MIT License
+//
+//  Copyright (c) 2020, The Regents of the University of California,
+//  through Lawrence Berkeley National Laboratory (subject to receipt of any
+//  required approvals from the U.S. Dept. of Energy).  All rights reserved.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to
+//  deal in the Software without restriction, including without limitation the
+//  rights to use, copy, modify, merge, publish, distribute, sublicense, and
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+//  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+//  IN THE SOFTWARE.
+
+/** \file timemory/tools/timem.hpp
+ * \headerfile tools/timem.hpp "tools/timem.hpp"
+ * Sampling mode of timem: a background thread periodically reads
+ * /proc/<pid>/{stat,statm,io} of the child process and all of its descendants and
+ * records the sums into a fixed-size ring buffer. The sampler is only available on
+ * Linux
+ *
+ */
+
+#pragma once
+
+#include "timemory/backends/rusage.hpp"
+#include "timemory/utility/macros.hpp"
+#include "timemory/utility/serializer.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <iomanip>
+#include <mutex>
+#include <ostream>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#if defined(_LINUX)
+#    include <dirent.h>
+#    include <fcntl.h>
+#    include <unistd.h>
+#endif
+
+namespace timem
+{
+//--------------------------------------------------------------------------------------//
+//
+//  the usage of the process tree at one point in time
+//
+struct sample
+{
+    double  time        = 0.0;  ///< seconds since the sampler was started
+    int64_t rss         = 0;    ///< resident set size (bytes)
+    int64_t virt        = 0;    ///< virtual memory size (bytes)
+    int64_t cpu         = 0;    ///< user + system time, incl. reaped children (nsec)
+    int64_t read_bytes  = 0;    ///< bytes read from storage
+    int64_t write_bytes = 0;    ///< bytes written to storage
+    int64_t nproc       = 0;    ///< number of processes in the tree
+
+    template <typename Archive>
+    void serialize(Archive& ar, const unsigned int)
+    {
+        ar(cereal::make_nvp("time", time), cereal::make_nvp("rss", rss),
+           cereal::make_nvp("virt", virt), cereal::make_nvp("cpu", cpu),
+           cereal::make_nvp("read_bytes", read_bytes),
+           cereal::make_nvp("write_bytes", write_bytes),
+           cereal::make_nvp("nproc", nproc));
+    }
+};
+
+//--------------------------------------------------------------------------------------//
+//
+//  peak and mean values over every sample, including the samples which have been
+//  overwritten in the ring buffer
+//
+struct summary
+{
+    uint64_t count      = 0;
+    int64_t  peak_rss   = 0;
+    double   mean_rss   = 0.0;
+    double   peak_util  = 0.0;  ///< cpu utilization between two samples (%)
+    double   mean_util  = 0.0;  ///< cpu time over the sampled wall time (%)
+    int64_t  peak_nproc = 0;
+
+    template <typename Archive>
+    void serialize(Archive& ar, const unsigned int)
+    {
+        ar(cereal::make_nvp("count", count), cereal::make_nvp("peak_rss", peak_rss),
+           cereal::make_nvp("mean_rss", mean_rss),
+           cereal::make_nvp("peak_cpu_util", peak_util),
+           cereal::make_nvp("mean_cpu_util", mean_util),
+           cereal::make_nvp("peak_nproc", peak_nproc));
+    }
+};
+
+//--------------------------------------------------------------------------------------//
+//
+//  fixed-capacity buffer which overwrites the oldest sample when it is full. The
+//  storage is allocated up-front so recording a sample never allocates
+//
+class ring_buffer
+{
+public:
+    explicit ring_buffer(size_t _capacity)
+    : m_data(std::max<size_t>(_capacity, 1))
+    {}
+
+    void push(const sample& _sample) { m_data[(m_total++) % m_data.size()] = _sample; }
+
+    size_t size() const { return std::min<size_t>(m_total, m_data.size()); }
+    size_t capacity() const { return m_data.size(); }
+    size_t dropped() const { return m_total - size(); }
+    bool   empty() const { return m_total == 0; }
+
+    /// the i-th oldest sample in the buffer
+    const sample& operator[](size_t i) const
+    {
+        return m_data[(m_total - size() + i) % m_data.size()];
+    }
+
+    const sample& back() const { return (*this)[size() - 1]; }
+
+private:
+    std::vector<sample> m_data;
+    size_t              m_total = 0;
+};
+
+#if defined(_LINUX)
+
+//--------------------------------------------------------------------------------------//
+//
+//  periodically samples the process tree rooted at a pid on a background thread.
+//  Only available on Linux because the samples are read from /proc
+//
+class sampler
+{
+public:
+    using clock_type    = std::chrono::steady_clock;
+    using duration_type = std::chrono::nanoseconds;
+
+    /// the maximum number of processes in the tree which are sampled
+    static constexpr size_t max_processes = 4096;
+
+public:
+    sampler(pid_t _pid, duration_type _interval, size_t _capacity)
+    : m_root(_pid)
+    , m_interval(std::max(_interval, duration_type(std::chrono::milliseconds(1))))
+    , m_buffer(_capacity)
+    {
+        m_procs.reserve(64);
+        m_pids.reserve(64);
+    }
+
+    ~sampler()
+    {
+        stop();
+        for(auto& itr : m_procs)
+            itr.close();
+    }
+
+    sampler(const sampler&) = delete;
+    sampler& operator=(const sampler&) = delete;
+
+    //----------------------------------------------------------------------------------//
+    /// launch the sampling thread
+    void start()
+    {
+        if(m_thread.joinable())
+            return;
+        m_running = true;
+        m_start   = clock_type::now();
+        m_thread  = std::thread(&sampler::run, this);
+    }
+
+    //----------------------------------------------------------------------------------//
+    /// take a final sample and join the sampling thread. Calling this before the child
+    /// is reaped (e.g. after waitid with WNOWAIT) includes the final usage of the child
+    void stop()
+    {
+        if(!m_thread.joinable())
+            return;
+        {
+            std::lock_guard<std::mutex> _lk(m_mutex);
+            m_running = false;
+        }
+        m_cv.notify_one();
+        m_thread.join();
+        record();
+    }
+
+    const ring_buffer&   get_buffer() const { return m_buffer; }
+    const summary&       get_summary() const { return m_summary; }
+    const duration_type& get_interval() const { return m_interval; }
+
+    //----------------------------------------------------------------------------------//
+    /// write the samples as whitespace-separated columns
+    void write_text(std::ostream& os) const
+    {
+        os << "# interval: " << std::chrono::duration<double>(m_interval).count()
+           << " sec, samples: " << m_buffer.size() << ", dropped: " << m_buffer.dropped()
+           << "\n";
+        os << "#" << std::setw(11) << "time[sec]" << std::setw(12) << "rss[MB]"
+           << std::setw(12) << "virt[MB]" << std::setw(12) << "cpu[sec]"
+           << std::setw(12) << "cpu_util[%]" << std::setw(12) << "read[MB]"
+           << std::setw(12) << "write[MB]" << std::setw(8) << "nproc"
+           << "\n";
+
+        std::stringstream ss;
+        ss << std::fixed << std::setprecision(3);
+        for(size_t i = 0; i < m_buffer.size(); ++i)
+        {
+            const auto& _s = m_buffer[i];
+            ss << std::setw(12) << _s.time << std::setw(12) << megabytes(_s.rss)
+               << std::setw(12) << megabytes(_s.virt) << std::setw(12)
+               << _s.cpu * 1.0e-9 << std::setw(12)
+               << ((i > 0) ? utilization(m_buffer[i - 1], _s) : 0.0) << std::setw(12)
+               << megabytes(_s.read_bytes) << std::setw(12)
+               << megabytes(_s.write_bytes) << std::setw(8) << _s.nproc << "\n";
+        }
+        os << ss.str();
+    }
+
+    //----------------------------------------------------------------------------------//
+    /// print the peak and mean values
+    void write_summary(std::ostream& os) const
+    {
+        std::stringstream ss;
+        ss << std::fixed << std::setprecision(3);
+        ss << "    " << std::setw(12) << megabytes(m_summary.peak_rss)
+           << " MB peak_rss (sampled)\n"
+           << "    " << std::setw(12) << megabytes(m_summary.mean_rss)
+           << " MB mean_rss (sampled)\n"
+           << "    " << std::setw(12) << m_summary.peak_util << " % peak_cpu_util\n"
+           << "    " << std::setw(12) << m_summary.mean_util << " % mean_cpu_util\n"
+           << "    " << std::setw(12) << m_summary.peak_nproc << " peak_nproc\n"
+           << "    " << std::setw(12) << m_summary.count << " samples\n";
+        os << ss.str();
+    }
+
+    template <typename Archive>
+    void serialize(Archive& ar, const unsigned int)
+    {
+        std::vector<sample> _samples;
+        _samples.reserve(m_buffer.size());
+        for(size_t i = 0; i < m_buffer.size(); ++i)
+            _samples.push_back(m_buffer[i]);
+
+        double _interval = std::chrono::duration<double>(m_interval).count();
+        size_t _dropped  = m_buffer.dropped();
+        ar(cereal::make_nvp("interval", _interval), cereal::make_nvp("dropped", _dropped),
+           cereal::make_nvp("summary", m_summary), cereal::make_nvp("samples", _samples));
+    }
+
+private:
+    //----------------------------------------------------------------------------------//
+    //  the open /proc/<pid> files of a process in the tree. The descriptors are kept
+    //  open between samples and re-read with pread
+    //
+    struct process
+    {
+        pid_t pid   = -1;
+        int   stat  = -1;
+        int   statm = -1;
+        int   io    = -1;
+        bool  alive = false;
+
+        void open(pid_t _pid)
+        {
+            pid   = _pid;
+            stat  = open_file(_pid, "stat");
+            statm = open_file(_pid, "statm");
+            io    = open_file(_pid, "io");
+        }
+
+        void close()
+        {
+            for(auto* itr : { &stat, &statm, &io })
+            {
+                if(*itr >= 0)
+                    ::close(*itr);
+                *itr = -1;
+            }
+        }
+
+        static int open_file(pid_t _pid, const char* _name)
+        {
+            char _path[64];
+            snprintf(_path, sizeof(_path), "/proc/%li/%s", (long) _pid, _name);
+            return ::open(_path, O_RDONLY | O_CLOEXEC);
+        }
+    };
+
+private:
+    //----------------------------------------------------------------------------------//
+    void run()
+    {
+        auto _next = m_start;
+        std::unique_lock<std::mutex> _lk(m_mutex);
+        while(m_running)
+        {
+            record();
+            // fixed schedule so the time spent sampling does not accumulate as drift
+            _next += m_interval;
+            auto _now = clock_type::now();
+            if(_next < _now)
+                _next = _now;
+            m_cv.wait_until(_lk, _next, [&]() { return !m_running; });
+        }
+    }
+
+    //----------------------------------------------------------------------------------//
+    void record()
+    {
+        sample _sample;
+        _sample.time =
+            std::chrono::duration<double>(clock_type::now() - m_start).count();
+
+        find_processes();
+        for(auto& itr : m_procs)
+        {
+            if(itr.alive && !read(itr, _sample))
+                itr.alive = false;
+        }
+
+        // the cpu time of a process which exits before its parent reaps it can
+        // briefly disappear from the tree so the cumulative value never decreases
+        if(!m_buffer.empty())
+            _sample.cpu = std::max(_sample.cpu, m_buffer.back().cpu);
+
+        update_summary(_sample);
+        m_buffer.push(_sample);
+    }
+
+    //----------------------------------------------------------------------------------//
+    //  the pids of the tree from /proc/<pid>/task/<tid>/children, breadth-first.
+    //  Entries of processes which have left the tree are closed and new processes
+    //  are opened, the rest re-use their descriptors
+    //
+    void find_processes()
+    {
+        m_pids.clear();
+        m_pids.push_back(m_root);
+        for(size_t i = 0; i < m_pids.size() && m_pids.size() < max_processes; ++i)
+            find_children(m_pids[i]);
+
+        for(auto& itr : m_procs)
+            itr.alive = false;
+
+        for(const auto& pid : m_pids)
+        {
+            auto itr = std::find_if(m_procs.begin(), m_procs.end(),
+                                    [pid](const process& p) { return p.pid == pid; });
+            if(itr == m_procs.end())
+            {
+                m_procs.push_back(process{});
+                m_procs.back().open(pid);
+                itr = m_procs.end() - 1;
+            }
+            itr->alive = true;
+        }
+
+        auto _dead = std::partition(m_procs.begin(), m_procs.end(),
+                                    [](const process& p) { return p.alive; });
+        for(auto itr = _dead; itr != m_procs.end(); ++itr)
+            itr->close();
+        m_procs.erase(_dead, m_procs.end());
+    }
+
+    void find_children(pid_t _pid)
+    {
+        char _path[512];
+        snprintf(_path, sizeof(_path), "/proc/%li/task", (long) _pid);
+        DIR* _dir = opendir(_path);
+        if(!_dir)
+            return;
+
+        char _buf[4096];
+        while(auto* _entry = readdir(_dir))
+        {
+            if(_entry->d_name[0] < '0' || _entry->d_name[0] > '9')
+                continue;
+            snprintf(_path, sizeof(_path), "/proc/%li/task/%s/children", (long) _pid,
+                     _entry->d_name);
+            auto _fd = ::open(_path, O_RDONLY | O_CLOEXEC);
+            if(_fd < 0)
+                continue;
+            auto _n = ::read(_fd, _buf, sizeof(_buf));
+            ::close(_fd);
+
+            const char* _beg = _buf;
+            int64_t     _val = 0;
+            while(_n > 0 && tim::impl::parse_integer(_beg, _buf + _n, _val))
+            {
+                if(m_pids.size() < max_processes)
+                    m_pids.push_back(static_cast<pid_t>(_val));
+            }
+        }
+        closedir(_dir);
+    }
+
+    //----------------------------------------------------------------------------------//
+    //  adds the usage of one process to the sample. Returns false if the process no
+    //  longer exists
+    //
+    bool read(const process& _proc, sample& _sample)
+    {
+        static const int64_t _page = sysconf(_SC_PAGESIZE);
+        static const int64_t _tick = sysconf(_SC_CLK_TCK);
+
+        char _buf[1024];
+        auto _n = pread_file(_proc.stat, _buf, sizeof(_buf));
+        if(_n <= 0)
+            return false;
+
+        // the fields after the command name, which is in parentheses and may contain
+        // spaces, start with the state (field 3). Fields 14-17 are utime, stime,
+        // cutime, and cstime in clock ticks
+        const char* _beg = _buf;
+        for(const char* itr = _buf; itr < _buf + _n; ++itr)
+        {
+            if(*itr == ')')
+                _beg = itr + 1;
+        }
+
+        int64_t _field = 0;
+        int64_t _ticks = 0;
+        for(int i = 4; i <= 17; ++i)
+        {
+            if(!tim::impl::parse_integer(_beg, _buf + _n, _field))
+                break;
+            if(i >= 14)
+                _ticks += _field;
+        }
+        _sample.cpu += (_ticks * 1000000000) / _tick;
+
+        _n = pread_file(_proc.statm, _buf, sizeof(_buf));
+        if(_n > 0)
+        {
+            int64_t _size = 0;
+            int64_t _rss  = 0;
+            _beg          = _buf;
+            if(tim::impl::parse_integer(_beg, _buf + _n, _size) &&
+               tim::impl::parse_integer(_beg, _buf + _n, _rss))
+            {
+                _sample.virt += _size * _page;
+                _sample.rss += _rss * _page;
+            }
+        }
+
+        // not readable for processes of another user, e.g. setuid executables
+        _n = pread_file(_proc.io, _buf, sizeof(_buf));
+        if(_n > 0)
+        {
+            static const char   _read[]  = "read_bytes:";
+            static const char   _write[] = "write_bytes:";
+            static const size_t _nread   = sizeof(_read) - 1;
+            static const size_t _nwrite  = sizeof(_write) - 1;
+
+            const char* _end = _buf + _n;
+            int64_t     _val = 0;
+            for(_beg = _buf; _beg < _end;)
+            {
+                auto _eol = static_cast<const char*>(memchr(_beg, '\n', _end - _beg));
+                if(!_eol)
+                    _eol = _end;
+                auto _len = static_cast<size_t>(_eol - _beg);
+                if(_len > _nread && strncmp(_beg, _read, _nread) == 0)
+                {
+                    _beg += _nread;
+                    if(tim::impl::parse_integer(_beg, _eol, _val))
+                        _sample.read_bytes += _val;
+                }
+                else if(_len > _nwrite && strncmp(_beg, _write, _nwrite) == 0)
+                {
+                    _beg += _nwrite;
+                    if(tim::impl::parse_integer(_beg, _eol, _val))
+                        _sample.write_bytes += _val;
+                }
+                _beg = _eol + 1;
+            }
+        }
+
+        ++_sample.nproc;
+        return true;
+    }
+
+    static ssize_t pread_file(int _fd, char* _buf, size_t _n)
+    {
+        if(_fd < 0)
+            return -1;
+        auto _ret = ::pread(_fd, _buf, _n - 1, 0);
+        if(_ret >= 0)
+            _buf[_ret] = '\0';
+        return _ret;
+    }
+
+    //----------------------------------------------------------------------------------//
+    template <typename _Tp>
+    static double megabytes(_Tp _bytes)
+    {
+        return static_cast<double>(_bytes) / tim::units::megabyte;
+    }
+
+    static double utilization(const sample& _lhs, const sample& _rhs)
+    {
+        auto _wall = _rhs.time - _lhs.time;
+        return (_wall > 0.0) ? 100.0 * (_rhs.cpu - _lhs.cpu) * 1.0e-9 / _wall : 0.0;
+    }
+
+    void update_summary(const sample& _sample)
+    {
+        auto& _sum = m_summary;
+        ++_sum.count;
+        _sum.peak_rss   = std::max(_sum.peak_rss, _sample.rss);
+        _sum.peak_nproc = std::max(_sum.peak_nproc, _sample.nproc);
+        _sum.mean_rss += (_sample.rss - _sum.mean_rss) / _sum.count;
+        // the cpu time has the resolution of a clock tick so the final sample, which is
+        // usually taken shortly after the previous one, is excluded from the peak
+        auto _interval = std::chrono::duration<double>(m_interval).count();
+        if(!m_buffer.empty() && _sample.time - m_buffer.back().time > 0.9 * _interval)
+            _sum.peak_util =
+                std::max(_sum.peak_util, utilization(m_buffer.back(), _sample));
+        if(_sample.time > 0.0)
+            _sum.mean_util = 100.0 * _sample.cpu * 1.0e-9 / _sample.time;
+    }
+
+private:
+    pid_t                   m_root;
+    duration_type           m_interval;
+    bool                    m_running = false;
+    clock_type::time_point  m_start   = {};
+    ring_buffer             m_buffer;
+    summary                 m_summary = {};
+    std::vector<process>    m_procs   = {};
+    std::vector<pid_t>      m_pids    = {};
+    std::thread             m_thread;
+    std::mutex              m_mutex;
+    std::condition_variable m_cv;
+};
+
+#endif
+
+//--------------------------------------------------------------------------------------//
+
+}  // namespace timem
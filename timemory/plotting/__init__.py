@@ -53,6 +53,9 @@ __all__ = ['plotting',
            'plot_all',
            'plot_generic',
            'read',
+           'read_columnar',
+           'is_columnar',
+           'columnar_data',
            'plot_data',
            'timemory_data',
            'echo_dart_tag',
@@ -108,18 +108,26 @@ def try_plot():
 
         data = {}
         for i in range(len(args.files)):
-            f = open(args.files[i], "r")
-            _jdata = json.load(f)
-            _ranks = _jdata["timemory"]["ranks"]
+            if _plotting.is_columnar(args.files[i]):
+                _columnar = _plotting.columnar_data(args.files[i])
+                _ranks = _columnar.ranks()
+                _ext = '.tmb'
+            else:
+                f = open(args.files[i], "r")
+                _jdata = json.load(f)
+                _ranks = _jdata["timemory"]["ranks"]
+                _ext = '.json'
 
             nranks = len(_ranks)
             for j in range(nranks):
-                _json = _ranks[j]
-                _data = _plotting.read(_json)
+                if _ext == '.tmb':
+                    _data = _plotting.read_columnar(_columnar, _ranks[j])
+                else:
+                    _data = _plotting.read(_ranks[j])
                 _rtag = '' if nranks == 1 else '_{}'.format(j)
                 _rtitle = '' if nranks == 1 else ' (MPI rank: {})'.format(j)
 
-                _data.filename = args.files[i].replace('.json', _rtag)
+                _data.filename = args.files[i].replace(_ext, _rtag)
                 if len(args.titles) == 1:
                     _data.title = args.titles[0] + _rtitle
                 else:
@@ -44,6 +44,9 @@ __all__ = ['plot',
            'plot_all',
            'plot_generic',
            'read',
+           'read_columnar',
+           'is_columnar',
+           'columnar_data',
            'plot_data',
            'timemory_data',
            'echo_dart_tag',
@@ -58,6 +61,8 @@ import os
 import imp
 import copy
 import json
+import mmap
+import struct
 import ctypes
 import platform
 import warnings
@@ -549,6 +554,323 @@ def read(json_obj, plot_params=plot_parameters()):
                      plot_params=plot_params)
 
 
+#==============================================================================#
+def is_columnar(filename):
+    """
+    Check whether the file is in the columnar binary format (TIMEMORY_BINARY_OUTPUT)
+    """
+    try:
+        with open(filename, "rb") as f:
+            return f.read(8) == b'TIMEMORY'
+    except:
+        return False
+
+
+#==============================================================================#
+class columnar_data():
+    """
+    Memory-mapped reader for the columnar binary format (TIMEMORY_BINARY_OUTPUT).
+    The node and column arrays reference the mapped file and the strings are
+    only decoded when they are requested
+    """
+
+    version = 1
+    byte_order_mark = 0x01020304
+    header_format = '=8sII7Q'
+    column_format = '=4I'
+
+    # column kinds
+    repr = 0
+    value = 1
+    accum = 2
+
+    # ------------------------------------------------------------------------ #
+    def __init__(self, filename):
+        self.filename = filename
+        self._file = open(filename, "rb")
+        self._map = mmap.mmap(self._file.fileno(), 0, access=mmap.ACCESS_READ)
+
+        _size = struct.calcsize(columnar_data.header_format)
+        if len(self._map) < _size:
+            self.close()
+            raise ValueError("'{}' is not a columnar file".format(filename))
+
+        (magic, version, byte_order, self.nnodes, self.nstrings, self.ncolumns,
+         self.concurrency, string_offset, node_offset, column_offset) = \
+            struct.unpack_from(columnar_data.header_format, self._map, 0)
+
+        if (magic != b'TIMEMORY' or byte_order != columnar_data.byte_order_mark or
+                version > columnar_data.version):
+            self.close()
+            raise ValueError(
+                "'{}' is not a supported columnar file".format(filename))
+
+        _n = self.nnodes
+        self._offsets = self._array('Q', string_offset, self.nstrings + 1)
+        self._chars = string_offset + 8 * (self.nstrings + 1)
+        self._strings = {}
+
+        _pos = [node_offset]
+
+        def _next(_fmt, _count, _size):
+            _ret = self._array(_fmt, _pos[0], _count)
+            _pos[0] += (_count * _size + 7) & ~7
+            return _ret
+
+        self.hash = _next('Q', _n, 8)
+        self.parent = _next('q', _n, 8)
+        self.first_child = _next('q', _n, 8)
+        self.next_sibling = _next('q', _n, 8)
+        self.depth = _next('q', _n, 8)
+        self.laps = _next('q', _n, 8)
+        self._prefix = _next('I', _n, 4)
+        self.rank = _next('I', _n, 4)
+        self.flags = _next('I', _n, 4)
+
+        _csize = struct.calcsize(columnar_data.column_format)
+        self.columns = [struct.unpack_from(columnar_data.column_format, self._map,
+                                           column_offset + i * _csize)
+                        for i in range(self.ncolumns)]
+        _pos[0] = column_offset + self.ncolumns * _csize
+        self._values = [_next('d', _n, 8) for i in range(self.ncolumns)]
+
+        _error = self._validate()
+        if _error is not None:
+            self.close()
+            raise ValueError("'{}' has an invalid {}".format(filename, _error))
+
+    # ------------------------------------------------------------------------ #
+    def _validate(self):
+        """
+        Check the string table and the links of the nodes. The children and
+        siblings of a node always have a larger index, which rules out cycles.
+        Returns the name of the invalid table or None
+        """
+        _nchars = len(self._map) - self._chars
+        _prev = 0
+        for _offset in self._offsets:
+            if _offset < _prev or _offset > _nchars:
+                return 'string table'
+            _prev = _offset
+
+        _n = self.nnodes
+        for i in range(_n):
+            _parent = self.parent[i]
+            _child = self.first_child[i]
+            _sibling = self.next_sibling[i]
+            if _parent != -1 and not (0 <= _parent < _n):
+                return 'node table'
+            if _child != -1 and not (i < _child < _n):
+                return 'node table'
+            if _sibling != -1 and not (i < _sibling < _n):
+                return 'node table'
+            if self._prefix[i] >= self.nstrings:
+                return 'node table'
+
+        for _column in self.columns:
+            if _column[0] >= self.nstrings or _column[1] >= self.nstrings:
+                return 'column table'
+        return None
+
+    # ------------------------------------------------------------------------ #
+    def _array(self, _fmt, _offset, _count):
+        """
+        A view of an array in the mapped file without copying when possible
+        """
+        _size = struct.calcsize(_fmt)
+        if _offset + _count * _size > len(self._map):
+            raise ValueError("'{}' is truncated".format(self.filename))
+        try:
+            _view = memoryview(self._map)[_offset:(_offset + _count * _size)]
+            return _view.cast(_fmt)
+        except (AttributeError, TypeError):
+            return struct.unpack_from('={}{}'.format(_count, _fmt), self._map,
+                                      _offset)
+
+    # ------------------------------------------------------------------------ #
+    def close(self):
+        """
+        Release the views of the mapped file and unmap it
+        """
+        for _attr in ('hash', 'parent', 'first_child', 'next_sibling', 'depth',
+                      'laps', '_prefix', 'rank', 'flags', '_offsets'):
+            _obj = getattr(self, _attr, None)
+            if isinstance(_obj, memoryview):
+                _obj.release()
+            setattr(self, _attr, None)
+        for _obj in getattr(self, '_values', []):
+            if isinstance(_obj, memoryview):
+                _obj.release()
+        self._values = []
+        if getattr(self, '_map', None) is not None:
+            self._map.close()
+            self._map = None
+        if getattr(self, '_file', None) is not None:
+            self._file.close()
+            self._file = None
+
+    # ------------------------------------------------------------------------ #
+    def __enter__(self):
+        return self
+
+    # ------------------------------------------------------------------------ #
+    def __exit__(self, exc_type, exc_value, exc_traceback):
+        self.close()
+
+    # ------------------------------------------------------------------------ #
+    def __len__(self):
+        """
+        Get the number of nodes
+        """
+        return self.nnodes
+
+    # ------------------------------------------------------------------------ #
+    def string(self, idx):
+        """
+        Get an entry of the string table
+        """
+        if idx not in self._strings:
+            _beg = self._chars + self._offsets[idx]
+            _end = self._chars + self._offsets[idx + 1]
+            self._strings[idx] = self._map[_beg:_end].decode('utf-8')
+        return self._strings[idx]
+
+    # ------------------------------------------------------------------------ #
+    def label(self):
+        return self.string(0)
+
+    # ------------------------------------------------------------------------ #
+    def description(self):
+        return self.string(1)
+
+    # ------------------------------------------------------------------------ #
+    def unit(self):
+        return self.string(2)
+
+    # ------------------------------------------------------------------------ #
+    def prefix(self, i):
+        """
+        The label of the node without the indentation
+        """
+        return self.string(self._prefix[i])
+
+    # ------------------------------------------------------------------------ #
+    def tag(self, i):
+        """
+        The label of the node with the indentation of the text output
+        """
+        _depth = self.depth[i]
+        _indent = '' if _depth < 1 else '  ' * (_depth - 1) + '|_'
+        return '>>> {}{}'.format(_indent, self.prefix(i))
+
+    # ------------------------------------------------------------------------ #
+    def is_transient(self, i):
+        return (self.flags[i] & 0x1) != 0
+
+    # ------------------------------------------------------------------------ #
+    def children(self, i):
+        _ret = []
+        _itr = self.first_child[i]
+        while _itr >= 0:
+            _ret.append(_itr)
+            _itr = self.next_sibling[_itr]
+        return _ret
+
+    # ------------------------------------------------------------------------ #
+    def ranks(self):
+        """
+        Get the sorted list of ranks
+        """
+        return sorted(set(self.rank))
+
+    # ------------------------------------------------------------------------ #
+    def column_name(self, c):
+        return self.string(self.columns[c][0])
+
+    # ------------------------------------------------------------------------ #
+    def column_unit(self, c):
+        return self.string(self.columns[c][1])
+
+    # ------------------------------------------------------------------------ #
+    def column_kind(self, c):
+        return self.columns[c][2]
+
+    # ------------------------------------------------------------------------ #
+    def column(self, c):
+        """
+        Get the values of a column for every node
+        """
+        return self._values[c]
+
+    # ------------------------------------------------------------------------ #
+    def column_indices(self, kind):
+        return [c for c in range(self.ncolumns) if self.column_kind(c) == kind]
+
+    # ------------------------------------------------------------------------ #
+    def values(self, i, kind):
+        """
+        Get the values of a node for a column kind. A single value is returned
+        as a scalar
+        """
+        _ret = [self._values[c][i] for c in self.column_indices(kind)]
+        return _ret[0] if len(_ret) == 1 else _ret
+
+    # ------------------------------------------------------------------------ #
+    def entry(self, i):
+        """
+        The node in the same layout as the 'entry' of the JSON output
+        """
+        return {'is_transient': self.is_transient(i),
+                'laps': self.laps[i],
+                'repr_data': self.values(i, columnar_data.repr),
+                'value': self.values(i, columnar_data.value),
+                'accum': self.values(i, columnar_data.accum)}
+
+
+#==============================================================================#
+def read_columnar(obj, rank=0, plot_params=plot_parameters()):
+    """
+    Read the columnar binary data of one rank -- i.e. the equivalent of read()
+    for a file written when TIMEMORY_BINARY_OUTPUT is enabled.
+
+    Args:
+        obj (str or columnar_data): the filename or the mapped file
+        rank (int): the rank to read
+    """
+    _data = obj if isinstance(obj, columnar_data) else columnar_data(obj)
+    timemory_functions = nested_dict()
+
+    _repr = _data.column_indices(columnar_data.repr)
+    _units = [_data.column_unit(c) for c in _repr]
+    _ctype = [_data.column_name(c) for c in _repr]
+    if len(_repr) < 2:
+        _units = _data.unit()
+        _ctype = _data.label()
+
+    for i in range(len(_data)):
+        if _data.rank[i] != rank:
+            continue
+
+        tag = _data.tag(i)
+        tfunc = timemory_data(tag, _data.entry(i))
+        if tfunc.laps == 0:
+            continue
+
+        if not tag in timemory_functions:
+            timemory_functions[tag] = tfunc
+        else:
+            timemory_functions[tag] += tfunc
+
+    return plot_data(filename=_data.filename.replace('.tmb', ''),
+                     concurrency=_data.concurrency,
+                     mpi_size=len(_data.ranks()),
+                     description=_data.description(),
+                     ctype=_ctype,
+                     units=_units,
+                     timemory_functions=timemory_functions,
+                     plot_params=plot_params)
+
+
 #==============================================================================#
 def plot_generic(_plot_data, _type_min, _type_unit, idx=0):
 
@@ -809,9 +1131,12 @@ def plot(data=[], files=[], plot_params=plot_parameters(),
     if len(files) > 0:
         for filename in files:
             print('Reading {}...'.format(filename))
-            f = open(filename, "r")
-            _data = read(json.load(f))
-            f.close()
+            if is_columnar(filename):
+                _data = read_columnar(filename)
+            else:
+                f = open(filename, "r")
+                _data = read(json.load(f))
+                f.close()
             _data.filename = filename
             _data.title = filename
             data.append(_data)
@@ -0,0 +1,171 @@
+#!@PYTHON_EXECUTABLE@
+#
+# MIT License
+#
+# Copyright (c) 2018, The Regents of the University of California, 
+# through Lawrence Berkeley National Laboratory (subject to receipt of any 
+# required approvals from the U.S. Dept. of Energy).  All rights reserved.
+#
+# Permission is hereby granted, free of charge, to any person obtaining a copy
+# of this software and associated documentation files (the "Software"), to deal
+# in the Software without restriction, including without limitation the rights
+# to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+# copies of the Software, and to permit persons to whom the Software is
+# furnished to do so, subject to the following conditions:
+#
+# The above copyright notice and this permission notice shall be included in all
+# copies or substantial portions of the Software.
+#
+# THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+# IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+# FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+# AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+# LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+# OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+# SOFTWARE.
+#
+
+## @file profiler_test.py
+## A test of the native profiler: nesting, deep recursion, and the decorator and
+## context-manager of timemory.util.profile
+##
+
+import sys
+import os
+import argparse
+import traceback
+
+import timemory
+from timemory import options
+
+
+# ---------------------------------------------------------------------------- #
+def inner():
+    return 1
+
+
+# ---------------------------------------------------------------------------- #
+def outer():
+    ret = 0
+    for i in range(3):
+        ret += inner()
+    return ret
+
+
+# ---------------------------------------------------------------------------- #
+@timemory.util.profile()
+def nested():
+    for i in range(2):
+        outer()
+
+
+# ---------------------------------------------------------------------------- #
+def recurse(n):
+    return 0 if n == 0 else 1 + recurse(n - 1)
+
+
+# ---------------------------------------------------------------------------- #
+def get_records(label):
+    """
+    The (depth, laps) of every node in the storage whose prefix contains 'label'.
+    Each component records the same nodes so the duplicates are removed
+    """
+    ret = set()
+
+    def _walk(obj):
+        if isinstance(obj, dict):
+            if 'prefix' in obj and 'entry' in obj and label in obj['prefix']:
+                ret.add((obj['depth'], obj['entry']['laps']))
+            for itr in obj.values():
+                _walk(itr)
+        elif isinstance(obj, list):
+            for itr in obj:
+                _walk(itr)
+
+    _walk(timemory.get())
+    return sorted(ret)
+
+
+# ---------------------------------------------------------------------------- #
+def label(func):
+    return '{}/{}:'.format(func.__name__, os.path.basename(__file__))
+
+
+# ---------------------------------------------------------------------------- #
+def test_nesting():
+    nested()
+    assert not timemory.profiler.is_enabled()
+
+    _nested = get_records(label(nested))
+    _outer = get_records(label(outer))
+    _inner = get_records(label(inner))
+    print('nested: {}\nouter: {}\ninner: {}'.format(_nested, _outer, _inner))
+
+    assert len(_nested) == 1 and _nested[0][1] == 1
+    assert _outer == [(_nested[0][0] + 1, 2)]
+    assert _inner == [(_nested[0][0] + 2, 6)]
+
+
+# ---------------------------------------------------------------------------- #
+def test_recursion(n):
+    # deep enough for the frames to outgrow any initial reservation
+    sys.setrecursionlimit(max(sys.getrecursionlimit(), 4 * n))
+
+    with timemory.util.profile():
+        with timemory.util.profile():
+            assert timemory.profiler.is_enabled()
+            recurse(n)
+        # nested starts are counted
+        assert timemory.profiler.is_enabled()
+    assert not timemory.profiler.is_enabled()
+
+    _records = get_records(label(recurse))
+    print('recurse: {} records'.format(len(_records)))
+
+    # one node per level of the recursion, each entered and exited exactly once
+    _depths = [itr[0] for itr in _records]
+    assert len(_records) == n + 1
+    assert _depths == list(range(_depths[0], _depths[0] + n + 1))
+    assert all([itr[1] == 1 for itr in _records])
+
+
+# ---------------------------------------------------------------------------- #
+def test_excluded():
+    # the decorator and context-manager do not add nodes for their own functions
+    _records = get_records('/util.py:')
+    print('util.py: {}'.format(_records))
+    assert len(_records) == 0
+
+
+# ---------------------------------------------------------------------------- #
+def run_test():
+
+    parser = argparse.ArgumentParser()
+    parser.add_argument("-n", "--depth",
+                        help="Depth of the recursion",
+                        default=1000, type=int)
+    args = options.add_arguments_and_parse(parser)
+    timemory.settings.output_path = "test_output"
+
+    test_nesting()
+    test_recursion(args.depth)
+    test_excluded()
+
+    print('"{}" testing finished'.format(__file__))
+
+
+# ---------------------------------------------------------------------------- #
+if __name__ == "__main__":
+    try:
+        run_test()
+
+        if options.ctest_notes:
+            manager = timemory.manager()
+            f = manager.write_ctest_notes(directory="test_output/profiler_test")
+            print('"{}" wrote CTest notes file : {}'.format(__file__, f))
+
+    except Exception as e:
+        exc_type, exc_value, exc_traceback = sys.exc_info()
+        traceback.print_exception(exc_type, exc_value, exc_traceback, limit=5)
+        print ('Exception - {}'.format(e))
+        raise
@@ -42,7 +42,8 @@ __all__ = ['util',
            'base_decorator',
            'auto_timer',
            'timer',
-           'rss_usage']
+           'rss_usage',
+           'profile']
 
 from . import util
 from .util import *
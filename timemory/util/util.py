@@ -36,6 +36,11 @@ import inspect
 from enum import Enum
 from functools import wraps
 
+try:
+    from ..libpytimemory import profiler as _profiler
+except ImportError:
+    _profiler = None
+
 __author__ = "Jonathan Madsen"
 __copyright__ = "Copyright 2020, The Regents of the University of California"
 __credits__ = ["Jonathan Madsen"]
@@ -48,7 +53,8 @@ __all__ = ['base_decorator',
            'auto_timer',
            'timer',
            'rss_usage',
-           'auto_tuple']
+           'auto_tuple',
+           'profile']
 
 
 #----------------------------------------------------------------------------------------#
@@ -549,3 +555,101 @@ class auto_tuple(base_decorator):
             import traceback
             traceback.print_exception(
                 exc_type, exc_value, exc_traceback, limit=5)
+
+
+#----------------------------------------------------------------------------------------#
+#
+class profile(object):
+    """ A decorator or context-manager for the native profiler. Every python function
+        called within the scope is measured with the components of the auto-timer
+        without any per-call overhead in python, e.g.:
+
+        @timemory.util.profile()
+        def main(n=5):
+            for i in range(2):
+                fibonacci(n * (i+1))
+        # ...
+        # output :
+        # > [pyc] main/example.py:10 ...
+        # > [pyc] |_fibonacci/example.py:4 ...
+
+        If 'threads' is True, the profiler is also started on the threads created
+        via the threading module while it is active. Stopping only removes the hook
+        for new threads: a thread which was already started keeps profiling until it
+        exits or calls timemory.profiler.stop()
+
+        The functions of the decorator and context-manager are not measured
+    """
+
+    #------------------------------------------------------------------------------------#
+    #
+    def __init__(self, threads=False):
+        self.threads = threads
+
+
+    #------------------------------------------------------------------------------------#
+    #
+    def start(self):
+        import timemory
+        if self.threads:
+            import threading
+            threading.setprofile(timemory.profiler.thread_init)
+        timemory.profiler.start()
+
+
+    #------------------------------------------------------------------------------------#
+    #
+    def stop(self):
+        import timemory
+        timemory.profiler.stop()
+        if self.threads:
+            import threading
+            threading.setprofile(None)
+
+
+    #------------------------------------------------------------------------------------#
+    #
+    def __call__(self, func):
+        """
+        Decorator
+        """
+        @wraps(func)
+        def function_wrapper(*args, **kwargs):
+            self.start()
+            try:
+                return func(*args, **kwargs)
+            finally:
+                self.stop()
+
+        if _profiler is not None:
+            _profiler.exclude(function_wrapper)
+        return function_wrapper
+
+
+    #------------------------------------------------------------------------------------#
+    #
+    def __enter__(self, *args, **kwargs):
+        """
+        Context manager entrance
+        """
+        self.start()
+
+
+    #------------------------------------------------------------------------------------#
+    #
+    def __exit__(self, exc_type, exc_value, exc_traceback):
+        self.stop()
+
+        if exc_type is not None and exc_value is not None and exc_traceback is not None:
+            import traceback
+            traceback.print_exception(
+                exc_type, exc_value, exc_traceback, limit=5)
+
+
+#----------------------------------------------------------------------------------------#
+#   the functions of the profile decorator and context-manager are not measured
+#
+if _profiler is not None:
+    for _func in (profile.__init__, profile.start, profile.stop, profile.__enter__,
+                  profile.__exit__):
+        _profiler.exclude(_func)